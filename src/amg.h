@@ -0,0 +1,693 @@
+/**
+ * @file amg.h
+ * @author PANFACTORY (github/PANFACTORY)
+ * @brief Definition and implementation of smoothed aggregation algebraic
+ * multigrid
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#pragma once
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include "linearoperator.h"
+#include "lu.h"
+#include "mat.h"
+#include "parallel.h"
+#include "profiler.h"
+#include "sparsemat.h"
+#include "vec.h"
+
+namespace PANSFE {
+/**
+ * @brief Smoother of each level of AMG
+ *
+ */
+enum class AMGSmoother { Jacobi, GaussSeidel, Chebyshev };
+
+/**
+ * @brief Number of coarse corrections per level, one for V and two for W
+ *
+ */
+enum class AMGCycle { V, W };
+
+/**
+ * @brief Smoothed aggregation algebraic multigrid for symmetric positive
+ * definite sparse matrix, as a solver or as a preconditioner
+ *
+ * Aggregates are roots of a distance two maximal independent set of the
+ * strength graph, chosen in parallel rounds with hashed priorities, so the
+ * hierarchy does not depend on the number of threads. The tentative
+ * prolongator of the constant near nullspace is smoothed by one damped Jacobi
+ * step, coarse operators are Galerkin products P^T A P and the coarsest level
+ * is solved by LU. Jacobi damping uses a power iteration estimate of the
+ * spectral radius of D^-1 A, while Chebyshev takes the Gershgorin bound as its
+ * upper end so that it never amplifies. Gauss-Seidel sweeps forward before
+ * and backward after the correction so that the cycle stays symmetric, and
+ * runs serially.
+ *
+ * @tparam T Type of element
+ */
+template <class T>
+class AMG {
+   public:
+    /**
+     * @brief Construct a new AMG object and set up the hierarchy
+     *
+     * @param _a            Symmetric positive definite sparse matrix whose
+     * diagonal is stored
+     * @param _theta        Threshold of strength |a_ij| > _theta
+     * sqrt(|a_ii a_jj|)
+     * @param _coarsesize   Largest size of the coarsest level
+     * @param _maxlevels    Largest number of levels
+     */
+    explicit AMG(const SparseMat<T> &_a, T _theta = T(0.08),
+                 int _coarsesize = 64, int _maxlevels = 20)
+        : theta(_theta),
+          coarsesize(_coarsesize),
+          maxlevels(_maxlevels),
+          smoother(AMGSmoother::Jacobi),
+          sweeps(1),
+          cycle(AMGCycle::V),
+          tolerance(std::sqrt(std::numeric_limits<T>::epsilon())),
+          maxiteration(100),
+          iteration(0),
+          residual(T()),
+          converged(false) {
+        assert(_a.Row() == _a.Col() && _coarsesize > 0 && _maxlevels > 0);
+        this->Setup(_a, false);
+    }
+
+    /**
+     * @brief Recompute the hierarchy for a matrix with the same pattern,
+     * reusing the aggregates
+     *
+     * @param _a    Sparse matrix with the pattern used at construction
+     */
+    void Update(const SparseMat<T> &_a) {
+        assert(_a.RowPtr() == this->levels[0].a.RowPtr() &&
+               _a.ColInd() == this->levels[0].a.ColInd());
+        this->Setup(_a, true);
+    }
+
+    /**
+     * @brief Set smoother
+     *
+     * @param _smoother Smoother of each level
+     * @param _sweeps   Number of sweeps before and after the coarse
+     * correction, degree of polynomial for Chebyshev
+     */
+    void SetSmoother(AMGSmoother _smoother, int _sweeps = 1) {
+        assert(_sweeps > 0);
+        this->smoother = _smoother;
+        this->sweeps = _sweeps;
+    }
+
+    /**
+     * @brief Set cycle
+     *
+     * @param _cycle    V cycle or W cycle
+     */
+    void SetCycle(AMGCycle _cycle) { this->cycle = _cycle; }
+
+    /**
+     * @brief Set stopping criteria of Solve
+     *
+     * @param _tolerance    Tolerance of relative residual |r| / |b|
+     * @param _maxiteration Maximum number of cycles
+     */
+    void SetTolerance(T _tolerance, int _maxiteration) {
+        this->tolerance = _tolerance;
+        this->maxiteration = _maxiteration;
+    }
+
+    /**
+     * @brief Get number of levels
+     *
+     * @return int  Number of levels
+     */
+    int Levels() const { return int(this->levels.size()); }
+
+    /**
+     * @brief Get operator of a level
+     *
+     * @param _level                Index of level, zero is the finest
+     * @return const SparseMat<T>&  Operator of the level
+     */
+    const SparseMat<T> &LevelMatrix(int _level) const {
+        assert(0 <= _level && _level < this->Levels());
+        return this->levels[_level].a;
+    }
+
+    /**
+     * @brief Get operator complexity, nonzeros of all levels over nonzeros of
+     * the finest level
+     *
+     * @return T    Operator complexity
+     */
+    T OperatorComplexity() const {
+        T nonzeros = T();
+        for (auto &level : this->levels) {
+            nonzeros += level.a.NonZeros();
+        }
+        return nonzeros / this->levels[0].a.NonZeros();
+    }
+
+    /**
+     * @brief Get number of row
+     *
+     * @return int  Number of row
+     */
+    int Row() const { return this->levels[0].a.Row(); }
+
+    /**
+     * @brief Get number of column
+     *
+     * @return int  Number of column
+     */
+    int Col() const { return this->levels[0].a.Col(); }
+
+    /**
+     * @brief Set _y to one cycle from zero initial guess for A y = _x, which
+     * uses work vectors of this object but does not allocate
+     *
+     * @param _x    Vector sized Col()
+     * @param _y    Vector sized Row()
+     */
+    void Apply(const Vec<T> &_x, Vec<T> &_y) const {
+        PANSFE_PROFILE_SCOPE("AMG::Apply", 0, 0);
+        const Level &finest = this->levels[0];
+        assert(_x.Size() == this->Col() && _y.Size() == this->Row());
+        std::copy(_x.Values(), _x.Values() + _x.Size(), finest.b.Values());
+        std::fill(finest.x.Values(), finest.x.Values() + _x.Size(), T());
+        this->Cycle(0);
+        std::copy(finest.x.Values(), finest.x.Values() + _x.Size(),
+                  _y.Values());
+    }
+
+    /**
+     * @brief Set _y to one cycle for A^T y = _x, the same as Apply
+     *
+     * @param _x    Vector sized Row()
+     * @param _y    Vector sized Col()
+     */
+    void ApplyTranspose(const Vec<T> &_x, Vec<T> &_y) const {
+        this->Apply(_x, _y);
+    }
+
+    /**
+     * @brief Get preconditioner applying one cycle, which refers to this
+     * object
+     *
+     * @return const LinearOperator<T>  Operator applying one cycle
+     */
+    const LinearOperator<T> Operator() const {
+        auto apply = [this](const Vec<T> &_x, Vec<T> &_y) {
+            this->Apply(_x, _y);
+        };
+        return LinearOperator<T>(this->Row(), this->Col(), apply, apply);
+    }
+
+    /**
+     * @brief Solve A x = _b from zero initial guess by repeated cycles
+     *
+     * @param _b            Right hand side
+     * @return const Vec<T> Solution
+     */
+    const Vec<T> Solve(const Vec<T> &_b) {
+        Vec<T> retvec(this->Row());
+        this->Solve(_b, retvec);
+        return retvec;
+    }
+
+    /**
+     * @brief Solve A x = _b by repeated cycles
+     *
+     * @param _b    Right hand side
+     * @param _x    Initial guess on input and solution on output
+     */
+    void Solve(const Vec<T> &_b, Vec<T> &_x) {
+        PANSFE_PROFILE_SCOPE("AMG::Solve", 0, 0);
+        const SparseMat<T> &a = this->levels[0].a;
+        int n = a.Row();
+        assert(_b.Size() == n && _x.Size() == n);
+        Vec<T> r(n), e(n);
+        T bnorm = _b.Norm();
+        if (bnorm == T()) {
+            bnorm = T(1);
+        }
+        T *x = _x.Values(), *rv = r.Values();
+        const T *b = _b.Values(), *ev = e.Values();
+        this->iteration = 0;
+        while (true) {
+            a.Apply(_x, r);
+            ParallelFor(
+                0, n, [&](int _i) { rv[_i] = b[_i] - rv[_i]; }, 4096);
+            this->residual = r.Norm() / bnorm;
+            this->converged = this->residual <= this->tolerance;
+            if (this->converged || this->iteration >= this->maxiteration) {
+                return;
+            }
+            this->iteration++;
+            this->Apply(r, e);
+            ParallelFor(
+                0, n, [&](int _i) { x[_i] += ev[_i]; }, 4096);
+        }
+    }
+
+    /**
+     * @brief Get number of cycles of the last Solve
+     *
+     * @return int  Number of cycles
+     */
+    int Iteration() const { return this->iteration; }
+
+    /**
+     * @brief Get relative residual |r| / |b| of the last Solve
+     *
+     * @return T    Relative residual
+     */
+    T Residual() const { return this->residual; }
+
+    /**
+     * @brief Check whether the last Solve reached the tolerance
+     *
+     * @return true     Converged
+     * @return false    Not converged within maximum cycles
+     */
+    bool IsConverged() const { return this->converged; }
+
+   private:
+    struct Level {
+        SparseMat<T> a, p, r;
+        std::vector<int> aggregate;
+        Vec<T> invdiag;
+        T radius, bound;
+        mutable Vec<T> x, b, residual, direction, work;
+    };
+
+    T theta;
+    int coarsesize, maxlevels;
+    AMGSmoother smoother;
+    int sweeps;
+    AMGCycle cycle;
+    T tolerance;
+    int maxiteration, iteration;
+    T residual;
+    bool converged;
+    std::vector<Level> levels;
+    LU<T> coarse;
+
+    void Setup(const SparseMat<T> &_a, bool _reuse) {
+        PANSFE_PROFILE_SCOPE("AMG::Setup", 0, 0);
+        std::vector<std::vector<int> > aggregates;
+        if (_reuse) {
+            for (int l = 0; l + 1 < this->Levels(); l++) {
+                aggregates.push_back(std::move(this->levels[l].aggregate));
+            }
+        }
+        this->levels.clear();
+        SparseMat<T> a = _a;
+        for (int l = 0;; l++) {
+            Level level;
+            int n = a.Row();
+            level.invdiag = Vec<T>(n);
+            level.bound = T();
+            std::vector<T> rowradius(n);
+            const std::vector<int> &rowptr = a.RowPtr(),
+                                   &colind = a.ColInd();
+            const T *values = a.Values();
+            T *invdiag = level.invdiag.Values();
+            ParallelFor(
+                0, n,
+                [&](int _i) {
+                    T diagonal = T(), sum = T();
+                    for (int k = rowptr[_i]; k < rowptr[_i + 1]; k++) {
+                        sum += std::abs(values[k]);
+                        if (colind[k] == _i) {
+                            diagonal = values[k];
+                        }
+                    }
+                    assert(diagonal != T());
+                    invdiag[_i] = T(1) / diagonal;
+                    rowradius[_i] = sum / std::abs(diagonal);
+                },
+                1024);
+            for (int i = 0; i < n; i++) {
+                level.bound = std::max(level.bound, rowradius[i]);
+            }
+            level.radius = std::min(level.bound, SpectralRadius(a, level));
+            level.x = Vec<T>(n);
+            level.b = Vec<T>(n);
+            level.residual = Vec<T>(n);
+            level.direction = Vec<T>(n);
+            level.work = Vec<T>(n);
+
+            bool last = _reuse ? l == int(aggregates.size())
+                               : n <= this->coarsesize ||
+                                     l + 1 >= this->maxlevels;
+            int numaggregates = 0;
+            if (!last) {
+                level.aggregate =
+                    _reuse ? std::move(aggregates[l]) : this->Aggregate(a);
+                for (int g : level.aggregate) {
+                    numaggregates = std::max(numaggregates, g + 1);
+                }
+                last = !_reuse &&
+                       (numaggregates == 0 || 4 * numaggregates > 3 * n);
+            }
+            if (last) {
+                level.aggregate.clear();
+                this->coarse = LU<T>(Mat<T>(a));
+                level.a = std::move(a);
+                this->levels.push_back(std::move(level));
+                return;
+            }
+            level.p = this->Prolongator(a, level, numaggregates);
+            level.r = level.p.Transpose();
+            SparseMat<T> next = level.r * (a * level.p);
+            level.a = std::move(a);
+            this->levels.push_back(std::move(level));
+            a = std::move(next);
+        }
+    }
+
+    static T SpectralRadius(const SparseMat<T> &_a, const Level &_level) {
+        int n = _a.Row();
+        Vec<T> v(n), w(n);
+        for (int i = 0; i < n; i++) {
+            v[i] = T(1) + T(i % 7) / T(7);
+        }
+        T estimate = T();
+        for (int k = 0; k < 15; k++) {
+            T norm = v.Norm();
+            _a.Apply(v, w);
+            for (int i = 0; i < n; i++) {
+                w[i] *= _level.invdiag[i] / norm;
+            }
+            estimate = w.Norm();
+            std::swap(v, w);
+        }
+        return T(1.1) * estimate;
+    }
+
+    std::vector<int> Aggregate(const SparseMat<T> &_a) const {
+        int n = _a.Row();
+        const std::vector<int> &rowptr = _a.RowPtr(), &colind = _a.ColInd();
+        const T *values = _a.Values();
+        std::vector<T> diagonal(n, T());
+        ParallelFor(
+            0, n,
+            [&](int _i) {
+                for (int k = rowptr[_i]; k < rowptr[_i + 1]; k++) {
+                    if (colind[k] == _i) {
+                        diagonal[_i] = std::abs(values[k]);
+                    }
+                }
+            },
+            1024);
+        std::vector<int> strongptr(n + 1, 0);
+        auto strong = [&](int _i, int _k) {
+            int j = colind[_k];
+            return j != _i && std::abs(values[_k]) >
+                                  this->theta *
+                                      std::sqrt(diagonal[_i] * diagonal[j]);
+        };
+        ParallelFor(
+            0, n,
+            [&](int _i) {
+                for (int k = rowptr[_i]; k < rowptr[_i + 1]; k++) {
+                    strongptr[_i + 1] += strong(_i, k);
+                }
+            },
+            1024);
+        for (int i = 0; i < n; i++) {
+            strongptr[i + 1] += strongptr[i];
+        }
+        std::vector<int> strongadj(strongptr[n]);
+        ParallelFor(
+            0, n,
+            [&](int _i) {
+                int p = strongptr[_i];
+                for (int k = rowptr[_i]; k < rowptr[_i + 1]; k++) {
+                    if (strong(_i, k)) {
+                        strongadj[p++] = colind[k];
+                    }
+                }
+            },
+            1024);
+
+        enum { Undecided, Root, Excluded, Isolated };
+        std::vector<unsigned long long> priority(n), first(n), second(n);
+        std::vector<char> state(n), near(n);
+        ParallelFor(
+            0, n,
+            [&](int _i) {
+                unsigned long long h = (unsigned long long)_i + 1;
+                h *= 0x9E3779B97F4A7C15ULL;
+                h ^= h >> 29;
+                priority[_i] = ((h & 0xFFFFFFFFULL) << 32) |
+                               (unsigned long long)(_i + 1);
+                state[_i] =
+                    strongptr[_i] == strongptr[_i + 1] ? Isolated : Undecided;
+            },
+            4096);
+        auto neighbormax = [&](const std::vector<unsigned long long> &_from,
+                               std::vector<unsigned long long> &_to) {
+            ParallelFor(
+                0, n,
+                [&](int _i) {
+                    unsigned long long m = _from[_i];
+                    for (int k = strongptr[_i]; k < strongptr[_i + 1]; k++) {
+                        m = std::max(m, _from[strongadj[k]]);
+                    }
+                    _to[_i] = m;
+                },
+                1024);
+        };
+        while (std::find(state.begin(), state.end(), char(Undecided)) !=
+               state.end()) {
+            ParallelFor(
+                0, n,
+                [&](int _i) {
+                    second[_i] = state[_i] == Undecided ? priority[_i] : 0;
+                },
+                4096);
+            neighbormax(second, first);
+            neighbormax(first, second);
+            ParallelFor(
+                0, n,
+                [&](int _i) {
+                    if (state[_i] == Undecided && second[_i] == priority[_i]) {
+                        state[_i] = Root;
+                    }
+                },
+                4096);
+            ParallelFor(
+                0, n,
+                [&](int _i) {
+                    bool found = state[_i] == Root;
+                    for (int k = strongptr[_i]; k < strongptr[_i + 1]; k++) {
+                        found = found || state[strongadj[k]] == Root;
+                    }
+                    near[_i] = found;
+                },
+                1024);
+            ParallelFor(
+                0, n,
+                [&](int _i) {
+                    if (state[_i] != Undecided) {
+                        return;
+                    }
+                    bool found = near[_i];
+                    for (int k = strongptr[_i]; k < strongptr[_i + 1]; k++) {
+                        found = found || near[strongadj[k]];
+                    }
+                    if (found) {
+                        state[_i] = Excluded;
+                    }
+                },
+                1024);
+        }
+
+        std::vector<int> aggregate(n, -1);
+        int numaggregates = 0;
+        for (int i = 0; i < n; i++) {
+            if (state[i] == Root) {
+                aggregate[i] = numaggregates++;
+            }
+        }
+        for (int pass = 0; pass < 2; pass++) {
+            std::vector<int> previous = aggregate;
+            ParallelFor(
+                0, n,
+                [&](int _i) {
+                    if (state[_i] != Excluded || previous[_i] >= 0) {
+                        return;
+                    }
+                    unsigned long long best = 0;
+                    for (int k = strongptr[_i]; k < strongptr[_i + 1]; k++) {
+                        int j = strongadj[k];
+                        if (previous[j] >= 0 && priority[j] > best &&
+                            (pass == 1 || state[j] == Root)) {
+                            best = priority[j];
+                            aggregate[_i] = previous[j];
+                        }
+                    }
+                },
+                1024);
+        }
+        for (int i = 0; i < n; i++) {
+            if (state[i] == Excluded && aggregate[i] < 0) {
+                aggregate[i] = numaggregates++;
+            }
+        }
+        return aggregate;
+    }
+
+    SparseMat<T> Prolongator(const SparseMat<T> &_a, const Level &_level,
+                             int _numaggregates) const {
+        int n = _a.Row();
+        const std::vector<int> &aggregate = _level.aggregate;
+        std::vector<int> count(_numaggregates, 0);
+        for (int i = 0; i < n; i++) {
+            if (aggregate[i] >= 0) {
+                count[aggregate[i]]++;
+            }
+        }
+        std::vector<int> rowptr(n + 1, 0), colind;
+        std::vector<T> values;
+        for (int i = 0; i < n; i++) {
+            if (aggregate[i] >= 0) {
+                colind.push_back(aggregate[i]);
+                values.push_back(T(1) / std::sqrt(T(count[aggregate[i]])));
+            }
+            rowptr[i + 1] = int(colind.size());
+        }
+        SparseMat<T> tentative(n, _numaggregates, rowptr, colind, values);
+        SparseMat<T> retmat = _a * tentative;
+        T omega = T(4) / (T(3) * _level.radius);
+        const std::vector<int> &retrowptr = retmat.RowPtr(),
+                               &retcolind = retmat.ColInd();
+        T *retvalues = retmat.Values();
+        ParallelFor(
+            0, n,
+            [&](int _i) {
+                T scale = -omega * _level.invdiag[_i];
+                for (int k = retrowptr[_i]; k < retrowptr[_i + 1]; k++) {
+                    retvalues[k] *= scale;
+                }
+                if (aggregate[_i] >= 0) {
+                    const int *head = retcolind.data() + retrowptr[_i],
+                              *tail = retcolind.data() + retrowptr[_i + 1];
+                    const int *found =
+                        std::lower_bound(head, tail, aggregate[_i]);
+                    assert(found != tail && *found == aggregate[_i]);
+                    retvalues[found - retcolind.data()] += values[rowptr[_i]];
+                }
+            },
+            1024);
+        return retmat;
+    }
+
+    void Cycle(int _l) const {
+        const Level &level = this->levels[_l];
+        int n = level.a.Row();
+        if (_l + 1 == this->Levels()) {
+            level.x = level.b;
+            this->coarse.SolveInPlace(level.x);
+            return;
+        }
+        this->Smooth(level, true);
+        T *residual = level.residual.Values();
+        const T *b = level.b.Values(), *work = level.work.Values();
+        level.a.Apply(level.x, level.work);
+        ParallelFor(
+            0, n, [&](int _i) { residual[_i] = b[_i] - work[_i]; }, 4096);
+        const Level &next = this->levels[_l + 1];
+        level.r.Apply(level.residual, next.b);
+        std::fill(next.x.Values(), next.x.Values() + next.x.Size(), T());
+        this->Cycle(_l + 1);
+        if (this->cycle == AMGCycle::W && _l + 2 < this->Levels()) {
+            this->Cycle(_l + 1);
+        }
+        level.p.Apply(next.x, level.work);
+        T *x = level.x.Values();
+        ParallelFor(
+            0, n, [&](int _i) { x[_i] += work[_i]; }, 4096);
+        this->Smooth(level, false);
+    }
+
+    void Smooth(const Level &_level, bool _pre) const {
+        int n = _level.a.Row();
+        const std::vector<int> &rowptr = _level.a.RowPtr(),
+                               &colind = _level.a.ColInd();
+        const T *values = _level.a.Values(), *b = _level.b.Values(),
+                *invdiag = _level.invdiag.Values();
+        T *x = _level.x.Values(), *residual = _level.residual.Values(),
+          *direction = _level.direction.Values(), *work = _level.work.Values();
+        if (this->smoother == AMGSmoother::GaussSeidel) {
+            for (int s = 0; s < this->sweeps; s++) {
+                for (int t = 0; t < n; t++) {
+                    int i = _pre ? t : n - 1 - t;
+                    T sum = b[i];
+                    for (int k = rowptr[i]; k < rowptr[i + 1]; k++) {
+                        if (colind[k] != i) {
+                            sum -= values[k] * x[colind[k]];
+                        }
+                    }
+                    x[i] = sum * invdiag[i];
+                }
+            }
+        } else if (this->smoother == AMGSmoother::Jacobi) {
+            T omega = T(4) / (T(3) * _level.radius);
+            for (int s = 0; s < this->sweeps; s++) {
+                _level.a.Apply(_level.x, _level.work);
+                ParallelFor(
+                    0, n,
+                    [&](int _i) {
+                        x[_i] += omega * invdiag[_i] * (b[_i] - work[_i]);
+                    },
+                    4096);
+            }
+        } else {
+            T upper = _level.bound, lower = _level.radius / T(30);
+            T center = (upper + lower) / T(2), half = (upper - lower) / T(2);
+            T sigma = center / half, rho = T(1) / sigma;
+            _level.a.Apply(_level.x, _level.work);
+            ParallelFor(
+                0, n,
+                [&](int _i) {
+                    residual[_i] = invdiag[_i] * (b[_i] - work[_i]);
+                    direction[_i] = residual[_i] / center;
+                },
+                4096);
+            for (int s = 0;; s++) {
+                ParallelFor(
+                    0, n, [&](int _i) { x[_i] += direction[_i]; }, 4096);
+                if (s + 1 == this->sweeps) {
+                    break;
+                }
+                _level.a.Apply(_level.direction, _level.work);
+                T rhonext = T(1) / (T(2) * sigma - rho);
+                ParallelFor(
+                    0, n,
+                    [&](int _i) {
+                        residual[_i] -= invdiag[_i] * work[_i];
+                        direction[_i] = rhonext * rho * direction[_i] +
+                                        T(2) * rhonext / half * residual[_i];
+                    },
+                    4096);
+                rho = rhonext;
+            }
+        }
+    }
+};
+}  // namespace PANSFE
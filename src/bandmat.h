@@ -0,0 +1,444 @@
+/**
+ * @file bandmat.h
+ * @author PANFACTORY (github/PANFACTORY)
+ * @brief Definition and implementation of banded matrix class and
+ * tridiagonal solvers
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#pragma once
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <vector>
+
+#include "mat.h"
+#include "parallel.h"
+#include "profiler.h"
+#include "vec.h"
+
+namespace PANSFE {
+/**
+ * @brief Square banded matrix class with LAPACK style band storage
+ *
+ * Element (i, j) with -kl <= j - i <= ku is stored at row (kl + ku + i - j)
+ * of column j in a column-major (2 kl + ku + 1) x n array. The extra kl rows
+ * on top hold the fill created by row interchanges of the band LU.
+ *
+ * @tparam T Type of element
+ */
+template <class T>
+class BandMat {
+   public:
+    /**
+     * @brief Construct a new BandMat object whose size is zero
+     *
+     */
+    BandMat() : size(0), kl(0), ku(0), factorized(false) {}
+
+    /**
+     * @brief Construct a new BandMat object whose elements in band are _value
+     *
+     * @param _size     Number of row and column
+     * @param _kl       Number of subdiagonals
+     * @param _ku       Number of superdiagonals
+     * @param _value    Each element value in band
+     */
+    BandMat(Index _size, Index _kl, Index _ku, T _value = T())
+        : size(_size),
+          kl(_kl),
+          ku(_ku),
+          values((2 * _kl + _ku + 1) * _size, T()),
+          factorized(false) {
+        assert(0 <= _size && 0 <= _kl && 0 <= _ku);
+        for (Index j = 0; j < this->size; j++) {
+            for (Index i = std::max<Index>(0, j - this->ku);
+                 i <= std::min(this->size - 1, j + this->kl); i++) {
+                this->At(i, j) = _value;
+            }
+        }
+    }
+
+    /**
+     * @brief Construct a new BandMat object from band of dense matrix
+     *
+     * @param _mat  Square matrix
+     * @param _kl   Number of subdiagonals
+     * @param _ku   Number of superdiagonals
+     */
+    BandMat(const Mat<T> &_mat, Index _kl, Index _ku)
+        : BandMat(_mat.Row(), _kl, _ku) {
+        assert(_mat.Row() == _mat.Col());
+        for (Index j = 0; j < this->size; j++) {
+            for (Index i = std::max<Index>(0, j - this->ku);
+                 i <= std::min(this->size - 1, j + this->kl); i++) {
+                this->At(i, j) = _mat[i][j];
+            }
+        }
+    }
+
+    /**
+     * @brief Get number of row and column
+     *
+     * @return Index    Number of row and column
+     */
+    Index Size() const { return this->size; }
+
+    /**
+     * @brief Get number of subdiagonals
+     *
+     * @return Index    Number of subdiagonals
+     */
+    Index Lower() const { return this->kl; }
+
+    /**
+     * @brief Get number of superdiagonals
+     *
+     * @return Index    Number of superdiagonals
+     */
+    Index Upper() const { return this->ku; }
+
+    /**
+     * @brief Get (_i, _j) element in band with validation
+     *
+     * @param _i    Index of row
+     * @param _j    Index of column
+     * @return T&   Reference of (_i, _j) element value
+     */
+    T &operator()(Index _i, Index _j) {
+        assert(0 <= _i && _i < this->size && 0 <= _j && _j < this->size);
+        assert(-this->kl <= _j - _i && _j - _i <= this->ku);
+        assert(!this->factorized);
+        return this->At(_i, _j);
+    }
+
+    /**
+     * @brief Get (_i, _j) element, zero outside band
+     *
+     * @param _i    Index of row
+     * @param _j    Index of column
+     * @return T    (_i, _j) element value
+     */
+    T operator()(Index _i, Index _j) const {
+        assert(0 <= _i && _i < this->size && 0 <= _j && _j < this->size);
+        if (_j - _i < -this->kl || this->ku < _j - _i) {
+            return T();
+        }
+        return this->At(_i, _j);
+    }
+
+    /**
+     * @brief Get band storage
+     *
+     * @return T*   Pointer of column-major (2 kl + ku + 1) x n band storage
+     */
+    T *Values() { return this->values.data(); }
+
+    /**
+     * @brief Get matrix vector product
+     *
+     * @param _vec          Vector used matrix vector product
+     * @return const Vec<T> Vector from matrix vector product
+     */
+    const Vec<T> operator*(const Vec<T> &_vec) const {
+        PANSFE_PROFILE_SCOPE(
+            "BandMat::operator*",
+            2.0 * this->size * (this->kl + this->ku + 1),
+            sizeof(T) * double(this->size) * (this->kl + this->ku + 3));
+        assert(_vec.Size() == this->size && !this->factorized);
+        Vec<T> retvec(this->size);
+        const T *x = _vec.Values();
+        T *y = retvec.Values();
+        ParallelFor(
+            0, this->size,
+            [&](Index _i) {
+                T sum = T();
+                Index head = std::max<Index>(0, _i - this->kl),
+                    tail = std::min(this->size - 1, _i + this->ku);
+                for (Index j = head; j <= tail; j++) {
+                    sum += this->At(_i, j) * x[j];
+                }
+                y[_i] = sum;
+            },
+            4096);
+        return retvec;
+    }
+
+    /**
+     * @brief Convert to Mat
+     *
+     * @return Mat<T>   Dense matrix
+     */
+    operator Mat<T>() const {
+        assert(!this->factorized);
+        Mat<T> retmat(this->size, this->size);
+        for (Index j = 0; j < this->size; j++) {
+            for (Index i = std::max<Index>(0, j - this->ku);
+                 i <= std::min(this->size - 1, j + this->kl); i++) {
+                retmat[i][j] = this->At(i, j);
+            }
+        }
+        return retmat;
+    }
+
+    /**
+     * @brief Factorize in place by band LU with partial pivoting, O(n kl
+     * (kl + ku)) operations
+     *
+     * After factorization only Solve may be used. A singular matrix is left
+     * unchanged and not marked as factorized.
+     *
+     * @return true     Succeeded
+     * @return false    Matrix is singular
+     */
+    bool Factorize() {
+        PANSFE_PROFILE_SCOPE(
+            "BandMat::Factorize",
+            2.0 * this->size * this->kl * (this->kl + this->ku + 1), 0);
+        assert(!this->factorized);
+        std::vector<T> original = this->values;
+        this->pivot.resize(this->size);
+        Index kv = this->kl + this->ku;
+        for (Index k = 0; k < this->size; k++) {
+            Index last = std::min(this->size - 1, k + this->kl);
+            Index p = k;
+            for (Index i = k + 1; i <= last; i++) {
+                if (std::abs(this->At(i, k)) > std::abs(this->At(p, k))) {
+                    p = i;
+                }
+            }
+            this->pivot[k] = p;
+            if (this->At(p, k) == T()) {
+                this->values.swap(original);
+                this->pivot.clear();
+                return false;
+            }
+            Index right = std::min(this->size - 1, k + kv);
+            if (p != k) {
+                for (Index j = k; j <= right; j++) {
+                    std::swap(this->At(k, j), this->At(p, j));
+                }
+            }
+            T inv = T(1) / this->At(k, k);
+            for (Index i = k + 1; i <= last; i++) {
+                this->At(i, k) *= inv;
+            }
+            for (Index j = k + 1; j <= right; j++) {
+                T ukj = this->At(k, j);
+                if (ukj != T()) {
+                    for (Index i = k + 1; i <= last; i++) {
+                        this->At(i, j) -= this->At(i, k) * ukj;
+                    }
+                }
+            }
+        }
+        this->factorized = true;
+        return true;
+    }
+
+    /**
+     * @brief Solve A x = _b with factorized band LU, O(n (2 kl + ku))
+     * operations
+     *
+     * @param _b            Right hand side
+     * @return const Vec<T> Solution
+     */
+    const Vec<T> Solve(const Vec<T> &_b) const {
+        PANSFE_PROFILE_SCOPE("BandMat::Solve",
+                             2.0 * this->size * (2 * this->kl + this->ku + 1),
+                             0);
+        assert(this->factorized && _b.Size() == this->size);
+        Vec<T> retvec = _b;
+        T *x = retvec.Values();
+        Index kv = this->kl + this->ku;
+        for (Index k = 0; k < this->size; k++) {
+            std::swap(x[k], x[this->pivot[k]]);
+            for (Index i = k + 1; i <= std::min(this->size - 1, k + this->kl);
+                 i++) {
+                x[i] -= this->At(i, k) * x[k];
+            }
+        }
+        for (Index k = this->size - 1; k >= 0; k--) {
+            x[k] /= this->At(k, k);
+            for (Index i = std::max<Index>(0, k - kv); i < k; i++) {
+                x[i] -= this->At(i, k) * x[k];
+            }
+        }
+        return retvec;
+    }
+
+   private:
+    Index size, kl, ku;
+    std::vector<T> values;
+    std::vector<Index> pivot;
+    bool factorized;
+
+    T &At(Index _i, Index _j) {
+        return this->values[(2 * this->kl + this->ku + 1) * _j +
+                            (this->kl + this->ku + _i - _j)];
+    }
+
+    const T &At(Index _i, Index _j) const {
+        return this->values[(2 * this->kl + this->ku + 1) * _j +
+                            (this->kl + this->ku + _i - _j)];
+    }
+};
+
+/**
+ * @brief Solve tridiagonal system by Thomas algorithm, O(n) operations
+ *
+ * Row i reads _a[i] x[i-1] + _b[i] x[i] + _c[i] x[i+1] = _d[i]; _a[0] and
+ * _c[n-1] are ignored. No pivoting, so the matrix should be diagonally
+ * dominant or symmetric positive definite.
+ *
+ * @tparam T            Type of element
+ * @param _a            Subdiagonal
+ * @param _b            Diagonal
+ * @param _c            Superdiagonal
+ * @param _d            Right hand side
+ * @return const Vec<T> Solution
+ */
+template <class T>
+inline const Vec<T> SolveTridiagonal(const Vec<T> &_a, const Vec<T> &_b,
+                                     const Vec<T> &_c, const Vec<T> &_d) {
+    PANSFE_PROFILE_SCOPE("SolveTridiagonal", 8.0 * _b.Size(),
+                         sizeof(T) * 6.0 * _b.Size());
+    Index n = _b.Size();
+    assert(_a.Size() == n && _c.Size() == n && _d.Size() == n);
+    Vec<T> cp(n), retvec(n);
+    if (n == 0) {
+        return retvec;
+    }
+    cp[0] = _c[0] / _b[0];
+    retvec[0] = _d[0] / _b[0];
+    for (Index i = 1; i < n; i++) {
+        T inv = T(1) / (_b[i] - _a[i] * cp[i - 1]);
+        cp[i] = _c[i] * inv;
+        retvec[i] = (_d[i] - _a[i] * retvec[i - 1]) * inv;
+    }
+    for (Index i = n - 2; i >= 0; i--) {
+        retvec[i] -= cp[i] * retvec[i + 1];
+    }
+    return retvec;
+}
+
+/**
+ * @brief Solve tridiagonal system by cyclic reduction, O(n) operations in
+ * log2(n) levels whose rows are eliminated in parallel
+ *
+ * Same convention as SolveTridiagonal.
+ *
+ * @tparam T            Type of element
+ * @param _a            Subdiagonal
+ * @param _b            Diagonal
+ * @param _c            Superdiagonal
+ * @param _d            Right hand side
+ * @return const Vec<T> Solution
+ */
+template <class T>
+inline const Vec<T> SolveTridiagonalCyclicReduction(const Vec<T> &_a,
+                                                    const Vec<T> &_b,
+                                                    const Vec<T> &_c,
+                                                    const Vec<T> &_d) {
+    PANSFE_PROFILE_SCOPE("SolveTridiagonalCyclicReduction", 17.0 * _b.Size(),
+                         sizeof(T) * 10.0 * _b.Size());
+    Index n = _b.Size();
+    assert(_a.Size() == n && _c.Size() == n && _d.Size() == n);
+    Vec<T> sub = _a, diagonal = _b, super = _c, rhs = _d, retvec(n);
+    if (n == 0) {
+        return retvec;
+    }
+    T *a = sub.Values(), *b = diagonal.Values(), *c = super.Values(),
+      *d = rhs.Values(), *x = retvec.Values();
+    a[0] = T();
+    c[n - 1] = T();
+    const int grain = 2048;
+
+    Index stride = 1;
+    for (; 2 * stride <= n; stride *= 2) {
+        Index first = 2 * stride - 1, count = (n - first + 2 * stride - 1) /
+                                            (2 * stride);
+        ParallelFor(
+            0, count,
+            [&](Index _k) {
+                Index i = first + 2 * stride * _k;
+                Index l = i - stride, r = i + stride;
+                T alpha = -a[i] / b[l];
+                T beta = r < n ? -c[i] / b[r] : T();
+                b[i] += alpha * c[l] + (r < n ? beta * a[r] : T());
+                d[i] += alpha * d[l] + (r < n ? beta * d[r] : T());
+                a[i] = alpha * a[l];
+                c[i] = r < n ? beta * c[r] : T();
+            },
+            grain);
+    }
+    for (; stride >= 1; stride /= 2) {
+        Index first = stride - 1, count = (n - first + 2 * stride - 1) /
+                                        (2 * stride);
+        ParallelFor(
+            0, count,
+            [&](Index _k) {
+                Index i = first + 2 * stride * _k;
+                Index l = i - stride, r = i + stride;
+                T sum = d[i];
+                if (l >= 0) {
+                    sum -= a[i] * x[l];
+                }
+                if (r < n) {
+                    sum -= c[i] * x[r];
+                }
+                x[i] = sum / b[i];
+            },
+            grain);
+    }
+    return retvec;
+}
+
+/**
+ * @brief Solve many independent tridiagonal systems of the same size by
+ * Thomas algorithm, lines in parallel
+ *
+ * Line l occupies elements [l n, (l + 1) n) of every argument.
+ *
+ * @tparam T            Type of element
+ * @param _lines        Number of lines
+ * @param _a            Subdiagonals
+ * @param _b            Diagonals
+ * @param _c            Superdiagonals
+ * @param _d            Right hand sides, overwritten by solutions
+ */
+template <class T>
+inline void SolveTridiagonalBatched(Index _lines, const Vec<T> &_a,
+                                    const Vec<T> &_b, const Vec<T> &_c,
+                                    Vec<T> &_d) {
+    PANSFE_PROFILE_SCOPE("SolveTridiagonalBatched", 8.0 * _b.Size(),
+                         sizeof(T) * 6.0 * _b.Size());
+    assert(0 < _lines && _b.Size() % _lines == 0);
+    assert(_a.Size() == _b.Size() && _c.Size() == _b.Size() &&
+           _d.Size() == _b.Size());
+    Index n = _b.Size() / _lines;
+    if (n == 0) {
+        return;
+    }
+    T *values = _d.Values();
+    ParallelFor(0, _lines, [&](Index _l) {
+        std::vector<T> cp(n);
+        const T *a = &_a[n * _l], *b = &_b[n * _l], *c = &_c[n * _l];
+        T *d = values + n * _l;
+        cp[0] = c[0] / b[0];
+        d[0] = d[0] / b[0];
+        for (Index i = 1; i < n; i++) {
+            T inv = T(1) / (b[i] - a[i] * cp[i - 1]);
+            cp[i] = c[i] * inv;
+            d[i] = (d[i] - a[i] * d[i - 1]) * inv;
+        }
+        for (Index i = n - 2; i >= 0; i--) {
+            d[i] -= cp[i] * d[i + 1];
+        }
+    });
+}
+}  // namespace PANSFE
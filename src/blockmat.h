@@ -0,0 +1,480 @@
+/**
+ * @file blockmat.h
+ * @author PANFACTORY (github/PANFACTORY)
+ * @brief Definition and implementation of dense block matrix class
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#pragma once
+#include <algorithm>
+#include <cassert>
+#include <initializer_list>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "mat.h"
+#include "parallel.h"
+#include "profiler.h"
+#include "vec.h"
+
+namespace PANSFE {
+/**
+ * @brief Kind of block in BlockMat
+ *
+ */
+enum class BlockKind { Zero, Identity, Dense };
+
+/**
+ * @brief Block of BlockMat, a dense Mat, a Vec as one column, or a zero or
+ * scaled identity block whose size may be left to its block row and column
+ *
+ * A dense block refers to its source without copying, so the source must
+ * outlive every BlockMat made of it and must not be mutated meanwhile. A
+ * temporary source is kept alive by the block instead, sharing its buffer
+ * when possible.
+ *
+ * @tparam T Type of element
+ */
+template <class T>
+class MatBlock {
+    template <class U>
+    friend class BlockMat;
+
+   public:
+    /**
+     * @brief Construct a new zero block sized by its block row and column
+     *
+     */
+    MatBlock()
+        : kind(BlockKind::Zero),
+          row(-1),
+          col(-1),
+          scale(T()),
+          values(nullptr),
+          stride(0) {}
+
+    /**
+     * @brief Construct a new dense block referring to _mat
+     *
+     * @param _mat  Matrix outliving the block
+     */
+    MatBlock(const Mat<T> &_mat)
+        : kind(BlockKind::Dense),
+          row(_mat.Row()),
+          col(_mat.Col()),
+          scale(T(1)),
+          values(_mat.Values()),
+          stride(_mat.Col()) {}
+
+    /**
+     * @brief Construct a new dense block keeping temporary _mat, whose
+     * buffer is shared instead of copied
+     *
+     * @param _mat  Temporary matrix
+     */
+    MatBlock(Mat<T> &&_mat) : MatBlock(Keep(_mat)) {}
+
+    /**
+     * @brief Construct a new dense block keeping a copy of temporary _mat
+     *
+     * @param _mat  Temporary matrix
+     */
+    MatBlock(const Mat<T> &&_mat)
+        : MatBlock(std::make_shared<const Mat<T> >(_mat)) {}
+
+    /**
+     * @brief Construct a new dense block of one column referring to _vec
+     *
+     * @param _vec  Vector outliving the block
+     */
+    MatBlock(const Vec<T> &_vec)
+        : kind(BlockKind::Dense),
+          row(_vec.Size()),
+          col(1),
+          scale(T(1)),
+          values(_vec.Values()),
+          stride(1) {}
+
+    /**
+     * @brief Construct a new dense block of one column keeping temporary
+     * _vec, whose heap buffer is shared instead of copied
+     *
+     * @param _vec  Temporary vector
+     */
+    MatBlock(Vec<T> &&_vec) : MatBlock(Keep(_vec)) {}
+
+    /**
+     * @brief Construct a new dense block of one column keeping a copy of
+     * temporary _vec
+     *
+     * @param _vec  Temporary vector
+     */
+    MatBlock(const Vec<T> &&_vec)
+        : MatBlock(std::make_shared<const Vec<T> >(_vec)) {}
+
+    /**
+     * @brief Get zero block
+     *
+     * @param _row              Row of block, -1 to take it from block row
+     * @param _col              Column of block, -1 to take it from block
+     * column
+     * @return MatBlock<T>      Zero block
+     */
+    static MatBlock<T> Zero(Index _row = -1, Index _col = -1) {
+        MatBlock<T> retblock;
+        retblock.row = _row;
+        retblock.col = _col;
+        return retblock;
+    }
+
+    /**
+     * @brief Get scaled identity block
+     *
+     * @param _size             Size of block, -1 to take it from block row or
+     * column
+     * @param _scale            Diagonal value
+     * @return MatBlock<T>      Scaled identity block
+     */
+    static MatBlock<T> Identity(Index _size = -1, T _scale = T(1)) {
+        MatBlock<T> retblock;
+        retblock.kind = BlockKind::Identity;
+        retblock.row = _size;
+        retblock.col = _size;
+        retblock.scale = _scale;
+        return retblock;
+    }
+
+   private:
+    BlockKind kind;
+    Index row, col;
+    T scale;
+    const T *values;
+    Index stride;
+    std::shared_ptr<const void> owner;
+
+    template <class S>
+    explicit MatBlock(std::shared_ptr<const S> _source) : MatBlock(*_source) {
+        this->owner = std::move(_source);
+    }
+
+    template <class S>
+    static std::shared_ptr<const S> Keep(S &_source) {
+        _source.SetCopyOnWrite(true);
+        return std::make_shared<const S>(_source);
+    }
+
+    const T *Row(Index _r) const { return this->values + this->stride * _r; }
+};
+
+/**
+ * @brief Dense matrix given as a grid of blocks
+ *
+ * Block sizes are inferred from the grid, and the blocks are referred to
+ * rather than copied so that the object serves as a lazy operator through
+ * Apply and ApplyTranspose. The conversion to Mat fills the result with one
+ * allocation, row by row in parallel, instead of copying once per chained
+ * Hstack or Vstack.
+ *
+ * @tparam T Type of element
+ */
+template <class T>
+class BlockMat {
+   public:
+    /**
+     * @brief Construct a new BlockMat object without blocks
+     *
+     */
+    BlockMat() : rowoffset(1, 0), coloffset(1, 0) {}
+
+    /**
+     * @brief Construct a new BlockMat object
+     *
+     * @param _blocks   Format like {{A, B}, {B^T, MatBlock<T>()}}, every block
+     * row and block column needs a block of known size
+     */
+    BlockMat(
+        const std::initializer_list<std::initializer_list<MatBlock<T> > >
+            &_blocks) {
+        int blockrow = int(_blocks.size());
+        int blockcol = blockrow > 0 ? int(_blocks.begin()->size()) : 0;
+        for (auto &blocksi : _blocks) {
+            assert(int(blocksi.size()) == blockcol);
+            this->blocks.insert(this->blocks.end(), blocksi.begin(),
+                                blocksi.end());
+        }
+        std::vector<Index> height(blockrow, -1), width(blockcol, -1);
+        for (int i = 0; i < blockrow; i++) {
+            for (int j = 0; j < blockcol; j++) {
+                const MatBlock<T> &block = this->blocks[blockcol * i + j];
+                if (block.row >= 0) {
+                    assert(height[i] < 0 || height[i] == block.row);
+                    height[i] = block.row;
+                }
+                if (block.col >= 0) {
+                    assert(width[j] < 0 || width[j] == block.col);
+                    width[j] = block.col;
+                }
+            }
+        }
+        for (int i = 0; i < blockrow; i++) {
+            for (int j = 0; j < blockcol; j++) {
+                if (this->blocks[blockcol * i + j].kind ==
+                    BlockKind::Identity) {
+                    height[i] = height[i] < 0 ? width[j] : height[i];
+                    width[j] = width[j] < 0 ? height[i] : width[j];
+                }
+            }
+        }
+        this->rowoffset.assign(blockrow + 1, 0);
+        this->coloffset.assign(blockcol + 1, 0);
+        for (int i = 0; i < blockrow; i++) {
+            assert(height[i] >= 0);
+            this->rowoffset[i + 1] = this->rowoffset[i] + height[i];
+        }
+        for (int j = 0; j < blockcol; j++) {
+            assert(width[j] >= 0);
+            this->coloffset[j + 1] = this->coloffset[j] + width[j];
+        }
+        for (int i = 0; i < blockrow; i++) {
+            for (int j = 0; j < blockcol; j++) {
+                MatBlock<T> &block = this->blocks[blockcol * i + j];
+                block.row = height[i];
+                block.col = width[j];
+                assert(block.kind != BlockKind::Identity ||
+                       block.row == block.col);
+            }
+        }
+    }
+
+    /**
+     * @brief Get number of row
+     *
+     * @return Index    Number of row
+     */
+    Index Row() const { return this->rowoffset.back(); }
+
+    /**
+     * @brief Get number of column
+     *
+     * @return Index    Number of column
+     */
+    Index Col() const { return this->coloffset.back(); }
+
+    /**
+     * @brief Get number of block row
+     *
+     * @return int  Number of block row
+     */
+    int BlockRow() const { return int(this->rowoffset.size()) - 1; }
+
+    /**
+     * @brief Get number of block column
+     *
+     * @return int  Number of block column
+     */
+    int BlockCol() const { return int(this->coloffset.size()) - 1; }
+
+    /**
+     * @brief Get first row of each block row
+     *
+     * @return const std::vector<Index>&    First row of each block row and
+     * the total row at the end
+     */
+    const std::vector<Index> &RowOffset() const { return this->rowoffset; }
+
+    /**
+     * @brief Get first column of each block column
+     *
+     * @return const std::vector<Index>&    First column of each block column
+     * and the total column at the end
+     */
+    const std::vector<Index> &ColOffset() const { return this->coloffset; }
+
+    /**
+     * @brief Set _y = A _x without allocation, rows in parallel
+     *
+     * @param _x    Vector used matrix vector product
+     * @param _y    Vector from matrix vector product, sized Row()
+     */
+    void Apply(const Vec<T> &_x, Vec<T> &_y) const {
+        PANSFE_PROFILE_SCOPE("BlockMat::Apply", 2 * this->DenseSize(),
+                             sizeof(T) * (this->DenseSize() + this->Row() +
+                                          this->Col()));
+        assert(_x.Size() == this->Col() && _y.Size() == this->Row());
+        const T *x = _x.Values();
+        T *y = _y.Values();
+        int blockcol = this->BlockCol();
+        ParallelFor(
+            0, this->Row(),
+            [&](Index _r) {
+                int i = this->BlockRowOf(_r);
+                Index r = _r - this->rowoffset[i];
+                T sum = T();
+                for (int j = 0; j < blockcol; j++) {
+                    const MatBlock<T> &block = this->blocks[blockcol * i + j];
+                    const T *xj = x + this->coloffset[j];
+                    if (block.kind == BlockKind::Dense) {
+                        const T *ar = block.Row(r);
+                        for (Index c = 0; c < block.col; c++) {
+                            sum += ar[c] * xj[c];
+                        }
+                    } else if (block.kind == BlockKind::Identity) {
+                        sum += block.scale * xj[r];
+                    }
+                }
+                y[_r] = sum;
+            },
+            64);
+    }
+
+    /**
+     * @brief Set _y = A^T _x without allocation, block columns in parallel
+     * so that every row of a block is read contiguously
+     *
+     * @param _x    Vector used matrix vector product, sized Row()
+     * @param _y    Vector from matrix vector product, sized Col()
+     */
+    void ApplyTranspose(const Vec<T> &_x, Vec<T> &_y) const {
+        PANSFE_PROFILE_SCOPE("BlockMat::ApplyTranspose", 2 * this->DenseSize(),
+                             sizeof(T) * (this->DenseSize() + this->Row() +
+                                          this->Col()));
+        assert(_x.Size() == this->Row() && _y.Size() == this->Col());
+        const T *x = _x.Values();
+        T *y = _y.Values();
+        int blockrow = this->BlockRow(), blockcol = this->BlockCol();
+        ParallelFor(0, blockcol, [&](Index _j) {
+            T *yj = y + this->coloffset[_j];
+            Index width = this->coloffset[_j + 1] - this->coloffset[_j];
+            std::fill(yj, yj + width, T());
+            for (int i = 0; i < blockrow; i++) {
+                const MatBlock<T> &block = this->blocks[blockcol * i + _j];
+                const T *xi = x + this->rowoffset[i];
+                if (block.kind == BlockKind::Dense) {
+                    for (Index r = 0; r < block.row; r++) {
+                        const T *ar = block.Row(r);
+                        for (Index c = 0; c < width; c++) {
+                            yj[c] += ar[c] * xi[r];
+                        }
+                    }
+                } else if (block.kind == BlockKind::Identity) {
+                    for (Index c = 0; c < width; c++) {
+                        yj[c] += block.scale * xi[c];
+                    }
+                }
+            }
+        });
+    }
+
+    /**
+     * @brief Get matrix vector product
+     *
+     * @param _vec          Vector used matrix vector product
+     * @return const Vec<T> Vector from matrix vector product
+     */
+    const Vec<T> operator*(const Vec<T> &_vec) const {
+        Vec<T> retvec(this->Row(), Uninitialized());
+        this->Apply(_vec, retvec);
+        return retvec;
+    }
+
+    /**
+     * @brief Get diagonal elements
+     *
+     * @return const Vec<T> Vector of (i, i) elements
+     */
+    const Vec<T> Diagonal() const {
+        Index n = std::min(this->Row(), this->Col());
+        Vec<T> retvec(n, Uninitialized());
+        T *diagonal = retvec.Values();
+        int blockcol = this->BlockCol();
+        ParallelFor(
+            0, n,
+            [&](Index _k) {
+                int i = this->BlockRowOf(_k), j = this->BlockColOf(_k);
+                const MatBlock<T> &block = this->blocks[blockcol * i + j];
+                Index r = _k - this->rowoffset[i], c = _k - this->coloffset[j];
+                if (block.kind == BlockKind::Dense) {
+                    diagonal[_k] = block.Row(r)[c];
+                } else if (block.kind == BlockKind::Identity && r == c) {
+                    diagonal[_k] = block.scale;
+                } else {
+                    diagonal[_k] = T();
+                }
+            },
+            4096);
+        return retvec;
+    }
+
+    /**
+     * @brief Convert to Mat with one allocation, rows in parallel
+     *
+     * @return Mat<T>   Dense matrix
+     */
+    operator Mat<T>() const {
+        PANSFE_PROFILE_SCOPE("BlockMat::operator Mat", 0,
+                             2 * sizeof(T) * double(this->Row()) * this->Col());
+        Mat<T> retmat(this->Row(), this->Col(), Uninitialized());
+        T *values = retmat.Values();
+        Index col = this->Col();
+        int blockcol = this->BlockCol();
+        ParallelFor(
+            0, this->Row(),
+            [&](Index _r) {
+                int i = this->BlockRowOf(_r);
+                Index r = _r - this->rowoffset[i];
+                for (int j = 0; j < blockcol; j++) {
+                    const MatBlock<T> &block = this->blocks[blockcol * i + j];
+                    T *destination = values + col * _r + this->coloffset[j];
+                    if (block.kind == BlockKind::Dense) {
+                        const T *source = block.Row(r);
+                        for (Index c = 0; c < block.col; c++) {
+                            destination[c] = source[c];
+                        }
+                    } else {
+                        for (Index c = 0; c < block.col; c++) {
+                            destination[c] = T();
+                        }
+                        if (block.kind == BlockKind::Identity) {
+                            destination[r] = block.scale;
+                        }
+                    }
+                }
+            },
+            16);
+        return retmat;
+    }
+
+   private:
+    std::vector<MatBlock<T> > blocks;
+    std::vector<Index> rowoffset, coloffset;
+
+    double DenseSize() const {
+        double size = 0.0;
+        for (const MatBlock<T> &block : this->blocks) {
+            if (block.kind == BlockKind::Dense) {
+                size += double(block.row) * block.col;
+            }
+        }
+        return size;
+    }
+
+    int BlockRowOf(Index _r) const {
+        return int(std::upper_bound(this->rowoffset.begin(),
+                                    this->rowoffset.end(), _r) -
+                   this->rowoffset.begin()) -
+               1;
+    }
+
+    int BlockColOf(Index _c) const {
+        return int(std::upper_bound(this->coloffset.begin(),
+                                    this->coloffset.end(), _c) -
+                   this->coloffset.begin()) -
+               1;
+    }
+};
+}  // namespace PANSFE
@@ -0,0 +1,376 @@
+/**
+ * @file blocksparsemat.h
+ * @author PANFACTORY (github/PANFACTORY)
+ * @brief Definition and implementation of block compressed sparse row matrix
+ * class
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#pragma once
+#include <algorithm>
+#include <cassert>
+#include <utility>
+#include <vector>
+
+#include "fixedmat.h"
+#include "mat.h"
+#include "parallel.h"
+#include "profiler.h"
+#include "sparsemat.h"
+#include "vec.h"
+
+namespace PANSFE {
+/**
+ * @brief Sparse matrix class in block compressed sparse row (BSR) format
+ *
+ * Nonzeros are dense B x B blocks stored row-major one after another, and one
+ * column index is kept per block instead of per element.
+ *
+ * @tparam T Type of element
+ * @tparam B Size of block
+ */
+template <class T, int B>
+class BlockSparseMat {
+   public:
+    /**
+     * @brief Construct a new BlockSparseMat object whose row and column are
+     * zero
+     *
+     */
+    BlockSparseMat() : blockrow(0), blockcol(0), rowptr(1, 0) {}
+
+    /**
+     * @brief Construct a new BlockSparseMat object with zero blocks on a
+     * given pattern
+     *
+     * @param _blockrow Number of block row
+     * @param _blockcol Number of block column
+     * @param _rowptr   Offset of each block row, size _blockrow + 1
+     * @param _colind   Sorted block column index of each block in a row
+     */
+    BlockSparseMat(int _blockrow, int _blockcol, std::vector<int> _rowptr,
+                   std::vector<int> _colind)
+        : blockrow(_blockrow),
+          blockcol(_blockcol),
+          rowptr(std::move(_rowptr)),
+          colind(std::move(_colind)),
+          values((long long)B * B * this->colind.size(), T()) {
+        assert(int(this->rowptr.size()) == this->blockrow + 1 &&
+               int(this->colind.size()) == this->rowptr[this->blockrow]);
+    }
+
+    /**
+     * @brief Construct a new BlockSparseMat object with zero blocks coupling
+     * every pair of nodes sharing an element
+     *
+     * @param _nodes    Number of nodes, the matrix has _nodes x _nodes blocks
+     * @param _elements Node indices of each element
+     */
+    BlockSparseMat(int _nodes, const std::vector<std::vector<int> > &_elements)
+        : blockrow(_nodes), blockcol(_nodes), rowptr(_nodes + 1, 0) {
+        std::vector<std::vector<int> > adjacency(_nodes);
+        for (auto &element : _elements) {
+            for (int i : element) {
+                assert(0 <= i && i < _nodes);
+                adjacency[i].insert(adjacency[i].end(), element.begin(),
+                                    element.end());
+            }
+        }
+        for (int i = 0; i < _nodes; i++) {
+            std::sort(adjacency[i].begin(), adjacency[i].end());
+            adjacency[i].erase(
+                std::unique(adjacency[i].begin(), adjacency[i].end()),
+                adjacency[i].end());
+            this->colind.insert(this->colind.end(), adjacency[i].begin(),
+                                adjacency[i].end());
+            this->rowptr[i + 1] = int(this->colind.size());
+        }
+        this->values.assign((long long)B * B * this->colind.size(), T());
+    }
+
+    /**
+     * @brief Construct a new BlockSparseMat object from scalar CSR matrix,
+     * every block containing a stored element is kept
+     *
+     * @param _mat  Scalar CSR matrix whose row and column are multiples of B
+     */
+    explicit BlockSparseMat(const SparseMat<T> &_mat)
+        : blockrow(_mat.Row() / B),
+          blockcol(_mat.Col() / B),
+          rowptr(_mat.Row() / B + 1, 0) {
+        assert(_mat.Row() % B == 0 && _mat.Col() % B == 0);
+        const std::vector<int> &rowptr = _mat.RowPtr(), &colind = _mat.ColInd();
+        std::vector<int> columns;
+        for (int ib = 0; ib < this->blockrow; ib++) {
+            columns.clear();
+            for (int k = rowptr[B * ib]; k < rowptr[B * (ib + 1)]; k++) {
+                columns.push_back(colind[k] / B);
+            }
+            std::sort(columns.begin(), columns.end());
+            columns.erase(std::unique(columns.begin(), columns.end()),
+                          columns.end());
+            this->colind.insert(this->colind.end(), columns.begin(),
+                                columns.end());
+            this->rowptr[ib + 1] = int(this->colind.size());
+        }
+        this->values.assign((long long)B * B * this->colind.size(), T());
+        for (int i = 0; i < _mat.Row(); i++) {
+            for (int k = rowptr[i]; k < rowptr[i + 1]; k++) {
+                T *block = this->Block(i / B, colind[k] / B);
+                block[B * (i % B) + colind[k] % B] = _mat.Values()[k];
+            }
+        }
+    }
+
+    /**
+     * @brief Get number of scalar row
+     *
+     * @return int  Number of scalar row
+     */
+    int Row() const { return B * this->blockrow; }
+
+    /**
+     * @brief Get number of scalar column
+     *
+     * @return int  Number of scalar column
+     */
+    int Col() const { return B * this->blockcol; }
+
+    /**
+     * @brief Get number of stored blocks
+     *
+     * @return int  Number of stored blocks
+     */
+    int NonZeroBlocks() const { return this->rowptr[this->blockrow]; }
+
+    /**
+     * @brief Get offset of each block row
+     *
+     * @return const std::vector<int>&  Offset of each block row
+     */
+    const std::vector<int> &RowPtr() const { return this->rowptr; }
+
+    /**
+     * @brief Get block column index of each block
+     *
+     * @return const std::vector<int>&  Block column index of each block
+     */
+    const std::vector<int> &ColInd() const { return this->colind; }
+
+    /**
+     * @brief Get pointer indicating values of blocks
+     *
+     * @return T*   Pointer indicating values
+     */
+    T *Values() { return this->values.data(); }
+
+    /**
+     * @brief Get pointer indicating values of blocks
+     *
+     * @return const T* Pointer indicating values
+     */
+    const T *Values() const { return this->values.data(); }
+
+    /**
+     * @brief Get (_ib, _jb) block, nullptr if not stored
+     *
+     * @param _ib   Index of block row
+     * @param _jb   Index of block column
+     * @return T*   Pointer of row-major B x B block
+     */
+    T *Block(int _ib, int _jb) {
+        return const_cast<T *>(
+            static_cast<const BlockSparseMat<T, B> &>(*this).Block(_ib, _jb));
+    }
+
+    /**
+     * @brief Get (_ib, _jb) block, nullptr if not stored
+     *
+     * @param _ib       Index of block row
+     * @param _jb       Index of block column
+     * @return const T* Pointer of row-major B x B block
+     */
+    const T *Block(int _ib, int _jb) const {
+        assert(0 <= _ib && _ib < this->blockrow && 0 <= _jb &&
+               _jb < this->blockcol);
+        const int *head = this->colind.data() + this->rowptr[_ib],
+                  *tail = this->colind.data() + this->rowptr[_ib + 1];
+        const int *found = std::lower_bound(head, tail, _jb);
+        if (found == tail || *found != _jb) {
+            return nullptr;
+        }
+        return &this->values[(long long)B * B * (found - this->colind.data())];
+    }
+
+    /**
+     * @brief Add fixed size block to stored block (_ib, _jb)
+     *
+     * @param _ib       Index of block row
+     * @param _jb       Index of block column
+     * @param _block    Block to add
+     */
+    void AddBlock(int _ib, int _jb, const FixedMat<T, B, B> &_block) {
+        T *block = this->Block(_ib, _jb);
+        assert(block != nullptr);
+        for (int k = 0; k < B * B; k++) {
+            block[k] += _block.Values()[k];
+        }
+    }
+
+    /**
+     * @brief Assemble element matrix, block (a, b) of _element is added to
+     * block (_nodes[a], _nodes[b])
+     *
+     * @param _nodes    Node indices of the element
+     * @param _element  Element matrix of size (B * _nodes.size())^2
+     */
+    void Assemble(const std::vector<int> &_nodes, const Mat<T> &_element) {
+        int k = int(_nodes.size());
+        assert(_element.Row() == B * k && _element.Col() == B * k);
+        for (int a = 0; a < k; a++) {
+            for (int b = 0; b < k; b++) {
+                T *block = this->Block(_nodes[a], _nodes[b]);
+                assert(block != nullptr);
+                for (int r = 0; r < B; r++) {
+                    const T *source = _element[B * a + r] + B * b;
+                    for (int c = 0; c < B; c++) {
+                        block[B * r + c] += source[c];
+                    }
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Get block sparse matrix vector product, block rows in parallel
+     * with a fixed size B x B micro kernel
+     *
+     * @param _vec          Vector used matrix vector product
+     * @return const Vec<T> Vector from matrix vector product
+     */
+    const Vec<T> operator*(const Vec<T> &_vec) const {
+        Vec<T> retvec(this->Row());
+        this->Apply(_vec, retvec);
+        return retvec;
+    }
+
+    /**
+     * @brief Set _y = A _x without allocation, block rows in parallel
+     *
+     * @param _x    Vector used matrix vector product
+     * @param _y    Vector from matrix vector product, sized Row()
+     */
+    void Apply(const Vec<T> &_x, Vec<T> &_y) const {
+        PANSFE_PROFILE_SCOPE(
+            "BlockSparseMat::Apply", 2.0 * B * B * this->NonZeroBlocks(),
+            (sizeof(T) * B * B + sizeof(int)) * double(this->NonZeroBlocks()) +
+                sizeof(T) * double(this->Row() + this->Col()));
+        assert(_x.Size() == this->Col() && _y.Size() == this->Row());
+        const T *x = _x.Values();
+        T *y = _y.Values();
+        ParallelFor(
+            0, this->blockrow,
+            [&](int _ib) {
+                T sum[B] = {};
+                for (int k = this->rowptr[_ib]; k < this->rowptr[_ib + 1];
+                     k++) {
+                    const T *block = &this->values[(long long)B * B * k];
+                    const T *xj = x + B * this->colind[k];
+                    for (int r = 0; r < B; r++) {
+                        for (int c = 0; c < B; c++) {
+                            sum[r] += block[B * r + c] * xj[c];
+                        }
+                    }
+                }
+                for (int r = 0; r < B; r++) {
+                    y[B * _ib + r] = sum[r];
+                }
+            },
+            256);
+    }
+
+    /**
+     * @brief Set _y = A^T _x without allocation by scattering each block row
+     *
+     * @param _x    Vector used matrix vector product, sized Row()
+     * @param _y    Vector from matrix vector product, sized Col()
+     */
+    void ApplyTranspose(const Vec<T> &_x, Vec<T> &_y) const {
+        PANSFE_PROFILE_SCOPE(
+            "BlockSparseMat::ApplyTranspose",
+            2.0 * B * B * this->NonZeroBlocks(),
+            (sizeof(T) * B * B + sizeof(int)) * double(this->NonZeroBlocks()) +
+                sizeof(T) * double(this->Row() + this->Col()));
+        assert(_x.Size() == this->Row() && _y.Size() == this->Col());
+        const T *x = _x.Values();
+        T *y = _y.Values();
+        std::fill(y, y + this->Col(), T());
+        for (int ib = 0; ib < this->blockrow; ib++) {
+            const T *xi = x + B * ib;
+            for (int k = this->rowptr[ib]; k < this->rowptr[ib + 1]; k++) {
+                const T *block = &this->values[(long long)B * B * k];
+                T *yj = y + B * this->colind[k];
+                for (int r = 0; r < B; r++) {
+                    for (int c = 0; c < B; c++) {
+                        yj[c] += block[B * r + c] * xi[r];
+                    }
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Get diagonal elements, zero where not stored
+     *
+     * @return const Vec<T> Vector of (i, i) elements
+     */
+    const Vec<T> Diagonal() const {
+        int nb = std::min(this->blockrow, this->blockcol);
+        Vec<T> retvec(B * nb);
+        for (int ib = 0; ib < nb; ib++) {
+            const T *block = this->Block(ib, ib);
+            for (int r = 0; block != nullptr && r < B; r++) {
+                retvec[B * ib + r] = block[B * r + r];
+            }
+        }
+        return retvec;
+    }
+
+    /**
+     * @brief Convert to scalar CSR matrix, every element of stored blocks is
+     * kept
+     *
+     * @return SparseMat<T>  Scalar CSR matrix
+     */
+    operator SparseMat<T>() const {
+        std::vector<int> rowptr(this->Row() + 1, 0),
+            colind((long long)B * B * this->NonZeroBlocks());
+        std::vector<T> values(colind.size());
+        int p = 0;
+        for (int ib = 0; ib < this->blockrow; ib++) {
+            for (int r = 0; r < B; r++) {
+                for (int k = this->rowptr[ib]; k < this->rowptr[ib + 1]; k++) {
+                    for (int c = 0; c < B; c++) {
+                        colind[p] = B * this->colind[k] + c;
+                        values[p] = this->values[(long long)B * B * k + B * r +
+                                                 c];
+                        p++;
+                    }
+                }
+                rowptr[B * ib + r + 1] = p;
+            }
+        }
+        return SparseMat<T>(this->Row(), this->Col(), std::move(rowptr),
+                            std::move(colind), std::move(values));
+    }
+
+   private:
+    int blockrow, blockcol;
+    std::vector<int> rowptr, colind;
+    std::vector<T> values;
+};
+}  // namespace PANSFE
@@ -0,0 +1,281 @@
+/**
+ * @file cholesky.h
+ * @author PANFACTORY (github/PANFACTORY)
+ * @brief Definition and implementation of Cholesky factorization
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#pragma once
+#include <cassert>
+#include <cmath>
+
+#include "mat.h"
+#include "profiler.h"
+#include "symmat.h"
+#include "vec.h"
+
+namespace PANSFE {
+template <class T>
+class SymMat;
+
+/**
+ * @brief Cholesky factorization A = L L^T of symmetric positive definite
+ * matrix, L is kept in packed storage
+ *
+ * @tparam T Type of element
+ */
+template <class T>
+class Cholesky {
+   public:
+    /**
+     * @brief Construct a new Cholesky object of empty matrix
+     *
+     */
+    Cholesky() : definite(true) {}
+
+    /**
+     * @brief Factorize _mat
+     *
+     * @param _mat  Symmetric positive definite matrix
+     */
+    explicit Cholesky(const SymMat<T> &_mat) : l(_mat), definite(true) {
+        this->Factorize();
+    }
+
+    /**
+     * @brief Factorize lower triangle of _mat
+     *
+     * @param _mat  Symmetric positive definite matrix
+     */
+    explicit Cholesky(const Mat<T> &_mat) : l(_mat), definite(true) {
+        this->Factorize();
+    }
+
+    /**
+     * @brief Get size of factorized matrix
+     *
+     * @return Index    Size of factorized matrix
+     */
+    Index Size() const { return this->l.Size(); }
+
+    /**
+     * @brief Check positive definiteness found during factorization
+     *
+     * @return true     Factorized matrix is positive definite
+     * @return false    Factorized matrix is not positive definite
+     */
+    bool IsPositiveDefinite() const { return this->definite; }
+
+    /**
+     * @brief Get factor L as dense lower triangular matrix
+     *
+     * @return const Mat<T> Factor L, zero above the diagonal
+     */
+    const Mat<T> Factor() const {
+        Index n = this->Size();
+        Mat<T> retmat(n, n);
+        const T *a = this->l.Values();
+        T *values = retmat.Values();
+        for (Index i = 0; i < n; i++) {
+            const T *rowi = &a[SymMat<T>::Position(i, 0)];
+            for (Index j = 0; j <= i; j++) {
+                values[n * i + j] = rowi[j];
+            }
+        }
+        return retmat;
+    }
+
+    /**
+     * @brief Solve A x = _b in place
+     *
+     * @param _x    Right hand side on input and solution on output
+     */
+    void SolveInPlace(Vec<T> &_x) const {
+        PANSFE_PROFILE_SCOPE(
+            "Cholesky::Solve", 2.0 * this->Size() * this->Size(),
+            sizeof(T) * double(this->Size()) * this->Size());
+        assert(_x.Size() == this->Size());
+        Index n = this->Size();
+        const T *a = this->l.Values();
+        T *x = _x.Values();
+        for (Index i = 0; i < n; i++) {
+            const T *rowi = &a[SymMat<T>::Position(i, 0)];
+            T sum = x[i];
+            for (Index j = 0; j < i; j++) {
+                sum -= rowi[j] * x[j];
+            }
+            x[i] = sum / rowi[i];
+        }
+        for (Index i = n - 1; i >= 0; i--) {
+            const T *rowi = &a[SymMat<T>::Position(i, 0)];
+            x[i] /= rowi[i];
+            T xi = x[i];
+            for (Index j = 0; j < i; j++) {
+                x[j] -= rowi[j] * xi;
+            }
+        }
+    }
+
+    /**
+     * @brief Solve A x = _b
+     *
+     * @param _b            Right hand side
+     * @return const Vec<T> Solution
+     */
+    const Vec<T> Solve(const Vec<T> &_b) const {
+        Vec<T> retvec = _b;
+        this->SolveInPlace(retvec);
+        return retvec;
+    }
+
+    /**
+     * @brief Update factor to that of A + _x _x^T in O(n^2)
+     *
+     * @param _x    Vector of rank one update
+     */
+    void Update(const Vec<T> &_x) { this->RankOne(_x, T(1)); }
+
+    /**
+     * @brief Downdate factor to that of A - _x _x^T in O(n^2)
+     *
+     * @param _x        Vector of rank one downdate
+     * @return true     Downdated matrix is positive definite
+     * @return false    Downdated matrix is not positive definite and the
+     * factor is no longer valid
+     */
+    bool Downdate(const Vec<T> &_x) { return this->RankOne(_x, T(-1)); }
+
+    /**
+     * @brief Update factor to that of A + _x _x^T in O(n^2 k)
+     *
+     * @param _x    n x k matrix of rank k update
+     */
+    void Update(const Mat<T> &_x) {
+        assert(_x.Row() == this->Size());
+        for (Index j = 0; j < _x.Col(); j++) {
+            this->RankOne(Column(_x, j), T(1));
+        }
+    }
+
+    /**
+     * @brief Downdate factor to that of A - _x _x^T in O(n^2 k)
+     *
+     * @param _x        n x k matrix of rank k downdate
+     * @return true     Downdated matrix is positive definite
+     * @return false    Downdated matrix is not positive definite and the
+     * factor is no longer valid
+     */
+    bool Downdate(const Mat<T> &_x) {
+        assert(_x.Row() == this->Size());
+        for (Index j = 0; j < _x.Col(); j++) {
+            if (!this->RankOne(Column(_x, j), T(-1))) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief Get determinant of factorized matrix
+     *
+     * @return T    Determinant
+     */
+    T Determinant() const {
+        T retvalue = T(1);
+        for (Index i = 0; i < this->Size(); i++) {
+            retvalue *= this->l(i, i) * this->l(i, i);
+        }
+        return retvalue;
+    }
+
+    /**
+     * @brief Get inverse of factorized matrix
+     *
+     * @return const Mat<T> Inverse matrix
+     */
+    const Mat<T> Inverse() const {
+        Index n = this->Size();
+        Mat<T> retmat(n, n);
+        Vec<T> e(n);
+        for (Index j = 0; j < n; j++) {
+            for (Index i = 0; i < n; i++) {
+                e[i] = i == j ? T(1) : T();
+            }
+            this->SolveInPlace(e);
+            for (Index i = 0; i < n; i++) {
+                retmat[i][j] = e[i];
+            }
+        }
+        return retmat;
+    }
+
+   private:
+    SymMat<T> l;
+    bool definite;
+
+    static Vec<T> Column(const Mat<T> &_x, Index _j) {
+        Vec<T> retvec(_x.Row());
+        for (Index i = 0; i < _x.Row(); i++) {
+            retvec[i] = _x[i][_j];
+        }
+        return retvec;
+    }
+
+    bool RankOne(Vec<T> _x, T _sign) {
+        PANSFE_PROFILE_SCOPE("Cholesky::RankOne",
+                             4.0 * this->Size() * this->Size(),
+                             sizeof(T) * double(this->Size()) * this->Size());
+        assert(_x.Size() == this->Size() && this->definite);
+        Index n = this->Size();
+        T *a = this->l.Values();
+        T *x = _x.Values();
+        for (Index k = 0; k < n; k++) {
+            T lkk = a[SymMat<T>::Position(k, k)];
+            T rr = lkk * lkk + _sign * x[k] * x[k];
+            if (!(rr > T())) {
+                this->definite = false;
+                return false;
+            }
+            T r = std::sqrt(rr), c = r / lkk, s = x[k] / lkk;
+            a[SymMat<T>::Position(k, k)] = r;
+            for (Index i = k + 1; i < n; i++) {
+                T &lik = a[SymMat<T>::Position(i, k)];
+                lik = (lik + _sign * s * x[i]) / c;
+                x[i] = c * x[i] - s * lik;
+            }
+        }
+        return true;
+    }
+
+    void Factorize() {
+        PANSFE_PROFILE_SCOPE(
+            "Cholesky::Factorize", double(this->Size()) * this->Size() *
+                                       this->Size() / 3.0,
+            sizeof(T) * double(this->Size()) * this->Size() / 2);
+        Index n = this->Size();
+        T *a = this->l.Values();
+        for (Index i = 0; i < n; i++) {
+            T *rowi = &a[SymMat<T>::Position(i, 0)];
+            for (Index j = 0; j <= i; j++) {
+                const T *rowj = &a[SymMat<T>::Position(j, 0)];
+                T sum = rowi[j];
+                for (Index k = 0; k < j; k++) {
+                    sum -= rowi[k] * rowj[k];
+                }
+                if (j < i) {
+                    rowi[j] = sum / rowj[j];
+                } else if (sum > T()) {
+                    rowi[i] = std::sqrt(sum);
+                } else {
+                    this->definite = false;
+                    return;
+                }
+            }
+        }
+    }
+};
+}  // namespace PANSFE
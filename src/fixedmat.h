@@ -0,0 +1,778 @@
+/**
+ * @file fixedmat.h
+ * @author PANFACTORY (github/PANFACTORY)
+ * @brief Definition and implementation of constexpr fixed size vector and
+ * matrix classes
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2022
+ *
+ * Every operation except conversion to Vec/Mat is constexpr, so tables such
+ * as shape functions and quadrature rules can be computed at compile time.
+ */
+
+#pragma once
+#include <cassert>
+#include <initializer_list>
+#include <type_traits>
+
+#include "mat.h"
+#include "vec.h"
+
+namespace PANSFE {
+/**
+ * @brief Fixed size linear algebraic vector class
+ *
+ * @tparam T    Type of element
+ * @tparam N    Size
+ */
+template <class T, int N>
+class FixedVec {
+   public:
+    /**
+     * @brief Construct a new FixedVec object whose each element is _value
+     *
+     * @param _value    Each element value
+     */
+    constexpr explicit FixedVec(T _value = T()) : values{} {
+        for (int i = 0; i < N; i++) {
+            this->values[i] = _value;
+        }
+    }
+
+    /**
+     * @brief Construct a new FixedVec object
+     *
+     * @param _values   Format like {1, 2, 3}
+     */
+    constexpr FixedVec(const std::initializer_list<T> &_values) : values{} {
+        assert(_values.size() == N);
+        for (int i = 0; i < N; i++) {
+            this->values[i] = *(_values.begin() + i);
+        }
+    }
+
+    /**
+     * @brief Construct a new FixedVec object from Vec
+     *
+     * @param _vec  Source vector whose size is N
+     */
+    explicit FixedVec(const Vec<T> &_vec) : values{} {
+        assert(_vec.Size() == N);
+        for (int i = 0; i < N; i++) {
+            this->values[i] = _vec[i];
+        }
+    }
+
+    /**
+     * @brief Get number of element
+     *
+     * @return int  Number of element
+     */
+    constexpr int Size() const { return N; }
+
+    /**
+     * @brief Get _i th element value without validation
+     *
+     * @param _i    Index of element
+     * @return T&   Reference of _i th element
+     */
+    constexpr T &operator[](int _i) { return this->values[_i]; }
+
+    /**
+     * @brief Get _i th element value without validation
+     *
+     * @param _i        Index of element
+     * @return const T& Reference of _i th element
+     */
+    constexpr const T &operator[](int _i) const { return this->values[_i]; }
+
+    /**
+     * @brief Get _i th element value with validation
+     *
+     * @param _i    Index of element
+     * @return T&   Reference of _i th element
+     */
+    constexpr T &operator()(int _i) {
+        assert(0 <= _i && _i < N);
+        return this->values[_i];
+    }
+
+    /**
+     * @brief Get _i th element value with validation
+     *
+     * @param _i        Index of element
+     * @return const T& Reference of _i th element
+     */
+    constexpr const T &operator()(int _i) const {
+        assert(0 <= _i && _i < N);
+        return this->values[_i];
+    }
+
+    /**
+     * @brief Get pointer indicating value
+     *
+     * @return T*   Pointer indicating value
+     */
+    constexpr T *Values() { return this->values; }
+
+    /**
+     * @brief Get pointer indicating value
+     *
+     * @return const T* Pointer indicating value
+     */
+    constexpr const T *Values() const { return this->values; }
+
+    /**
+     * @brief Check the same
+     *
+     * @param _vec      Comparison
+     * @return true     Same with _vec
+     * @return false    Not the same
+     */
+    constexpr bool operator==(const FixedVec<T, N> &_vec) const {
+        for (int i = 0; i < N; i++) {
+            if (this->values[i] != _vec.values[i]) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief Check not the same
+     *
+     * @param _vec      Comparison
+     * @return true     Not the same
+     * @return false    Same with _vec
+     */
+    constexpr bool operator!=(const FixedVec<T, N> &_vec) const {
+        return !(*this == _vec);
+    }
+
+    /**
+     * @brief Compound assignment operator for addition
+     *
+     * @param _vec              Assignor object
+     * @return FixedVec<T, N>&  Reference of this object
+     */
+    constexpr FixedVec<T, N> &operator+=(const FixedVec<T, N> &_vec) {
+        for (int i = 0; i < N; i++) {
+            this->values[i] += _vec.values[i];
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Compound assignment operator for subtraction
+     *
+     * @param _vec              Assignor object
+     * @return FixedVec<T, N>&  Reference of this object
+     */
+    constexpr FixedVec<T, N> &operator-=(const FixedVec<T, N> &_vec) {
+        for (int i = 0; i < N; i++) {
+            this->values[i] -= _vec.values[i];
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Compound assignment operator for multiplication
+     *
+     * @param _a                Coefficient of multiplication
+     * @return FixedVec<T, N>&  Reference of this object
+     */
+    constexpr FixedVec<T, N> &operator*=(T _a) {
+        for (int i = 0; i < N; i++) {
+            this->values[i] *= _a;
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Compound assignment operator for division
+     *
+     * @param _a                Coefficient of division
+     * @return FixedVec<T, N>&  Reference of this object
+     */
+    constexpr FixedVec<T, N> &operator/=(T _a) {
+        for (int i = 0; i < N; i++) {
+            this->values[i] /= _a;
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Addition operator
+     *
+     * @param _vec                  Adding vector
+     * @return const FixedVec<T, N> Added vector
+     */
+    constexpr const FixedVec<T, N> operator+(
+        const FixedVec<T, N> &_vec) const {
+        FixedVec<T, N> retvec = *this;
+        retvec += _vec;
+        return retvec;
+    }
+
+    /**
+     * @brief Subtraction operator
+     *
+     * @param _vec                  Subtracting vector
+     * @return const FixedVec<T, N> Subtracted vector
+     */
+    constexpr const FixedVec<T, N> operator-(
+        const FixedVec<T, N> &_vec) const {
+        FixedVec<T, N> retvec = *this;
+        retvec -= _vec;
+        return retvec;
+    }
+
+    /**
+     * @brief Get reverse vector
+     *
+     * @return const FixedVec<T, N> Reverse vector
+     */
+    constexpr const FixedVec<T, N> operator-() const {
+        return FixedVec<T, N>() - *this;
+    }
+
+    /**
+     * @brief Get multipled vector
+     *
+     * @param _a                    Multiple coefficient
+     * @return const FixedVec<T, N> Multipled vector
+     */
+    constexpr const FixedVec<T, N> operator*(T _a) const {
+        FixedVec<T, N> retvec = *this;
+        retvec *= _a;
+        return retvec;
+    }
+
+    /**
+     * @brief Get divided vector
+     *
+     * @param _a                    Divide coefficient
+     * @return const FixedVec<T, N> Divided vector
+     */
+    constexpr const FixedVec<T, N> operator/(T _a) const {
+        FixedVec<T, N> retvec = *this;
+        retvec /= _a;
+        return retvec;
+    }
+
+    /**
+     * @brief Get scalar product
+     *
+     * @param _vec  Vector used scalar product
+     * @return T    Scalar product
+     */
+    constexpr T Dot(const FixedVec<T, N> &_vec) const {
+        T retvalue = T();
+        for (int i = 0; i < N; i++) {
+            retvalue += this->values[i] * _vec.values[i];
+        }
+        return retvalue;
+    }
+
+    /**
+     * @brief Get vector product
+     *
+     * @param _vec                  Vector used vector product
+     * @return const FixedVec<T, N> Vector product
+     */
+    constexpr const FixedVec<T, N> Cross(const FixedVec<T, N> &_vec) const {
+        static_assert(N == 3, "Cross is defined for 3 dimensional vectors");
+        FixedVec<T, N> retvec;
+        retvec[0] =
+            this->values[1] * _vec.values[2] - this->values[2] * _vec.values[1];
+        retvec[1] =
+            this->values[2] * _vec.values[0] - this->values[0] * _vec.values[2];
+        retvec[2] =
+            this->values[0] * _vec.values[1] - this->values[1] * _vec.values[0];
+        return retvec;
+    }
+
+    /**
+     * @brief Convert to Vec
+     *
+     * @return Vec<T>   Vec object converted from this object
+     */
+    operator Vec<T>() const {
+        Vec<T> retvec(N);
+        for (int i = 0; i < N; i++) {
+            retvec[i] = this->values[i];
+        }
+        return retvec;
+    }
+
+   private:
+    T values[N];
+};
+
+/**
+ * @brief Fixed size linear algebraic matrix class
+ *
+ * @tparam T    Type of element
+ * @tparam R    Row
+ * @tparam C    Column
+ */
+template <class T, int R, int C>
+class FixedMat {
+   public:
+    /**
+     * @brief Construct a new FixedMat object whose each element is _value
+     *
+     * @param _value    Each element value
+     */
+    constexpr explicit FixedMat(T _value = T()) : values{} {
+        for (int i = 0; i < R * C; i++) {
+            this->values[i] = _value;
+        }
+    }
+
+    /**
+     * @brief Construct a new FixedMat object
+     *
+     * @param _values   Format like {{1, 2, 3}, {4, 5, 6}}
+     */
+    constexpr FixedMat(
+        const std::initializer_list<std::initializer_list<T> > &_values)
+        : values{} {
+        assert(_values.size() == R);
+        int index = 0;
+        for (auto valuei : _values) {
+            assert(valuei.size() == C);
+            for (auto valueij : valuei) {
+                this->values[index] = valueij;
+                index++;
+            }
+        }
+    }
+
+    /**
+     * @brief Construct a new FixedMat object from Mat
+     *
+     * @param _mat  Source matrix whose row and column are R and C
+     */
+    explicit FixedMat(const Mat<T> &_mat) : values{} {
+        assert(_mat.Row() == R && _mat.Col() == C);
+        for (int i = 0; i < R * C; i++) {
+            this->values[i] = _mat.Values()[i];
+        }
+    }
+
+    /**
+     * @brief Get number of row
+     *
+     * @return int  Number of row
+     */
+    constexpr int Row() const { return R; }
+
+    /**
+     * @brief Get number of column
+     *
+     * @return int  Number of column
+     */
+    constexpr int Col() const { return C; }
+
+    /**
+     * @brief Get _i th row pointer without validation
+     *
+     * @param _i    Index of row
+     * @return T*   Pointer of _i th row
+     */
+    constexpr T *operator[](int _i) { return &this->values[C * _i]; }
+
+    /**
+     * @brief Get _i th row pointer without validation
+     *
+     * @param _i        Index of row
+     * @return const T* Pointer of _i th row
+     */
+    constexpr const T *operator[](int _i) const {
+        return &this->values[C * _i];
+    }
+
+    /**
+     * @brief Get (_i, _j) element value with validation
+     *
+     * @param _i    Index of row
+     * @param _j    Index of column
+     * @return T&   Reference of (_i, _j) element value
+     */
+    constexpr T &operator()(int _i, int _j) {
+        assert(0 <= _i && _i < R && 0 <= _j && _j < C);
+        return this->values[C * _i + _j];
+    }
+
+    /**
+     * @brief Get (_i, _j) element value with validation
+     *
+     * @param _i        Index of row
+     * @param _j        Index of column
+     * @return const T& Reference of (_i, _j) element value
+     */
+    constexpr const T &operator()(int _i, int _j) const {
+        assert(0 <= _i && _i < R && 0 <= _j && _j < C);
+        return this->values[C * _i + _j];
+    }
+
+    /**
+     * @brief Get pointer indicating value
+     *
+     * @return T*   Pointer indicating value
+     */
+    constexpr T *Values() { return this->values; }
+
+    /**
+     * @brief Get pointer indicating value
+     *
+     * @return const T* Pointer indicating value
+     */
+    constexpr const T *Values() const { return this->values; }
+
+    /**
+     * @brief Check the same
+     *
+     * @param _mat      Comparison
+     * @return true     Same with _mat
+     * @return false    Not the same
+     */
+    constexpr bool operator==(const FixedMat<T, R, C> &_mat) const {
+        for (int i = 0; i < R * C; i++) {
+            if (this->values[i] != _mat.values[i]) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief Check not the same
+     *
+     * @param _mat      Comparison
+     * @return true     Not the same
+     * @return false    Same with _mat
+     */
+    constexpr bool operator!=(const FixedMat<T, R, C> &_mat) const {
+        return !(*this == _mat);
+    }
+
+    /**
+     * @brief Compound assignment operator for addition
+     *
+     * @param _mat                  Assignor object
+     * @return FixedMat<T, R, C>&   Reference of this object
+     */
+    constexpr FixedMat<T, R, C> &operator+=(const FixedMat<T, R, C> &_mat) {
+        for (int i = 0; i < R * C; i++) {
+            this->values[i] += _mat.values[i];
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Compound assignment operator for subtraction
+     *
+     * @param _mat                  Assignor object
+     * @return FixedMat<T, R, C>&   Reference of this object
+     */
+    constexpr FixedMat<T, R, C> &operator-=(const FixedMat<T, R, C> &_mat) {
+        for (int i = 0; i < R * C; i++) {
+            this->values[i] -= _mat.values[i];
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Compound assignment operator for multiplication
+     *
+     * @param _a                    Coefficient of multiplication
+     * @return FixedMat<T, R, C>&   Reference of this object
+     */
+    constexpr FixedMat<T, R, C> &operator*=(T _a) {
+        for (int i = 0; i < R * C; i++) {
+            this->values[i] *= _a;
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Compound assignment operator for division
+     *
+     * @param _a                    Coefficient of division
+     * @return FixedMat<T, R, C>&   Reference of this object
+     */
+    constexpr FixedMat<T, R, C> &operator/=(T _a) {
+        for (int i = 0; i < R * C; i++) {
+            this->values[i] /= _a;
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Addition operator
+     *
+     * @param _mat                      Adding matrix
+     * @return const FixedMat<T, R, C>  Added matrix
+     */
+    constexpr const FixedMat<T, R, C> operator+(
+        const FixedMat<T, R, C> &_mat) const {
+        FixedMat<T, R, C> retmat = *this;
+        retmat += _mat;
+        return retmat;
+    }
+
+    /**
+     * @brief Subtraction operator
+     *
+     * @param _mat                      Subtracting matrix
+     * @return const FixedMat<T, R, C>  Subtracted matrix
+     */
+    constexpr const FixedMat<T, R, C> operator-(
+        const FixedMat<T, R, C> &_mat) const {
+        FixedMat<T, R, C> retmat = *this;
+        retmat -= _mat;
+        return retmat;
+    }
+
+    /**
+     * @brief Get sign reversed matrix
+     *
+     * @return const FixedMat<T, R, C>  Sign reversed matrix
+     */
+    constexpr const FixedMat<T, R, C> operator-() const {
+        return FixedMat<T, R, C>() - *this;
+    }
+
+    /**
+     * @brief Get multipled matrix
+     *
+     * @param _a                        Multiple coefficient
+     * @return const FixedMat<T, R, C>  Multipled matrix
+     */
+    constexpr const FixedMat<T, R, C> operator*(T _a) const {
+        FixedMat<T, R, C> retmat = *this;
+        retmat *= _a;
+        return retmat;
+    }
+
+    /**
+     * @brief Get divided matrix
+     *
+     * @param _a                        Divide coefficient
+     * @return const FixedMat<T, R, C>  Divided matrix
+     */
+    constexpr const FixedMat<T, R, C> operator/(T _a) const {
+        FixedMat<T, R, C> retmat = *this;
+        retmat /= _a;
+        return retmat;
+    }
+
+    /**
+     * @brief Get matrix matrix product
+     *
+     * @tparam K                        Column of _mat
+     * @param _mat                      Matrix used matrix matrix product
+     * @return const FixedMat<T, R, K>  Matrix from matrix matrix product
+     */
+    template <int K>
+    constexpr const FixedMat<T, R, K> operator*(
+        const FixedMat<T, C, K> &_mat) const {
+        FixedMat<T, R, K> retmat;
+        for (int i = 0; i < R; i++) {
+            for (int k = 0; k < C; k++) {
+                for (int j = 0; j < K; j++) {
+                    retmat[i][j] += this->values[C * i + k] * _mat[k][j];
+                }
+            }
+        }
+        return retmat;
+    }
+
+    /**
+     * @brief Get matrix vector product
+     *
+     * @param _vec                  Vector used matrix vector product
+     * @return const FixedVec<T, R> Vector from matrix vector product
+     */
+    constexpr const FixedVec<T, R> operator*(const FixedVec<T, C> &_vec) const {
+        FixedVec<T, R> retvec;
+        for (int i = 0; i < R; i++) {
+            for (int j = 0; j < C; j++) {
+                retvec[i] += this->values[C * i + j] * _vec[j];
+            }
+        }
+        return retvec;
+    }
+
+    /**
+     * @brief Transpose this matrix
+     *
+     * @return const FixedMat<T, C, R>  Transposed matrix
+     */
+    constexpr const FixedMat<T, C, R> Transpose() const {
+        FixedMat<T, C, R> retmat;
+        for (int i = 0; i < C; i++) {
+            for (int j = 0; j < R; j++) {
+                retmat[i][j] = this->values[C * j + i];
+            }
+        }
+        return retmat;
+    }
+
+    /**
+     * @brief Get determinant of this matrix
+     *
+     * Integral types use fraction free (Bareiss) elimination, which is exact,
+     * and the others use Gaussian elimination with partial pivoting.
+     *
+     * @return T    Determinant of this matrix
+     */
+    constexpr T Determinant() const {
+        static_assert(R == C, "Determinant is defined for square matrices");
+        FixedMat<T, R, C> a = *this;
+        T retvalue = T(1), previous = T(1);
+        for (int k = 0; k < R; k++) {
+            int p = k;
+            for (int i = k + 1; i < R; i++) {
+                if (Abs(a[i][k]) > Abs(a[p][k])) {
+                    p = i;
+                }
+            }
+            if (a[p][k] == T()) {
+                return T();
+            }
+            if (p != k) {
+                a.SwapRow(k, p);
+                retvalue = -retvalue;
+            }
+            for (int i = k + 1; i < R; i++) {
+                for (int j = k + 1; j < C; j++) {
+                    if (std::is_integral<T>::value) {
+                        a[i][j] =
+                            (a[i][j] * a[k][k] - a[i][k] * a[k][j]) / previous;
+                    } else {
+                        a[i][j] -= a[i][k] / a[k][k] * a[k][j];
+                    }
+                }
+            }
+            if (std::is_integral<T>::value) {
+                previous = a[k][k];
+            } else {
+                retvalue *= a[k][k];
+            }
+        }
+        return std::is_integral<T>::value ? retvalue * previous : retvalue;
+    }
+
+    /**
+     * @brief Get inverse matrix by Gauss-Jordan elimination with partial
+     * pivoting
+     *
+     * @return const FixedMat<T, R, C>  Inverse matrix
+     */
+    constexpr const FixedMat<T, R, C> Inverse() const {
+        static_assert(R == C, "Inverse is defined for square matrices");
+        FixedMat<T, R, C> a = *this, retmat = Identity();
+        for (int k = 0; k < R; k++) {
+            int p = k;
+            for (int i = k + 1; i < R; i++) {
+                if (Abs(a[i][k]) > Abs(a[p][k])) {
+                    p = i;
+                }
+            }
+            assert(a[p][k] != T());
+            a.SwapRow(k, p);
+            retmat.SwapRow(k, p);
+            T inv = T(1) / a[k][k];
+            for (int j = 0; j < C; j++) {
+                a[k][j] *= inv;
+                retmat[k][j] *= inv;
+            }
+            for (int i = 0; i < R; i++) {
+                if (i != k) {
+                    T l = a[i][k];
+                    for (int j = 0; j < C; j++) {
+                        a[i][j] -= l * a[k][j];
+                        retmat[i][j] -= l * retmat[k][j];
+                    }
+                }
+            }
+        }
+        return retmat;
+    }
+
+    /**
+     * @brief Get identity matrix
+     *
+     * @return const FixedMat<T, R, C>  Identity matrix
+     */
+    static constexpr const FixedMat<T, R, C> Identity() {
+        static_assert(R == C, "Identity is defined for square matrices");
+        FixedMat<T, R, C> retmat;
+        for (int i = 0; i < R; i++) {
+            retmat[i][i] = T(1);
+        }
+        return retmat;
+    }
+
+    /**
+     * @brief Convert to Mat
+     *
+     * @return Mat<T>   Mat object converted from this object
+     */
+    operator Mat<T>() const {
+        Mat<T> retmat(R, C);
+        for (int i = 0; i < R * C; i++) {
+            retmat.Values()[i] = this->values[i];
+        }
+        return retmat;
+    }
+
+   private:
+    T values[R * C];
+
+    static constexpr T Abs(T _value) { return _value < T() ? -_value : _value; }
+
+    constexpr void SwapRow(int _i, int _j) {
+        for (int k = 0; k < C; k++) {
+            T tmp = this->values[C * _i + k];
+            this->values[C * _i + k] = this->values[C * _j + k];
+            this->values[C * _j + k] = tmp;
+        }
+    }
+};
+
+/**
+ * @brief Get multipled vector
+ *
+ * @tparam U                    Type of coefficient and vector
+ * @tparam N                    Size of vector
+ * @param _a                    Multiple coefficient
+ * @param _vec                  Applied vector
+ * @return const FixedVec<U, N> Multipled vector
+ */
+template <class U, int N>
+constexpr const FixedVec<U, N> operator*(U _a, const FixedVec<U, N> &_vec) {
+    return _vec * _a;
+}
+
+/**
+ * @brief Get multipled matrix
+ *
+ * @tparam U                        Type of coefficient and matrix
+ * @tparam R                        Row of matrix
+ * @tparam C                        Column of matrix
+ * @param _a                        Multiple coefficient
+ * @param _mat                      Applied matrix
+ * @return const FixedMat<U, R, C>  Multipled matrix
+ */
+template <class U, int R, int C>
+constexpr const FixedMat<U, R, C> operator*(U _a,
+                                            const FixedMat<U, R, C> &_mat) {
+    return _mat * _a;
+}
+}  // namespace PANSFE
@@ -0,0 +1,39 @@
+/**
+ * @file index.h
+ * @author PANFACTORY (github/PANFACTORY)
+ * @brief Definition of index type and construction tag of vectors and
+ * matrices
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#pragma once
+#include <cstddef>
+
+/**
+ * @brief Signed integer type used for sizes, element indices and loop bounds
+ * of Vec and Mat, may be redefined before including any header
+ *
+ */
+#ifndef PANSFE_INDEX_TYPE
+#define PANSFE_INDEX_TYPE std::ptrdiff_t
+#endif
+
+namespace PANSFE {
+/**
+ * @brief Index type of vectors and matrices, 64-bit by default so that
+ * row * col does not overflow for more than 2^31 elements
+ *
+ */
+typedef PANSFE_INDEX_TYPE Index;
+
+/**
+ * @brief Tag selecting construction or resizing without initializing
+ * elements, for buffers about to be overwritten
+ *
+ */
+struct Uninitialized {};
+}  // namespace PANSFE
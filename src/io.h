@@ -0,0 +1,711 @@
+/**
+ * @file io.h
+ * @author PANFACTORY (github/PANFACTORY)
+ * @brief Definition and implementation of buffered text input and output of
+ * vector and matrix
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#pragma once
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "mat.h"
+#include "parallel.h"
+#include "profiler.h"
+#include "vec.h"
+
+namespace PANSFE {
+/**
+ * @brief Text format of Write and Read
+ *
+ */
+struct TextFormat {
+    /**
+     * @brief Construct a new TextFormat object
+     *
+     * @param _delimiter    Delimiter between elements in a row
+     * @param _precision    Significant digits, 0 means the shortest text read
+     * back to the same value
+     */
+    TextFormat(char _delimiter = '\t', int _precision = 0)
+        : delimiter(_delimiter), precision(_precision) {}
+
+    char delimiter;
+    int precision;
+};
+
+/**
+ * @brief Get comma separated text format
+ *
+ * @param _precision    Significant digits, 0 means shortest round trip
+ * @return TextFormat   CSV format
+ */
+inline TextFormat CSVFormat(int _precision = 0) {
+    return TextFormat(',', _precision);
+}
+
+/**
+ * @brief Convert text to float with correct rounding
+ *
+ * @param _text     Null terminated text
+ * @param _end      Position after the value
+ * @return float    Converted value
+ */
+inline float StringToFloat(const char *_text, char **_end, float) {
+    return std::strtof(_text, _end);
+}
+
+/**
+ * @brief Convert text to double with correct rounding
+ *
+ * @param _text     Null terminated text
+ * @param _end      Position after the value
+ * @return double   Converted value
+ */
+inline double StringToFloat(const char *_text, char **_end, double) {
+    return std::strtod(_text, _end);
+}
+
+/**
+ * @brief Convert text to long double with correct rounding
+ *
+ * @param _text         Null terminated text
+ * @param _end          Position after the value
+ * @return long double  Converted value
+ */
+inline long double StringToFloat(const char *_text, char **_end,
+                                 long double) {
+    return std::strtold(_text, _end);
+}
+
+/**
+ * @brief Format integral value into _buffer
+ *
+ * @tparam T        Integral type
+ * @param _buffer   Buffer of at least 48 characters
+ * @param _value    Value to format
+ * @return int      Number of characters written
+ */
+template <class T>
+inline typename std::enable_if<std::is_integral<T>::value, int>::type
+FormatNumber(char *_buffer, T _value, int) {
+    char digits[24];
+    int n = 0, size = 0;
+    unsigned long long u = (unsigned long long)_value;
+    if (_value < T()) {
+        _buffer[size++] = '-';
+        u = 0 - u;
+    }
+    do {
+        digits[n++] = char('0' + u % 10);
+        u /= 10;
+    } while (u > 0);
+    while (n > 0) {
+        _buffer[size++] = digits[--n];
+    }
+    return size;
+}
+
+/**
+ * @brief Binary floating point number f 2^e with 64 bit significand
+ *
+ */
+struct BinaryFloat {
+    std::uint64_t f;
+    int e;
+};
+
+/**
+ * @brief Get product of _x and _y with significand rounded to 64 bits
+ *
+ * @param _x            Multiplicand
+ * @param _y            Multiplier
+ * @return BinaryFloat  Product
+ */
+inline BinaryFloat MultiplyBinaryFloat(BinaryFloat _x, BinaryFloat _y) {
+    const std::uint64_t mask = 0xFFFFFFFFULL;
+    std::uint64_t xl = _x.f & mask, xh = _x.f >> 32, yl = _y.f & mask,
+                  yh = _y.f >> 32;
+    std::uint64_t ll = xl * yl, lh = xl * yh, hl = xh * yl, hh = xh * yh;
+    std::uint64_t middle = (ll >> 32) + (lh & mask) + (hl & mask) +
+                           (std::uint64_t(1) << 31);
+    return {hh + (lh >> 32) + (hl >> 32) + (middle >> 32), _x.e + _y.e + 64};
+}
+
+/**
+ * @brief Shift significand of _x left until its highest bit is set
+ *
+ * @param _x            Nonzero number
+ * @return BinaryFloat  Normalized number
+ */
+inline BinaryFloat NormalizeBinaryFloat(BinaryFloat _x) {
+    while ((_x.f >> 63) == 0) {
+        _x.f <<= 1;
+        _x.e--;
+    }
+    return _x;
+}
+
+/**
+ * @brief Get normalized 10^k whose product with a normalized number of
+ * binary exponent _e has binary exponent in [-60, -32]
+ *
+ * @param _e            Binary exponent of normalized number
+ * @param _k            Decimal exponent k of the power
+ * @return BinaryFloat  10^k rounded to 64 bit significand
+ */
+inline BinaryFloat CachedPowerOfTen(int _e, int &_k) {
+    static const BinaryFloat powers[] = {
+        {0xAB70FE17C79AC6CAULL, -1060}, {0xFF77B1FCBEBCDC4FULL, -1034},
+        {0xBE5691EF416BD60CULL, -1007}, {0x8DD01FAD907FFC3CULL, -980},
+        {0xD3515C2831559A83ULL, -954}, {0x9D71AC8FADA6C9B5ULL, -927},
+        {0xEA9C227723EE8BCBULL, -901}, {0xAECC49914078536DULL, -874},
+        {0x823C12795DB6CE57ULL, -847}, {0xC21094364DFB5637ULL, -821},
+        {0x9096EA6F3848984FULL, -794}, {0xD77485CB25823AC7ULL, -768},
+        {0xA086CFCD97BF97F4ULL, -741}, {0xEF340A98172AACE5ULL, -715},
+        {0xB23867FB2A35B28EULL, -688}, {0x84C8D4DFD2C63F3BULL, -661},
+        {0xC5DD44271AD3CDBAULL, -635}, {0x936B9FCEBB25C996ULL, -608},
+        {0xDBAC6C247D62A584ULL, -582}, {0xA3AB66580D5FDAF6ULL, -555},
+        {0xF3E2F893DEC3F126ULL, -529}, {0xB5B5ADA8AAFF80B8ULL, -502},
+        {0x87625F056C7C4A8BULL, -475}, {0xC9BCFF6034C13053ULL, -449},
+        {0x964E858C91BA2655ULL, -422}, {0xDFF9772470297EBDULL, -396},
+        {0xA6DFBD9FB8E5B88FULL, -369}, {0xF8A95FCF88747D94ULL, -343},
+        {0xB94470938FA89BCFULL, -316}, {0x8A08F0F8BF0F156BULL, -289},
+        {0xCDB02555653131B6ULL, -263}, {0x993FE2C6D07B7FACULL, -236},
+        {0xE45C10C42A2B3B06ULL, -210}, {0xAA242499697392D3ULL, -183},
+        {0xFD87B5F28300CA0EULL, -157}, {0xBCE5086492111AEBULL, -130},
+        {0x8CBCCC096F5088CCULL, -103}, {0xD1B71758E219652CULL, -77},
+        {0x9C40000000000000ULL, -50}, {0xE8D4A51000000000ULL, -24},
+        {0xAD78EBC5AC620000ULL, 3}, {0x813F3978F8940984ULL, 30},
+        {0xC097CE7BC90715B3ULL, 56}, {0x8F7E32CE7BEA5C70ULL, 83},
+        {0xD5D238A4ABE98068ULL, 109}, {0x9F4F2726179A2245ULL, 136},
+        {0xED63A231D4C4FB27ULL, 162}, {0xB0DE65388CC8ADA8ULL, 189},
+        {0x83C7088E1AAB65DBULL, 216}, {0xC45D1DF942711D9AULL, 242},
+        {0x924D692CA61BE758ULL, 269}, {0xDA01EE641A708DEAULL, 295},
+        {0xA26DA3999AEF774AULL, 322}, {0xF209787BB47D6B85ULL, 348},
+        {0xB454E4A179DD1877ULL, 375}, {0x865B86925B9BC5C2ULL, 402},
+        {0xC83553C5C8965D3DULL, 428}, {0x952AB45CFA97A0B3ULL, 455},
+        {0xDE469FBD99A05FE3ULL, 481}, {0xA59BC234DB398C25ULL, 508},
+        {0xF6C69A72A3989F5CULL, 534}, {0xB7DCBF5354E9BECEULL, 561},
+        {0x88FCF317F22241E2ULL, 588}, {0xCC20CE9BD35C78A5ULL, 614},
+        {0x98165AF37B2153DFULL, 641}, {0xE2A0B5DC971F303AULL, 667},
+        {0xA8D9D1535CE3B396ULL, 694}, {0xFB9B7CD9A4A7443CULL, 720},
+        {0xBB764C4CA7A44410ULL, 747}, {0x8BAB8EEFB6409C1AULL, 774},
+        {0xD01FEF10A657842CULL, 800}, {0x9B10A4E5E9913129ULL, 827},
+        {0xE7109BFBA19C0C9DULL, 853}, {0xAC2820D9623BF429ULL, 880},
+        {0x80444B5E7AA7CF85ULL, 907}, {0xBF21E44003ACDD2DULL, 933},
+        {0x8E679C2F5E44FF8FULL, 960}, {0xD433179D9C8CB841ULL, 986},
+        {0x9E19DB92B4E31BA9ULL, 1013}};
+    int f = -60 - _e - 1;
+    int k = f * 78913 / (1 << 18) + (f > 0 ? 1 : 0);
+    int index = (300 + k + 7) / 8;
+    _k = 8 * index - 300;
+    return powers[index];
+}
+
+/**
+ * @brief Generate shortest decimal digits of positive finite _value which
+ * parse back to _value, by the Grisu2 algorithm
+ *
+ * The digits are exact in every case and the shortest in nearly every case,
+ * without any multiple precision arithmetic.
+ *
+ * @tparam T            float or double
+ * @param _digits       Buffer of at least 20 characters
+ * @param _value        Positive finite value
+ * @param _exponent     Decimal exponent, _value = digits 10^_exponent
+ * @return int          Number of digits
+ */
+template <class T>
+inline int ShortestDigits(char *_digits, T _value, int &_exponent) {
+    typedef typename std::conditional<sizeof(T) == sizeof(std::uint64_t),
+                                      std::uint64_t, std::uint32_t>::type
+        Bits;
+    const int precision = std::numeric_limits<T>::digits;
+    const int bias = std::numeric_limits<T>::max_exponent - 1 + precision - 1;
+    const std::uint64_t hidden = std::uint64_t(1) << (precision - 1);
+    Bits bits;
+    std::memcpy(&bits, &_value, sizeof(T));
+    std::uint64_t fraction = bits & (hidden - 1);
+    int biased = int(bits >> (precision - 1));
+    BinaryFloat v = biased == 0
+                        ? BinaryFloat{fraction, 1 - bias}
+                        : BinaryFloat{fraction + hidden, biased - bias};
+    BinaryFloat plus = NormalizeBinaryFloat({2 * v.f + 1, v.e - 1});
+    BinaryFloat minus = fraction == 0 && biased > 1
+                            ? BinaryFloat{4 * v.f - 1, v.e - 2}
+                            : BinaryFloat{2 * v.f - 1, v.e - 1};
+    minus.f <<= minus.e - plus.e;
+    minus.e = plus.e;
+    v = NormalizeBinaryFloat(v);
+
+    int k;
+    BinaryFloat c = CachedPowerOfTen(plus.e, k);
+    BinaryFloat w = MultiplyBinaryFloat(v, c),
+                high = MultiplyBinaryFloat(plus, c),
+                low = MultiplyBinaryFloat(minus, c);
+    high.f--;
+    low.f++;
+    _exponent = -k;
+
+    int shift = -high.e;
+    std::uint64_t one = std::uint64_t(1) << shift;
+    std::uint64_t delta = high.f - low.f, distance = high.f - w.f;
+    std::uint32_t integral = std::uint32_t(high.f >> shift);
+    std::uint64_t fractional = high.f & (one - 1), power = 1, rest, unit;
+    int remaining = 1, length = 0;
+    while (integral >= 10 * power) {
+        power *= 10;
+        remaining++;
+    }
+    while (true) {
+        if (remaining > 0) {
+            _digits[length++] = char('0' + integral / power);
+            integral %= power;
+            remaining--;
+            rest = (std::uint64_t(integral) << shift) + fractional;
+            if (rest <= delta) {
+                _exponent += remaining;
+                unit = power << shift;
+                break;
+            }
+            power /= 10;
+        } else {
+            fractional *= 10;
+            _digits[length++] = char('0' + (fractional >> shift));
+            fractional &= one - 1;
+            delta *= 10;
+            distance *= 10;
+            _exponent--;
+            if (fractional <= delta) {
+                rest = fractional;
+                unit = one;
+                break;
+            }
+        }
+    }
+    while (rest < distance && delta - rest >= unit &&
+           (rest + unit < distance ||
+            distance - rest > rest + unit - distance)) {
+        _digits[length - 1]--;
+        rest += unit;
+    }
+    return length;
+}
+
+/**
+ * @brief Format floating point value into _buffer, with the fewest
+ * significant digits that parse back to _value when _precision is 0
+ *
+ * float and double are formatted from ShortestDigits, and long double by
+ * trying increasing precisions of snprintf.
+ *
+ * @tparam T            Floating point type
+ * @param _buffer       Buffer of at least 48 characters
+ * @param _value        Value to format
+ * @param _precision    Significant digits, 0 means shortest round trip
+ * @return int          Number of characters written
+ */
+template <class T>
+inline typename std::enable_if<std::is_floating_point<T>::value, int>::type
+FormatNumber(char *_buffer, T _value, int _precision) {
+    long double value = _value;
+    if (_precision > 0) {
+        return std::snprintf(_buffer, 48, "%.*Lg", _precision, value);
+    }
+    if (sizeof(T) > sizeof(double)) {
+        for (int p = std::numeric_limits<T>::digits10;; p++) {
+            int n = std::snprintf(_buffer, 48, "%.*Lg", p, value);
+            if (p >= std::numeric_limits<T>::max_digits10 ||
+                StringToFloat(_buffer, nullptr, T()) == _value) {
+                return n;
+            }
+        }
+    }
+    if (_value == T() || !(std::abs(_value) <= std::numeric_limits<T>::max())) {
+        return std::snprintf(_buffer, 48, "%g", double(_value));
+    }
+    typedef typename std::conditional<std::is_same<T, float>::value, float,
+                                      double>::type Binary;
+    char digits[24];
+    int size = 0, exponent;
+    if (_value < T()) {
+        _buffer[size++] = '-';
+    }
+    int n = ShortestDigits(digits, Binary(std::abs(_value)), exponent);
+    int leading = n + exponent - 1;
+    if (leading < -4 ||
+        leading >= std::max(n, std::numeric_limits<T>::digits10)) {
+        _buffer[size++] = digits[0];
+        if (n > 1) {
+            _buffer[size++] = '.';
+            std::memcpy(_buffer + size, digits + 1, n - 1);
+            size += n - 1;
+        }
+        _buffer[size++] = 'e';
+        _buffer[size++] = leading < 0 ? '-' : '+';
+        int e = std::abs(leading);
+        if (e >= 100) {
+            _buffer[size++] = char('0' + e / 100);
+        }
+        _buffer[size++] = char('0' + e / 10 % 10);
+        _buffer[size++] = char('0' + e % 10);
+    } else if (leading < 0) {
+        _buffer[size++] = '0';
+        _buffer[size++] = '.';
+        for (int i = leading + 1; i < 0; i++) {
+            _buffer[size++] = '0';
+        }
+        std::memcpy(_buffer + size, digits, n);
+        size += n;
+    } else if (leading + 1 >= n) {
+        std::memcpy(_buffer + size, digits, n);
+        size += n;
+        for (int i = n; i <= leading; i++) {
+            _buffer[size++] = '0';
+        }
+    } else {
+        std::memcpy(_buffer + size, digits, leading + 1);
+        size += leading + 1;
+        _buffer[size++] = '.';
+        std::memcpy(_buffer + size, digits + leading + 1, n - leading - 1);
+        size += n - leading - 1;
+    }
+    return size;
+}
+
+/**
+ * @brief Parse integral value from [_head, _tail)
+ *
+ * @tparam T            Integral type
+ * @param _head         Head of text
+ * @param _tail         Tail of text
+ * @param _value        Parsed value
+ * @return const char*  Position after the value, _head if no value is found
+ */
+template <class T>
+inline typename std::enable_if<std::is_integral<T>::value, const char *>::type
+ParseNumber(const char *_head, const char *_tail, T &_value) {
+    const char *p = _head;
+    bool negative = p < _tail && *p == '-';
+    if (p < _tail && (*p == '-' || *p == '+')) {
+        p++;
+    }
+    const char *digits = p;
+    unsigned long long u = 0;
+    for (; p < _tail && '0' <= *p && *p <= '9'; p++) {
+        u = 10 * u + (*p - '0');
+    }
+    if (p == digits) {
+        return _head;
+    }
+    _value = negative ? T(0 - u) : T(u);
+    return p;
+}
+
+/**
+ * @brief Parse floating point value from [_head, _tail), the text must be
+ * followed by a character which is not a part of number
+ *
+ * Numbers whose mantissa and power of ten are both exact in T are converted
+ * with one multiplication or division, which is correctly rounded, and the
+ * others fall back to strtod.
+ *
+ * @tparam T            Floating point type
+ * @param _head         Head of text
+ * @param _tail         Tail of text
+ * @param _value        Parsed value
+ * @return const char*  Position after the value, _head if no value is found
+ */
+template <class T>
+inline typename std::enable_if<std::is_floating_point<T>::value,
+                               const char *>::type
+ParseNumber(const char *_head, const char *_tail, T &_value) {
+    static const double power[] = {1e0,  1e1,  1e2,  1e3,  1e4,  1e5,
+                                   1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+                                   1e12, 1e13, 1e14, 1e15, 1e16, 1e17,
+                                   1e18, 1e19, 1e20, 1e21, 1e22};
+    const int maxpower = std::is_same<T, float>::value    ? 10
+                         : std::is_same<T, double>::value ? 22
+                                                          : -1;
+    const char *p = _head;
+    bool negative = p < _tail && *p == '-';
+    if (p < _tail && (*p == '-' || *p == '+')) {
+        p++;
+    }
+    std::uint64_t mantissa = 0;
+    int numdigits = 0, exponent = 0;
+    bool exact = true;
+    for (; p < _tail && '0' <= *p && *p <= '9'; p++, numdigits++) {
+        if (mantissa < (std::uint64_t(1) << 60)) {
+            mantissa = 10 * mantissa + (*p - '0');
+        } else {
+            exponent++;
+            exact = exact && *p == '0';
+        }
+    }
+    if (p < _tail && *p == '.') {
+        for (p++; p < _tail && '0' <= *p && *p <= '9'; p++, numdigits++) {
+            if (mantissa < (std::uint64_t(1) << 60)) {
+                mantissa = 10 * mantissa + (*p - '0');
+                exponent--;
+            } else {
+                exact = exact && *p == '0';
+            }
+        }
+    }
+    if (numdigits > 0 && p < _tail && (*p == 'e' || *p == 'E')) {
+        const char *q = p + 1;
+        bool negativeexponent = q < _tail && *q == '-';
+        if (q < _tail && (*q == '-' || *q == '+')) {
+            q++;
+        }
+        if (q < _tail && '0' <= *q && *q <= '9') {
+            int e = 0;
+            for (; q < _tail && '0' <= *q && *q <= '9'; q++) {
+                e = e < 100000 ? 10 * e + (*q - '0') : e;
+            }
+            exponent += negativeexponent ? -e : e;
+            p = q;
+        }
+    }
+    if (numdigits > 0 && exact &&
+        mantissa <= (std::uint64_t(1) << std::numeric_limits<T>::digits) &&
+        -maxpower <= exponent && exponent <= maxpower) {
+        T value = T(mantissa);
+        value = exponent < 0 ? value / T(power[-exponent])
+                             : value * T(power[exponent]);
+        _value = negative ? -value : value;
+        return p;
+    }
+    char *end;
+    T value = StringToFloat(_head, &end, T());
+    if (end == _head) {
+        return _head;
+    }
+    _value = value;
+    return end;
+}
+
+/**
+ * @brief Append formatted number to _text
+ *
+ * @tparam T            Arithmetic type
+ * @param _text         Destination
+ * @param _value        Number
+ * @param _precision    Significant digits, 0 means shortest round trip
+ */
+template <class T>
+inline void AppendNumber(std::string &_text, T _value, int _precision) {
+    char buffer[48];
+    _text.append(buffer, FormatNumber(buffer, _value, _precision));
+}
+
+/**
+ * @brief Write _numlines lines formatted by _put(i, text) to stream
+ *
+ * Chunks of _chunk lines are formatted into separate buffers in parallel and
+ * a batch of chunks is passed to the stream with one write each, so the
+ * stream is never flushed per line.
+ *
+ * @tparam F        Type of callable appending line i to text
+ * @param _out      Stream
+ * @param _numlines Number of lines
+ * @param _chunk    Number of lines per chunk
+ * @param _put      Callable appending line i to text
+ */
+template <class F>
+inline void WriteLines(std::ostream &_out, Index _numlines, Index _chunk,
+                       const F &_put) {
+    Index numchunks = (_numlines + _chunk - 1) / _chunk;
+    Index batch = 4 * GetNumThreads();
+    std::vector<std::string> texts(batch);
+    for (Index head = 0; head < numchunks; head += batch) {
+        Index tail = std::min(numchunks, head + batch);
+        ParallelFor(head, tail, [&](Index _c) {
+            std::string &text = texts[_c - head];
+            text.clear();
+            Index last = std::min(_numlines, _chunk * (_c + 1));
+            for (Index i = _chunk * _c; i < last; i++) {
+                _put(i, text);
+            }
+        });
+        for (Index c = head; c < tail; c++) {
+            _out.write(texts[c - head].data(), texts[c - head].size());
+        }
+    }
+}
+
+/**
+ * @brief Write _vec one element per line
+ *
+ * @tparam T        Type of element
+ * @param _out      Stream
+ * @param _vec      Vector
+ * @param _format   Text format
+ */
+template <class T>
+inline void Write(std::ostream &_out, const Vec<T> &_vec,
+                  const TextFormat &_format = TextFormat()) {
+    PANSFE_PROFILE_SCOPE("Write", 0, sizeof(T) * double(_vec.Size()));
+    WriteLines(_out, _vec.Size(), 4096, [&](Index _i, std::string &_text) {
+        AppendNumber(_text, _vec[_i], _format.precision);
+        _text.push_back('\n');
+    });
+}
+
+/**
+ * @brief Write _mat one row per line, elements separated by the delimiter
+ *
+ * @tparam T        Type of element
+ * @param _out      Stream
+ * @param _mat      Matrix
+ * @param _format   Text format
+ */
+template <class T>
+inline void Write(std::ostream &_out, const Mat<T> &_mat,
+                  const TextFormat &_format = TextFormat()) {
+    PANSFE_PROFILE_SCOPE("Write", 0,
+                         sizeof(T) * double(_mat.Row()) * _mat.Col());
+    Index chunk = std::max<Index>(1, 4096 / std::max<Index>(1, _mat.Col()));
+    WriteLines(_out, _mat.Row(), chunk, [&](Index _i, std::string &_text) {
+        const T *rowi = _mat[_i];
+        for (Index j = 0; j < _mat.Col(); j++) {
+            if (j > 0) {
+                _text.push_back(_format.delimiter);
+            }
+            AppendNumber(_text, rowi[j], _format.precision);
+        }
+        _text.push_back('\n');
+    });
+}
+
+/**
+ * @brief Read rest of stream in large blocks, reaching the end of stream
+ * sets only eofbit of _in
+ *
+ * @param _in           Stream
+ * @return std::string  Text, terminated by '\0'
+ */
+inline std::string ReadText(std::istream &_in) {
+    std::string text;
+    std::vector<char> block(1 << 20);
+    while (_in.read(block.data(), block.size()) || _in.gcount() > 0) {
+        text.append(block.data(), _in.gcount());
+    }
+    if (_in.eof() && !_in.bad()) {
+        _in.clear(std::ios::eofbit);
+    }
+    return text;
+}
+
+/**
+ * @brief Read vector whose elements are separated by the delimiter, blanks
+ * or line breaks
+ *
+ * @tparam T            Type of element
+ * @param _in           Stream
+ * @param _format       Text format
+ * @return const Vec<T> Vector read, empty with failbit of _in set if a token
+ * is not a number
+ */
+template <class T>
+inline const Vec<T> ReadVec(std::istream &_in,
+                            const TextFormat &_format = TextFormat()) {
+    PANSFE_PROFILE_SCOPE("ReadVec", 0, 0);
+    std::string text = ReadText(_in);
+    const char *p = text.c_str(), *tail = p + text.size();
+    std::vector<T> values;
+    while (true) {
+        while (p < tail && (*p == _format.delimiter || *p == ' ' ||
+                            *p == '\t' || *p == '\r' || *p == '\n')) {
+            p++;
+        }
+        if (p == tail) {
+            break;
+        }
+        T value = T();
+        const char *next = ParseNumber(p, tail, value);
+        if (next == p) {
+            _in.setstate(std::ios::failbit);
+            return Vec<T>();
+        }
+        values.push_back(value);
+        p = next;
+    }
+    Vec<T> retvec(Index(values.size()), Uninitialized());
+    std::copy(values.begin(), values.end(), retvec.Values());
+    return retvec;
+}
+
+/**
+ * @brief Read matrix one row per line, elements separated by the delimiter
+ * or blanks, blank lines are skipped
+ *
+ * @tparam T            Type of element
+ * @param _in           Stream
+ * @param _format       Text format
+ * @return const Mat<T> Matrix read, empty with failbit of _in set if a token
+ * is not a number or rows differ in length
+ */
+template <class T>
+inline const Mat<T> ReadMat(std::istream &_in,
+                            const TextFormat &_format = TextFormat()) {
+    PANSFE_PROFILE_SCOPE("ReadMat", 0, 0);
+    std::string text = ReadText(_in);
+    const char *p = text.c_str(), *tail = p + text.size();
+    std::vector<T> values;
+    Index row = 0, col = -1;
+    while (p < tail) {
+        Index count = 0;
+        while (true) {
+            while (p < tail && (*p == _format.delimiter || *p == ' ' ||
+                                *p == '\t' || *p == '\r')) {
+                p++;
+            }
+            if (p == tail || *p == '\n') {
+                break;
+            }
+            T value = T();
+            const char *next = ParseNumber(p, tail, value);
+            if (next == p) {
+                _in.setstate(std::ios::failbit);
+                return Mat<T>();
+            }
+            values.push_back(value);
+            count++;
+            p = next;
+        }
+        if (p < tail) {
+            p++;
+        }
+        if (count > 0) {
+            if (col >= 0 && count != col) {
+                _in.setstate(std::ios::failbit);
+                return Mat<T>();
+            }
+            col = count;
+            row++;
+        }
+    }
+    Mat<T> retmat(row, Index(values.size()) / std::max<Index>(1, row),
+                  Uninitialized());
+    std::copy(values.begin(), values.end(), retmat.Values());
+    return retmat;
+}
+}  // namespace PANSFE
@@ -0,0 +1,261 @@
+/**
+ * @file iterative.h
+ * @author PANFACTORY (github/PANFACTORY)
+ * @brief Definition and implementation of iterative solvers on linear
+ * operators
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#pragma once
+#include <cassert>
+#include <cmath>
+#include <limits>
+
+#include "linearoperator.h"
+#include "parallel.h"
+#include "profiler.h"
+#include "vec.h"
+
+namespace PANSFE {
+/**
+ * @brief Preconditioned conjugate gradient solver for symmetric positive
+ * definite operator
+ *
+ * Only Apply of the operator and of the preconditioner is used, so both may
+ * be matrix-free.
+ *
+ * @tparam T Type of element
+ */
+template <class T>
+class ConjugateGradient {
+   public:
+    /**
+     * @brief Construct a new ConjugateGradient object
+     *
+     * @param _a            Symmetric positive definite operator
+     * @param _tolerance    Tolerance of relative residual |r| / |b|
+     * @param _maxiteration Maximum number of iterations
+     */
+    explicit ConjugateGradient(
+        const LinearOperator<T> &_a,
+        T _tolerance = std::sqrt(std::numeric_limits<T>::epsilon()),
+        int _maxiteration = 1000)
+        : a(_a),
+          tolerance(_tolerance),
+          maxiteration(_maxiteration),
+          iteration(0),
+          residual(T()),
+          converged(false) {
+        assert(_a.Row() == _a.Col());
+    }
+
+    /**
+     * @brief Set preconditioner applying M^-1, an operator of size zero
+     * removes it
+     *
+     * @param _m    Preconditioner
+     */
+    void SetPreconditioner(const LinearOperator<T> &_m) {
+        assert(_m.Row() == 0 || (_m.Row() == this->a.Row() &&
+                                 _m.Col() == this->a.Row()));
+        this->m = _m;
+    }
+
+    /**
+     * @brief Solve A x = _b from zero initial guess
+     *
+     * @param _b            Right hand side
+     * @return const Vec<T> Solution
+     */
+    const Vec<T> Solve(const Vec<T> &_b) {
+        Vec<T> retvec(this->a.Row());
+        this->Solve(_b, retvec);
+        return retvec;
+    }
+
+    /**
+     * @brief Solve A x = _b
+     *
+     * @param _b    Right hand side
+     * @param _x    Initial guess on input and solution on output
+     */
+    void Solve(const Vec<T> &_b, Vec<T> &_x) {
+        PANSFE_PROFILE_SCOPE("ConjugateGradient::Solve", 0, 0);
+        Index n = this->a.Row();
+        assert(_b.Size() == n && _x.Size() == n);
+        Vec<T> r(n), z(n), p(n), q(n);
+        this->a.Apply(_x, q);
+        for (Index i = 0; i < n; i++) {
+            r[i] = _b[i] - q[i];
+        }
+        T bnorm = _b.Norm();
+        if (bnorm == T()) {
+            bnorm = T(1);
+        }
+        this->iteration = 0;
+        this->residual = r.Norm() / bnorm;
+        this->converged = this->residual <= this->tolerance;
+        if (this->converged) {
+            return;
+        }
+        this->Precondition(r, z);
+        p = z;
+        T rz = r.Dot(z);
+        T *x = _x.Values(), *rv = r.Values(), *pv = p.Values();
+        const T *zv = z.Values(), *qv = q.Values();
+        while (this->iteration < this->maxiteration) {
+            this->iteration++;
+            this->a.Apply(p, q);
+            T alpha = rz / p.Dot(q);
+            ParallelFor(
+                0, n,
+                [&](Index _i) {
+                    x[_i] += alpha * pv[_i];
+                    rv[_i] -= alpha * qv[_i];
+                },
+                4096);
+            this->residual = r.Norm() / bnorm;
+            if (this->residual <= this->tolerance) {
+                this->converged = true;
+                return;
+            }
+            this->Precondition(r, z);
+            T rznew = r.Dot(z);
+            T beta = rznew / rz;
+            rz = rznew;
+            ParallelFor(
+                0, n, [&](Index _i) { pv[_i] = zv[_i] + beta * pv[_i]; },
+                4096);
+        }
+    }
+
+    /**
+     * @brief Get number of iterations of the last Solve
+     *
+     * @return int  Number of iterations
+     */
+    int Iteration() const { return this->iteration; }
+
+    /**
+     * @brief Get relative residual |r| / |b| of the last Solve
+     *
+     * @return T    Relative residual
+     */
+    T Residual() const { return this->residual; }
+
+    /**
+     * @brief Check whether the last Solve reached the tolerance
+     *
+     * @return true     Converged
+     * @return false    Not converged within maximum iterations
+     */
+    bool IsConverged() const { return this->converged; }
+
+   private:
+    LinearOperator<T> a, m;
+    T tolerance;
+    int maxiteration, iteration;
+    T residual;
+    bool converged;
+
+    void Precondition(const Vec<T> &_r, Vec<T> &_z) const {
+        if (this->m.Row() == 0) {
+            _z = _r;
+        } else {
+            this->m.Apply(_r, _z);
+        }
+    }
+};
+
+/**
+ * @brief Power iteration for the eigenvalue of largest magnitude
+ *
+ * @tparam T Type of element
+ */
+template <class T>
+class PowerIteration {
+   public:
+    /**
+     * @brief Construct a new PowerIteration object and iterate
+     *
+     * @param _a            Square operator
+     * @param _tolerance    Tolerance of |A v - lambda v| / |lambda|
+     * @param _maxiteration Maximum number of iterations
+     */
+    explicit PowerIteration(
+        const LinearOperator<T> &_a,
+        T _tolerance = std::sqrt(std::numeric_limits<T>::epsilon()),
+        int _maxiteration = 1000)
+        : eigenvalue(T()),
+          eigenvector(_a.Row()),
+          iteration(0),
+          converged(false) {
+        PANSFE_PROFILE_SCOPE("PowerIteration::PowerIteration", 0, 0);
+        assert(_a.Row() == _a.Col());
+        Index n = _a.Row();
+        for (Index i = 0; i < n; i++) {
+            this->eigenvector[i] = T(1) + T(i % 7) / T(10);
+        }
+        this->eigenvector /= this->eigenvector.Norm();
+        Vec<T> w(n);
+        while (this->iteration < _maxiteration) {
+            this->iteration++;
+            _a.Apply(this->eigenvector, w);
+            this->eigenvalue = this->eigenvector.Dot(w);
+            T error = T();
+            for (Index i = 0; i < n; i++) {
+                T d = w[i] - this->eigenvalue * this->eigenvector[i];
+                error += d * d;
+            }
+            T wnorm = w.Norm();
+            if (wnorm == T()) {
+                break;
+            }
+            this->eigenvector = w / wnorm;
+            if (std::sqrt(error) <= _tolerance * std::abs(this->eigenvalue)) {
+                this->converged = true;
+                break;
+            }
+        }
+    }
+
+    /**
+     * @brief Get eigenvalue of largest magnitude
+     *
+     * @return T    Eigenvalue
+     */
+    T Eigenvalue() const { return this->eigenvalue; }
+
+    /**
+     * @brief Get normalized eigenvector
+     *
+     * @return const Vec<T>&    Eigenvector
+     */
+    const Vec<T> &Eigenvector() const { return this->eigenvector; }
+
+    /**
+     * @brief Get number of iterations
+     *
+     * @return int  Number of iterations
+     */
+    int Iteration() const { return this->iteration; }
+
+    /**
+     * @brief Check whether the iteration reached the tolerance
+     *
+     * @return true     Converged
+     * @return false    Not converged within maximum iterations
+     */
+    bool IsConverged() const { return this->converged; }
+
+   private:
+    T eigenvalue;
+    Vec<T> eigenvector;
+    int iteration;
+    bool converged;
+};
+}  // namespace PANSFE
@@ -0,0 +1,331 @@
+/**
+ * @file kronecker.h
+ * @author PANFACTORY (github/PANFACTORY)
+ * @brief Definition and implementation of lazy Kronecker product class
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#pragma once
+#include <algorithm>
+#include <cassert>
+#include <utility>
+#include <vector>
+
+#include "lu.h"
+#include "mat.h"
+#include "parallel.h"
+#include "profiler.h"
+#include "vec.h"
+
+namespace PANSFE {
+/**
+ * @brief Kronecker product A_0 ⊗ A_1 ⊗ ... ⊗ A_{d-1} kept as its factors
+ *
+ * Products with vectors are computed by sum-factorization, one mode at a
+ * time, so for d factors of size n they cost O(d n^{d+1}) instead of
+ * O(n^{2d}). The first factor is the outermost, i.e. the row index is
+ * (i_0 r_1 + i_1) r_2 + i_2 and so on.
+ *
+ * @tparam T Type of element
+ */
+template <class T>
+class Kronecker {
+   public:
+    /**
+     * @brief Construct a new Kronecker object without factors
+     *
+     */
+    Kronecker() : row(0), col(0) {}
+
+    /**
+     * @brief Construct a new Kronecker object _a ⊗ _b
+     *
+     * @param _a    Outer factor
+     * @param _b    Inner factor
+     */
+    Kronecker(const Mat<T> &_a, const Mat<T> &_b)
+        : Kronecker(std::vector<Mat<T> >({_a, _b})) {}
+
+    /**
+     * @brief Construct a new Kronecker object of factors
+     *
+     * @param _factors  Factors from the outermost
+     */
+    explicit Kronecker(std::vector<Mat<T> > _factors)
+        : factors(std::move(_factors)) {
+        assert(!this->factors.empty());
+        this->row = 1;
+        this->col = 1;
+        for (const Mat<T> &factor : this->factors) {
+            this->row *= factor.Row();
+            this->col *= factor.Col();
+        }
+    }
+
+    /**
+     * @brief Get number of row
+     *
+     * @return Index    Number of row
+     */
+    Index Row() const { return this->row; }
+
+    /**
+     * @brief Get number of column
+     *
+     * @return Index    Number of column
+     */
+    Index Col() const { return this->col; }
+
+    /**
+     * @brief Get number of factors
+     *
+     * @return int  Number of factors
+     */
+    int Factors() const { return int(this->factors.size()); }
+
+    /**
+     * @brief Get _k th factor
+     *
+     * @param _k                Index of factor
+     * @return const Mat<T>&    _k th factor
+     */
+    const Mat<T> &Factor(int _k) const { return this->factors[_k]; }
+
+    /**
+     * @brief Get (_i, _j) element as the product of factor elements
+     *
+     * @param _i    Index of row
+     * @param _j    Index of column
+     * @return T    (_i, _j) element value
+     */
+    T operator()(Index _i, Index _j) const {
+        assert(0 <= _i && _i < this->row && 0 <= _j && _j < this->col);
+        T retvalue = T(1);
+        for (int k = this->Factors() - 1; k >= 0; k--) {
+            const Mat<T> &factor = this->factors[k];
+            retvalue *= factor[_i % factor.Row()][_j % factor.Col()];
+            _i /= factor.Row();
+            _j /= factor.Col();
+        }
+        return retvalue;
+    }
+
+    /**
+     * @brief Set _y = A _x by sum-factorization
+     *
+     * @param _x    Vector used matrix vector product
+     * @param _y    Vector from matrix vector product, sized Row()
+     */
+    void Apply(const Vec<T> &_x, Vec<T> &_y) const {
+        PANSFE_PROFILE_SCOPE("Kronecker::Apply", this->Flops(),
+                             sizeof(T) * double(this->row + this->col));
+        assert(_x.Size() == this->col && _y.Size() == this->row);
+        this->Multiply(_x, _y, false);
+    }
+
+    /**
+     * @brief Set _y = A^T _x by sum-factorization
+     *
+     * @param _x    Vector used matrix vector product, sized Row()
+     * @param _y    Vector from matrix vector product, sized Col()
+     */
+    void ApplyTranspose(const Vec<T> &_x, Vec<T> &_y) const {
+        PANSFE_PROFILE_SCOPE("Kronecker::ApplyTranspose", this->Flops(),
+                             sizeof(T) * double(this->row + this->col));
+        assert(_x.Size() == this->row && _y.Size() == this->col);
+        this->Multiply(_x, _y, true);
+    }
+
+    /**
+     * @brief Get matrix vector product
+     *
+     * @param _vec          Vector used matrix vector product
+     * @return const Vec<T> Vector from matrix vector product
+     */
+    const Vec<T> operator*(const Vec<T> &_vec) const {
+        Vec<T> retvec(this->row, Uninitialized());
+        this->Apply(_vec, retvec);
+        return retvec;
+    }
+
+    /**
+     * @brief Get product by the mixed-product property
+     * (A ⊗ B)(C ⊗ D) = AC ⊗ BD
+     *
+     * @param _kronecker        Kronecker product with as many factors, whose
+     * factor rows match factor columns of this
+     * @return const Kronecker  Kronecker product of factor products
+     */
+    const Kronecker<T> operator*(const Kronecker<T> &_kronecker) const {
+        assert(this->Factors() == _kronecker.Factors());
+        std::vector<Mat<T> > factors(this->factors.size());
+        for (int k = 0; k < this->Factors(); k++) {
+            assert(this->factors[k].Col() == _kronecker.factors[k].Row());
+            factors[k] = this->factors[k] * _kronecker.factors[k];
+        }
+        return Kronecker<T>(std::move(factors));
+    }
+
+    /**
+     * @brief Get diagonal elements
+     *
+     * @return const Vec<T> Vector of (i, i) elements
+     */
+    const Vec<T> Diagonal() const {
+        Index n = std::min(this->row, this->col);
+        Vec<T> retvec(n, Uninitialized());
+        T *diagonal = retvec.Values();
+        ParallelFor(
+            0, n, [&](Index _i) { diagonal[_i] = (*this)(_i, _i); }, 4096);
+        return retvec;
+    }
+
+    /**
+     * @brief Transpose this product, A^T ⊗ B^T
+     *
+     * @return const Kronecker<T>   Transposed product
+     */
+    const Kronecker<T> Transpose() const {
+        std::vector<Mat<T> > factors;
+        factors.reserve(this->factors.size());
+        for (const Mat<T> &factor : this->factors) {
+            factors.push_back(factor.Transpose());
+        }
+        return Kronecker<T>(std::move(factors));
+    }
+
+    /**
+     * @brief Get inverse, A^-1 ⊗ B^-1, with each square factor inverted by
+     * LU factorization
+     *
+     * @return const Kronecker<T>   Inverse product
+     */
+    const Kronecker<T> Inverse() const {
+        PANSFE_PROFILE_SCOPE("Kronecker::Inverse", 0, 0);
+        std::vector<Mat<T> > factors;
+        factors.reserve(this->factors.size());
+        for (const Mat<T> &factor : this->factors) {
+            assert(factor.Row() == factor.Col());
+            LU<T> lu(factor);
+            assert(!lu.IsSingular());
+            factors.push_back(lu.Inverse());
+        }
+        return Kronecker<T>(std::move(factors));
+    }
+
+    /**
+     * @brief Solve A x = _b through the inverse factors
+     *
+     * @param _b            Right hand side
+     * @return const Vec<T> Solution
+     */
+    const Vec<T> Solve(const Vec<T> &_b) const {
+        return this->Inverse() * _b;
+    }
+
+    /**
+     * @brief Materialize as dense matrix
+     *
+     * @return Mat<T>   Dense matrix
+     */
+    explicit operator Mat<T>() const {
+        PANSFE_PROFILE_SCOPE("Kronecker::operator Mat", 0,
+                             sizeof(T) * double(this->row) * this->col);
+        Mat<T> retmat = this->factors[0];
+        for (int k = 1; k < this->Factors(); k++) {
+            const Mat<T> &factor = this->factors[k];
+            Index rb = factor.Row(), cb = factor.Col();
+            Mat<T> product(retmat.Row() * rb, retmat.Col() * cb,
+                           Uninitialized());
+            const Mat<T> &a = retmat;
+            T *p = product.Values();
+            ParallelFor(0, a.Row() * rb, [&](Index _i) {
+                const T *ai = a[_i / rb], *bi = factor[_i % rb];
+                T *pi = p + product.Col() * _i;
+                for (Index j = 0; j < a.Col(); j++) {
+                    for (Index l = 0; l < cb; l++) {
+                        pi[cb * j + l] = ai[j] * bi[l];
+                    }
+                }
+            });
+            retmat = product;
+        }
+        return retmat;
+    }
+
+   private:
+    Index row, col;
+    std::vector<Mat<T> > factors;
+
+    double Flops() const {
+        double flops = 0.0, left = 1.0, right = double(this->col);
+        for (const Mat<T> &factor : this->factors) {
+            right /= factor.Col();
+            flops += 2.0 * left * factor.Row() * factor.Col() * right;
+            left *= factor.Row();
+        }
+        return flops;
+    }
+
+    void Multiply(const Vec<T> &_x, Vec<T> &_y, bool _transpose) const {
+        int d = this->Factors();
+        std::vector<Index> rows(d), cols(d);
+        for (int k = 0; k < d; k++) {
+            rows[k] = _transpose ? this->factors[k].Col()
+                                 : this->factors[k].Row();
+            cols[k] = _transpose ? this->factors[k].Row()
+                                 : this->factors[k].Col();
+        }
+        Index left = 1, right = _x.Size(), workspace = 0;
+        for (int k = 0; k < d - 1; k++) {
+            right /= cols[k];
+            left *= rows[k];
+            workspace = std::max(workspace, left * right);
+        }
+        std::vector<T> buffers[2] = {std::vector<T>(workspace),
+                                     std::vector<T>(workspace)};
+        const T *source = _x.Values();
+        T *destination = _y.Values();
+        left = 1;
+        right = _x.Size();
+        for (int k = 0; k < d; k++) {
+            right /= cols[k];
+            T *target = k == d - 1 ? destination : buffers[k % 2].data();
+            ModeProduct(this->factors[k], _transpose, left, right, source,
+                        target);
+            source = target;
+            left *= rows[k];
+        }
+    }
+
+    static void ModeProduct(const Mat<T> &_a, bool _transpose, Index _left,
+                            Index _right, const T *_source, T *_target) {
+        Index m = _transpose ? _a.Col() : _a.Row();
+        Index n = _transpose ? _a.Row() : _a.Col();
+        const T *a = _a.Values();
+        Index si = _transpose ? 1 : _a.Col(), sj = _transpose ? _a.Col() : 1;
+        ParallelFor(
+            0, _left * m,
+            [&](Index _li) {
+                Index l = _li / m, i = _li % m;
+                T *target = _target + _right * _li;
+                const T *source = _source + _right * n * l;
+                for (Index r = 0; r < _right; r++) {
+                    target[r] = T();
+                }
+                for (Index j = 0; j < n; j++) {
+                    T aij = a[si * i + sj * j];
+                    const T *sourcej = source + _right * j;
+                    for (Index r = 0; r < _right; r++) {
+                        target[r] += aij * sourcej[r];
+                    }
+                }
+            },
+            std::max<Index>(1, 16384 / std::max<Index>(1, n * _right)));
+    }
+};
+}  // namespace PANSFE
@@ -0,0 +1,184 @@
+/**
+ * @file linearoperator.h
+ * @author PANFACTORY (github/PANFACTORY)
+ * @brief Definition and implementation of matrix-free linear operator
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#pragma once
+#include <cassert>
+#include <functional>
+#include <type_traits>
+#include <utility>
+
+#include "vec.h"
+
+namespace PANSFE {
+/**
+ * @brief Type erased linear operator y = A x
+ *
+ * Any object M providing Row(), Col(), M.Apply(x, y), M.ApplyTranspose(x, y)
+ * and M.Diagonal() converts implicitly, such as Mat, SymMat, SparseMat and
+ * BlockSparseMat. The operator keeps a pointer to M, which must outlive it,
+ * so converting a temporary is rejected at compile time.
+ * Matrix-free operators are built from callables instead, where the transpose
+ * and the diagonal are optional.
+ *
+ * @tparam T Type of element
+ */
+template <class T>
+class LinearOperator {
+   public:
+    /**
+     * @brief Type of callable setting y = A x, y is sized in advance
+     *
+     */
+    typedef std::function<void(const Vec<T> &, Vec<T> &)> Function;
+
+    /**
+     * @brief Construct a new LinearOperator object whose row and column are
+     * zero
+     *
+     */
+    LinearOperator() : row(0), col(0) {}
+
+    /**
+     * @brief Construct a new LinearOperator object from callables
+     *
+     * @param _row              Row of the operator
+     * @param _col              Column of the operator
+     * @param _apply            Callable setting y = A x
+     * @param _applytranspose   Callable setting y = A^T x, may be empty
+     * @param _diagonal         Diagonal elements, may be empty
+     */
+    LinearOperator(Index _row, Index _col, Function _apply,
+                   Function _applytranspose = Function(),
+                   const Vec<T> &_diagonal = Vec<T>())
+        : row(_row),
+          col(_col),
+          apply(std::move(_apply)),
+          applytranspose(std::move(_applytranspose)) {
+        assert(this->apply);
+        if (_diagonal.Size() != 0) {
+            this->diagonal = [_diagonal]() { return _diagonal; };
+        }
+    }
+
+    /**
+     * @brief Construct a new LinearOperator object referring to a matrix type
+     *
+     * @tparam M    Type providing Row, Col, Apply, ApplyTranspose and Diagonal
+     * @param _mat  Matrix which must outlive the operator
+     */
+    template <class M, class = typename std::enable_if<!std::is_base_of<
+                           LinearOperator<T>, M>::value>::type>
+    LinearOperator(const M &_mat)
+        : row(_mat.Row()), col(_mat.Col()) {
+        const M *mat = &_mat;
+        this->apply = [mat](const Vec<T> &_x, Vec<T> &_y) {
+            mat->Apply(_x, _y);
+        };
+        this->applytranspose = [mat](const Vec<T> &_x, Vec<T> &_y) {
+            mat->ApplyTranspose(_x, _y);
+        };
+        this->diagonal = [mat]() { return Vec<T>(mat->Diagonal()); };
+    }
+
+    /**
+     * @brief Refuse a temporary matrix, which would dangle once the
+     * expression ends
+     *
+     * @tparam M    Type providing Row, Col, Apply, ApplyTranspose and Diagonal
+     */
+    template <class M,
+              class = typename std::enable_if<
+                  !std::is_reference<M>::value &&
+                  !std::is_base_of<LinearOperator<T>,
+                                   typename std::decay<M>::type>::value>::type>
+    LinearOperator(M &&) = delete;
+
+    /**
+     * @brief Get number of row
+     *
+     * @return Index    Number of row
+     */
+    Index Row() const { return this->row; }
+
+    /**
+     * @brief Get number of column
+     *
+     * @return Index    Number of column
+     */
+    Index Col() const { return this->col; }
+
+    /**
+     * @brief Check whether the transpose can be applied
+     *
+     * @return true     ApplyTranspose is available
+     * @return false    ApplyTranspose is not available
+     */
+    bool HasTranspose() const { return bool(this->applytranspose); }
+
+    /**
+     * @brief Check whether the diagonal is known
+     *
+     * @return true     Diagonal is available
+     * @return false    Diagonal is not available
+     */
+    bool HasDiagonal() const { return bool(this->diagonal); }
+
+    /**
+     * @brief Set _y = A _x
+     *
+     * @param _x    Vector sized Col()
+     * @param _y    Vector sized Row()
+     */
+    void Apply(const Vec<T> &_x, Vec<T> &_y) const {
+        assert(_x.Size() == this->col && _y.Size() == this->row);
+        this->apply(_x, _y);
+    }
+
+    /**
+     * @brief Set _y = A^T _x
+     *
+     * @param _x    Vector sized Row()
+     * @param _y    Vector sized Col()
+     */
+    void ApplyTranspose(const Vec<T> &_x, Vec<T> &_y) const {
+        assert(this->HasTranspose());
+        assert(_x.Size() == this->row && _y.Size() == this->col);
+        this->applytranspose(_x, _y);
+    }
+
+    /**
+     * @brief Get diagonal elements
+     *
+     * @return const Vec<T> Vector of (i, i) elements
+     */
+    const Vec<T> Diagonal() const {
+        assert(this->HasDiagonal());
+        return this->diagonal();
+    }
+
+    /**
+     * @brief Get operator vector product
+     *
+     * @param _vec          Vector used operator vector product
+     * @return const Vec<T> Vector from operator vector product
+     */
+    const Vec<T> operator*(const Vec<T> &_vec) const {
+        Vec<T> retvec(this->row);
+        this->Apply(_vec, retvec);
+        return retvec;
+    }
+
+   private:
+    Index row, col;
+    Function apply, applytranspose;
+    std::function<Vec<T>()> diagonal;
+};
+}  // namespace PANSFE
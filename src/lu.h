@@ -0,0 +1,316 @@
+/**
+ * @file lu.h
+ * @author PANFACTORY (github/PANFACTORY)
+ * @brief Definition and implementation of LU factorization
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#pragma once
+#include <cassert>
+#include <cmath>
+#include <vector>
+
+#include "mat.h"
+#include "profiler.h"
+#include "triangular.h"
+#include "uplo.h"
+#include "vec.h"
+
+namespace PANSFE {
+template <class T>
+class TriangularView;
+
+/**
+ * @brief LU factorization with partial pivoting (PA = LU)
+ *
+ * @tparam T Type of element
+ */
+template <class T>
+class LU {
+   public:
+    /**
+     * @brief Construct a new LU object of empty matrix
+     *
+     */
+    LU() : sign(1), singular(false) {}
+
+    /**
+     * @brief Factorize _mat
+     *
+     * @param _mat  Square matrix
+     */
+    explicit LU(const Mat<T> &_mat) : lu(_mat), sign(1), singular(false) {
+        PANSFE_PROFILE_SCOPE(
+            "LU::LU", 2.0 / 3.0 * _mat.Row() * _mat.Row() * _mat.Row(),
+            sizeof(T) * double(_mat.Row()) * _mat.Row());
+        assert(_mat.Row() == _mat.Col());
+        Index n = this->lu.Row();
+        T *a = this->lu.Values();
+        this->pivot.resize(n);
+        for (Index k = 0; k < n; k++) {
+            Index p = k;
+            for (Index i = k + 1; i < n; i++) {
+                if (std::abs(a[n * i + k]) > std::abs(a[n * p + k])) {
+                    p = i;
+                }
+            }
+            this->pivot[k] = p;
+            if (p != k) {
+                for (Index j = 0; j < n; j++) {
+                    T tmp = a[n * k + j];
+                    a[n * k + j] = a[n * p + j];
+                    a[n * p + j] = tmp;
+                }
+                this->sign = -this->sign;
+            }
+            if (a[n * k + k] == T()) {
+                this->singular = true;
+                continue;
+            }
+            T inv = T(1) / a[n * k + k];
+            const T *rowk = &a[n * k];
+            for (Index i = k + 1; i < n; i++) {
+                T *rowi = &a[n * i];
+                T l = rowi[k] * inv;
+                rowi[k] = l;
+                for (Index j = k + 1; j < n; j++) {
+                    rowi[j] -= l * rowk[j];
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Get size of factorized matrix
+     *
+     * @return Index    Size of factorized matrix
+     */
+    Index Size() const { return this->lu.Row(); }
+
+    /**
+     * @brief Check singularity found during factorization
+     *
+     * @return true     Factorized matrix is singular
+     * @return false    Factorized matrix is not singular
+     */
+    bool IsSingular() const { return this->singular; }
+
+    /**
+     * @brief Get combined factor, strictly lower part is L and upper part is U
+     *
+     * @return const Mat<T>&    Combined factor
+     */
+    const Mat<T> &Factor() const { return this->lu; }
+
+    /**
+     * @brief Get row interchanges, row k was swapped with row Pivot()[k]
+     *
+     * @return const std::vector<Index>&   Row interchanges
+     */
+    const std::vector<Index> &Pivot() const { return this->pivot; }
+
+    /**
+     * @brief Solve A x = _b in place
+     *
+     * @param _x    Right hand side on input and solution on output
+     */
+    void SolveInPlace(Vec<T> &_x) const {
+        PANSFE_PROFILE_SCOPE("LU::Solve", 2.0 * this->Size() * this->Size(),
+                             sizeof(T) * double(this->Size()) * this->Size());
+        assert(_x.Size() == this->Size());
+        Index n = this->Size();
+        T *x = _x.Values();
+        for (Index k = 0; k < n; k++) {
+            if (this->pivot[k] != k) {
+                T tmp = x[k];
+                x[k] = x[this->pivot[k]];
+                x[this->pivot[k]] = tmp;
+            }
+        }
+        TriangularView<T>(this->lu, Uplo::Lower, Diag::Unit).SolveInPlace(_x);
+        TriangularView<T>(this->lu, Uplo::Upper).SolveInPlace(_x);
+    }
+
+    /**
+     * @brief Solve A X = _B in place for multiple right hand sides
+     *
+     * @param _x    Right hand sides on input and solutions on output
+     */
+    void SolveInPlace(Mat<T> &_x) const {
+        assert(_x.Row() == this->Size());
+        Index n = this->Size(), m = _x.Col();
+        T *x = _x.Values();
+        for (Index k = 0; k < n; k++) {
+            if (this->pivot[k] != k) {
+                T *xk = x + m * k, *xp = x + m * this->pivot[k];
+                for (Index j = 0; j < m; j++) {
+                    T tmp = xk[j];
+                    xk[j] = xp[j];
+                    xp[j] = tmp;
+                }
+            }
+        }
+        TriangularView<T>(this->lu, Uplo::Lower, Diag::Unit).SolveInPlace(_x);
+        TriangularView<T>(this->lu, Uplo::Upper).SolveInPlace(_x);
+    }
+
+    /**
+     * @brief Solve A^T x = _b in place
+     *
+     * @param _x    Right hand side on input and solution on output
+     */
+    void SolveTransposeInPlace(Vec<T> &_x) const {
+        PANSFE_PROFILE_SCOPE("LU::SolveTranspose",
+                             2.0 * this->Size() * this->Size(),
+                             sizeof(T) * double(this->Size()) * this->Size());
+        assert(_x.Size() == this->Size());
+        Index n = this->Size();
+        const T *a = this->lu.Values();
+        T *x = _x.Values();
+        for (Index i = 0; i < n; i++) {
+            const T *rowi = &a[n * i];
+            x[i] /= rowi[i];
+            T xi = x[i];
+            for (Index j = i + 1; j < n; j++) {
+                x[j] -= rowi[j] * xi;
+            }
+        }
+        for (Index i = n - 1; i >= 0; i--) {
+            const T *rowi = &a[n * i];
+            T xi = x[i];
+            for (Index j = 0; j < i; j++) {
+                x[j] -= rowi[j] * xi;
+            }
+        }
+        for (Index k = n - 1; k >= 0; k--) {
+            if (this->pivot[k] != k) {
+                T tmp = x[k];
+                x[k] = x[this->pivot[k]];
+                x[this->pivot[k]] = tmp;
+            }
+        }
+    }
+
+    /**
+     * @brief Solve A x = _b
+     *
+     * @param _b            Right hand side
+     * @return const Vec<T> Solution
+     */
+    const Vec<T> Solve(const Vec<T> &_b) const {
+        Vec<T> retvec = _b;
+        this->SolveInPlace(retvec);
+        return retvec;
+    }
+
+    /**
+     * @brief Solve A X = _B for multiple right hand sides
+     *
+     * @param _b            Right hand sides
+     * @return const Mat<T> Solutions
+     */
+    const Mat<T> Solve(const Mat<T> &_b) const {
+        Mat<T> retmat = _b;
+        this->SolveInPlace(retmat);
+        return retmat;
+    }
+
+    /**
+     * @brief Update factors to those of A + _u _v^T in O(n^2) by Bennett's
+     * algorithm, a downdate is an update with negated _u
+     *
+     * The pivot order is kept, so accuracy degrades if the updated matrix
+     * needs different pivoting and refactorizing is then advised.
+     *
+     * @param _u    Column vector of rank one update
+     * @param _v    Row vector of rank one update
+     */
+    void Update(const Vec<T> &_u, const Vec<T> &_v) {
+        PANSFE_PROFILE_SCOPE("LU::Update", 4.0 * this->Size() * this->Size(),
+                             sizeof(T) * double(this->Size()) * this->Size());
+        Index n = this->Size();
+        assert(_u.Size() == n && _v.Size() == n);
+        Vec<T> xvec = _u, yvec = _v;
+        T *x = xvec.Values(), *y = yvec.Values(), *a = this->lu.Values();
+        for (Index k = 0; k < n; k++) {
+            if (this->pivot[k] != k) {
+                T tmp = x[k];
+                x[k] = x[this->pivot[k]];
+                x[this->pivot[k]] = tmp;
+            }
+        }
+        this->singular = false;
+        for (Index i = 0; i < n; i++) {
+            T *rowi = &a[n * i];
+            rowi[i] += x[i] * y[i];
+            if (rowi[i] == T()) {
+                this->singular = true;
+                continue;
+            }
+            y[i] /= rowi[i];
+            for (Index j = i + 1; j < n; j++) {
+                T &lji = a[n * j + i];
+                rowi[j] += x[i] * y[j];
+                x[j] -= x[i] * lji;
+                lji += y[i] * x[j];
+                y[j] -= y[i] * rowi[j];
+            }
+        }
+    }
+
+    /**
+     * @brief Update factors to those of A + _u _v^T in O(n^2 k)
+     *
+     * @param _u    n x k matrix of rank k update
+     * @param _v    n x k matrix of rank k update
+     */
+    void Update(const Mat<T> &_u, const Mat<T> &_v) {
+        Index n = this->Size();
+        assert(_u.Row() == n && _v.Row() == n && _u.Col() == _v.Col());
+        Vec<T> u(n), v(n);
+        for (Index j = 0; j < _u.Col(); j++) {
+            for (Index i = 0; i < n; i++) {
+                u[i] = _u[i][j];
+                v[i] = _v[i][j];
+            }
+            this->Update(u, v);
+        }
+    }
+
+    /**
+     * @brief Get determinant of factorized matrix
+     *
+     * @return T    Determinant
+     */
+    T Determinant() const {
+        Index n = this->Size();
+        const T *a = this->lu.Values();
+        T retvalue = T(this->sign);
+        for (Index i = 0; i < n; i++) {
+            retvalue *= a[n * i + i];
+        }
+        return retvalue;
+    }
+
+    /**
+     * @brief Get inverse of factorized matrix
+     *
+     * @return const Mat<T> Inverse matrix
+     */
+    const Mat<T> Inverse() const {
+        Mat<T> retmat = Mat<T>::Identity(this->Size());
+        this->SolveInPlace(retmat);
+        return retmat;
+    }
+
+   private:
+    Mat<T> lu;
+    std::vector<Index> pivot;
+    int sign;
+    bool singular;
+};
+}  // namespace PANSFE
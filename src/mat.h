@@ -10,18 +10,50 @@
  */
 
 #pragma once
+#include <algorithm>
 #include <cassert>
+#include <cmath>
 #include <iostream>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <type_traits>
 
+#include "index.h"
+#include "parallel.h"
+#include "profiler.h"
+#include "strassen.h"
 #include "vec.h"
 
 namespace PANSFE {
 template <class T>
 class Vec;
+template <class T>
+class Mat;
+template <class T>
+class LU;
+template <class T>
+class Cholesky;
+inline int GetStrassenCutoff();
+template <class T>
+inline const Mat<T> StrassenMultiply(const Mat<T> &_a, const Mat<T> &_b,
+                                     int _cutoff);
 
 /**
  * @brief Linear algebraic matrix class
  *
+ * With SetFactorizationCache, a factorization is computed on the first
+ * Determinant, Inverse, Solve or Condition and reused until the matrix is
+ * mutated. Const members may be called from several threads at once, the
+ * cached factorization being published atomically, while a mutating member
+ * must not run concurrently with any other access to the same matrix. With
+ * SetCopyOnWrite, copies share the buffer until one of them is mutated.
+ * Element access through operator[] and operator() is a plain load or
+ * store, so call BeginWrite once before writing elements of a matrix that
+ * may share its buffer or keep a factorization; Values() and the other
+ * mutating members do so themselves. Pointers kept from operator[] or
+ * Values() must not be written after a later query or copy.
+ *
  * @tparam T Type of element
  */
 template <class T>
@@ -33,6 +65,8 @@ class Mat {
 
     template <class U>
     friend class Vec;
+    template <class U>
+    friend class Mat;
 
    public:
     /**
@@ -42,7 +76,10 @@ class Mat {
     Mat() {
         this->row = 0;
         this->col = 0;
+        this->capacity = 0;
         this->values = nullptr;
+        this->caching = false;
+        this->cow = false;
     }
 
     /**
@@ -53,12 +90,17 @@ class Mat {
      * @param _col      Column of the Mat object
      * @param _value    Each element value of Mat object
      */
-    Mat(int _row, int _col, T _value = T()) {
+    Mat(Index _row, Index _col, T _value = T()) {
+        PANSFE_PROFILE_SCOPE("Mat::Mat", 0, sizeof(T) * double(_row) * _col);
         this->row = _row;
         this->col = _col;
+        this->capacity = _row * _col;
+        this->caching = false;
+        this->cow = false;
         if (this->row * this->col > 0) {
             this->values = new T[this->row * this->col];
-            for (int i = 0; i < this->row * this->col; i++) {
+            PANSFE_PROFILE_ALLOC(sizeof(T) * this->row * this->col);
+            for (Index i = 0; i < this->row * this->col; i++) {
                 this->values[i] = _value;
             }
         } else {
@@ -66,20 +108,46 @@ class Mat {
         }
     }
 
+    /**
+     * @brief Construct a new Mat object whose row and col are _row and _col
+     * without initializing elements
+     *
+     * @param _row      Row of the Mat object
+     * @param _col      Column of the Mat object
+     */
+    Mat(Index _row, Index _col, Uninitialized) {
+        this->row = _row;
+        this->col = _col;
+        this->capacity = _row * _col;
+        this->caching = false;
+        this->cow = false;
+        if (this->row * this->col > 0) {
+            this->values = new T[this->row * this->col];
+            PANSFE_PROFILE_ALLOC(sizeof(T) * this->row * this->col);
+        } else {
+            this->values = nullptr;
+        }
+    }
+
     /**
      * @brief Construct a new Mat object
      *
      * @param _values   Format like {{1, 2, 3}, {4, 5, 6}}
      */
     Mat(const std::initializer_list<std::initializer_list<T> > &_values) {
+        PANSFE_PROFILE_SCOPE("Mat::Mat", 0, 0);
         this->row = _values.size();
+        this->caching = false;
+        this->cow = false;
         if (this->row > 0) {
             this->col = _values.begin()->size();
+            this->capacity = this->row * this->col;
             if (this->row * this->col) {
                 this->values = new T[this->row * this->col];
-                int index = 0;
+                PANSFE_PROFILE_ALLOC(sizeof(T) * this->row * this->col);
+                Index index = 0;
                 for (auto valuei : _values) {
-                    assert(this->col == valuei.size());
+                    assert(this->col == Index(valuei.size()));
                     for (auto valueij : valuei) {
                         this->values[index] = valueij;
                         index++;
@@ -90,21 +158,34 @@ class Mat {
             }
         } else {
             this->col = 0;
+            this->capacity = 0;
             this->values = nullptr;
         }
     }
 
     /**
-     * @brief Copy constructor (deep copy)
+     * @brief Copy constructor (deep copy, or sharing the buffer when _mat is
+     * copy-on-write)
      *
      * @param _mat  Copy source
      */
     Mat(const Mat<T> &_mat) {
+        PANSFE_PROFILE_SCOPE("Mat::Mat", 0,
+                             2 * sizeof(T) * double(_mat.row) * _mat.col);
         this->row = _mat.row;
         this->col = _mat.col;
+        this->capacity = _mat.row * _mat.col;
+        this->caching = _mat.caching;
+        this->factorization = std::atomic_load(&_mat.factorization);
+        this->cow = _mat.cow;
+        if (_mat.cow && _mat.shared) {
+            this->Share(_mat);
+            return;
+        }
         if (this->row * this->col > 0) {
             this->values = new T[this->row * this->col];
-            for (int i = 0; i < this->row * this->col; i++) {
+            PANSFE_PROFILE_ALLOC(sizeof(T) * this->row * this->col);
+            for (Index i = 0; i < this->row * this->col; i++) {
                 this->values[i] = _mat.values[i];
             }
         } else {
@@ -113,28 +194,170 @@ class Mat {
     }
 
     /**
-     * @brief Destroy the Mat object
+     * @brief Construct a new Mat object converting each element of _mat
      *
+     * @tparam U    Element type of the source matrix
+     * @param _mat  Conversion source
      */
-    ~Mat() {
-        if (this->values) {
-            delete[] this->values;
+    template <class U>
+    explicit Mat(const Mat<U> &_mat) {
+        PANSFE_PROFILE_SCOPE(
+            "Mat::Mat", double(_mat.row) * _mat.col,
+            (sizeof(T) + sizeof(U)) * double(_mat.row) * _mat.col);
+        this->row = _mat.row;
+        this->col = _mat.col;
+        this->capacity = _mat.row * _mat.col;
+        this->caching = false;
+        this->cow = false;
+        if (this->row * this->col > 0) {
+            this->values = new T[this->row * this->col];
+            PANSFE_PROFILE_ALLOC(sizeof(T) * this->row * this->col);
+            const U *source = _mat.values;
+            T *destination = this->values;
+            for (Index i = 0; i < this->row * this->col; i++) {
+                destination[i] = static_cast<T>(source[i]);
+            }
+        } else {
+            this->values = nullptr;
         }
     }
 
+    /**
+     * @brief Destroy the Mat object
+     *
+     */
+    ~Mat() { this->Release(); }
+
     /**
      * @brief Get number of row
      *
-     * @return int  Number of row
+     * @return Index  Number of row
      */
-    int Row() const { return this->row; }
+    Index Row() const { return this->row; }
 
     /**
      * @brief Get number of column
      *
-     * @return int  Number of column
+     * @return Index  Number of column
      */
-    int Col() const { return this->col; }
+    Index Col() const { return this->col; }
+
+    /**
+     * @brief Get number of elements storable without reallocation
+     *
+     * @return Index    Number of elements storable without reallocation
+     */
+    Index Capacity() const { return this->capacity; }
+
+    /**
+     * @brief Share buffer among copies until one of them is mutated
+     *
+     * The reference count is thread-safe, so copies may be read and detached
+     * from different threads.
+     *
+     * @param _cow  Whether copies share the buffer
+     */
+    void SetCopyOnWrite(bool _cow) {
+        this->Detach();
+        this->cow = _cow;
+        if (this->cow && this->values && !this->shared) {
+            this->shared.reset(this->values, std::default_delete<T[]>());
+        }
+    }
+
+    /**
+     * @brief Check whether the buffer is shared with another copy
+     *
+     * @return true     Buffer is shared
+     * @return false    Buffer is owned exclusively
+     */
+    bool IsShared() const {
+        return this->shared && this->shared.use_count() > 1;
+    }
+
+    /**
+     * @brief Ensure storage for _capacity elements keeping element values
+     *
+     * @param _capacity Number of elements storable without reallocation
+     */
+    void Reserve(Index _capacity) {
+        if (_capacity <= this->capacity) {
+            return;
+        }
+        PANSFE_PROFILE_SCOPE("Mat::Reserve", 0,
+                             2 * sizeof(T) * double(this->row) * this->col);
+        T *values = this->values;
+        std::shared_ptr<T> shared = this->shared;
+        this->Allocate(_capacity);
+        for (Index i = 0; i < this->row * this->col; i++) {
+            this->values[i] = values[i];
+        }
+        if (values && !shared) {
+            delete[] values;
+        }
+    }
+
+    /**
+     * @brief Change row and column keeping (i, j) element values inside both
+     * shapes, added elements are _value and storage is reallocated only when
+     * capacity is exceeded
+     *
+     * @param _row      New row
+     * @param _col      New column
+     * @param _value    Value of added elements
+     */
+    void Resize(Index _row, Index _col, T _value = T()) {
+        Index row = this->row, col = this->col;
+        this->Resize(_row, _col, Uninitialized());
+        for (Index i = 0; i < this->row; i++) {
+            for (Index j = i < row ? col : 0; j < this->col; j++) {
+                this->values[this->col * i + j] = _value;
+            }
+        }
+    }
+
+    /**
+     * @brief Change row and column keeping (i, j) element values inside both
+     * shapes, added elements are not initialized and storage is reallocated
+     * only when capacity is exceeded
+     *
+     * @param _row      New row
+     * @param _col      New column
+     */
+    void Resize(Index _row, Index _col, Uninitialized) {
+        assert(0 <= _row && 0 <= _col);
+        this->Invalidate();
+        Index row = std::min(this->row, _row), col = std::min(this->col, _col);
+        if (_row * _col > this->capacity) {
+            T *values = this->values;
+            std::shared_ptr<T> shared = this->shared;
+            this->Allocate(_row * _col);
+            for (Index i = 0; i < row; i++) {
+                for (Index j = 0; j < col; j++) {
+                    this->values[_col * i + j] = values[this->col * i + j];
+                }
+            }
+            if (values && !shared) {
+                delete[] values;
+            }
+        } else if (_col < this->col) {
+            for (Index i = 1; i < row; i++) {
+                for (Index j = 0; j < col; j++) {
+                    this->values[_col * i + j] =
+                        this->values[this->col * i + j];
+                }
+            }
+        } else if (_col > this->col) {
+            for (Index i = row - 1; i > 0; i--) {
+                for (Index j = col - 1; j >= 0; j--) {
+                    this->values[_col * i + j] =
+                        this->values[this->col * i + j];
+                }
+            }
+        }
+        this->row = _row;
+        this->col = _col;
+    }
 
     /**
      * @brief Get _i th element pointer without validation
@@ -142,7 +365,17 @@ class Mat {
      * @param _i    Index of element
      * @return T*   Pointer of _i th element
      */
-    T *operator[](int _i) { return &this->values[this->col * _i]; }
+    T *operator[](Index _i) { return &this->values[this->col * _i]; }
+
+    /**
+     * @brief Get _i th element pointer without validation
+     *
+     * @param _i        Index of element
+     * @return const T* Pointer of _i th element
+     */
+    const T *operator[](Index _i) const {
+        return &this->values[this->col * _i];
+    }
 
     /**
      * @brief Get (_i, _j) element value with validation
@@ -151,17 +384,34 @@ class Mat {
      * @param _j    Index of column
      * @return T&   Reference of (_i, _j) element value
      */
-    T &operator()(int _i, int _j) {
+    T &operator()(Index _i, Index _j) {
         assert(0 <= _i && _i < this->row && 0 <= _j && _j < this->col);
         return this->values[this->col * _i + _j];
     }
 
+    /**
+     * @brief Detach shared buffer and drop cached factorization before
+     * writing elements through operator[] or operator()
+     *
+     */
+    void BeginWrite() { this->Invalidate(); }
+
     /**
      * @brief Get pointer indicating value
      *
      * @return T*   Pointer indicating value
      */
-    T *Values() { return values; }
+    T *Values() {
+        this->Invalidate();
+        return values;
+    }
+
+    /**
+     * @brief Get pointer indicating value
+     *
+     * @return const T* Pointer indicating value
+     */
+    const T *Values() const { return values; }
 
     /**
      * @brief Check the same
@@ -174,7 +424,7 @@ class Mat {
         if (this->row != _mat.row || this->col != _mat.col) {
             return false;
         }
-        for (int i = 0; i < this->row * this->col; ++i) {
+        for (Index i = 0; i < this->row * this->col; ++i) {
             if (this->values[i] != _mat.values[i]) {
                 return false;
             }
@@ -198,14 +448,30 @@ class Mat {
      * @return Mat<T>&  Reference of this object
      */
     Mat<T> &operator=(const Mat<T> &_mat) {
+        PANSFE_PROFILE_SCOPE("Mat::operator=", 0,
+                             2 * sizeof(T) * double(_mat.row) * _mat.col);
         if (this != &_mat) {
-            if (this->values) {
-                delete[] this->values;
+            if (_mat.cow && _mat.shared) {
+                this->Release();
+                this->row = _mat.row;
+                this->col = _mat.col;
+                this->cow = true;
+                this->factorization =
+                    this->caching ? std::atomic_load(&_mat.factorization)
+                                  : nullptr;
+                this->Share(_mat);
+                return *this;
+            }
+            if (this->capacity < _mat.row * _mat.col || this->IsShared()) {
+                this->Release();
+                this->Allocate(_mat.row * _mat.col);
             }
             this->row = _mat.row;
             this->col = _mat.col;
-            this->values = new T[this->row * this->col];
-            for (int i = 0; i < this->row * this->col; i++) {
+            this->factorization =
+                this->caching ? std::atomic_load(&_mat.factorization)
+                              : nullptr;
+            for (Index i = 0; i < this->row * this->col; i++) {
                 this->values[i] = _mat.values[i];
             }
         }
@@ -219,8 +485,11 @@ class Mat {
      * @return Mat<T>&  Reference of this object
      */
     Mat<T> &operator+=(const Mat<T> &_mat) {
+        PANSFE_PROFILE_SCOPE("Mat::operator+=", double(this->row) * this->col,
+                             3 * sizeof(T) * double(this->row) * this->col);
         assert(this->row == _mat.row && this->col == _mat.col);
-        for (int i = 0; i < this->row * this->col; i++) {
+        this->Invalidate();
+        for (Index i = 0; i < this->row * this->col; i++) {
             this->values[i] += _mat.values[i];
         }
         return *this;
@@ -233,8 +502,11 @@ class Mat {
      * @return Mat<T>&  Reference of this object
      */
     Mat<T> &operator-=(const Mat<T> &_mat) {
+        PANSFE_PROFILE_SCOPE("Mat::operator-=", double(this->row) * this->col,
+                             3 * sizeof(T) * double(this->row) * this->col);
         assert(this->row == _mat.row && this->col == _mat.col);
-        for (int i = 0; i < this->row * this->col; i++) {
+        this->Invalidate();
+        for (Index i = 0; i < this->row * this->col; i++) {
             this->values[i] -= _mat.values[i];
         }
         return *this;
@@ -247,7 +519,11 @@ class Mat {
      * @return Mat<T>&  Reference of this object
      */
     Mat<T> &operator*=(T _a) {
-        for (int i = 0; i < this->row * this->col; i++) {
+        PANSFE_PROFILE_SCOPE("Mat::operator*=(T)",
+                             double(this->row) * this->col,
+                             2 * sizeof(T) * double(this->row) * this->col);
+        this->Invalidate();
+        for (Index i = 0; i < this->row * this->col; i++) {
             this->values[i] *= _a;
         }
         return *this;
@@ -256,22 +532,15 @@ class Mat {
     /**
      * @brief Compound assignment operator for matrix matrix production
      *
+     * Uses Strassen-Winograd product when enabled by SetStrassenCutoff and
+     * every dimension exceeds the cutoff.
+     *
      * @param _mat      Multiplying matrix
      * @return Mat<T>&  Reference of this object
      */
     Mat<T> &operator*=(const Mat<T> &_mat) {
-        assert(this->col == _mat.row);
-        Mat<T> retmat(this->row, _mat.col);
-        for (int i = 0; i < retmat.row; i++) {
-            for (int j = 0; j < retmat.col; j++) {
-                for (int k = 0; k < this->col; k++) {
-                    retmat.values[retmat.col * i + j] +=
-                        this->values[this->col * i + k] *
-                        _mat.values[_mat.col * k + j];
-                }
-            }
-        }
-        *this = retmat;
+        PANSFE_PROFILE_SCOPE("Mat::operator*=(Mat)", 0, 0);
+        *this = *this * _mat;
         return *this;
     }
 
@@ -282,7 +551,10 @@ class Mat {
      * @return Mat<T>&  Reference of this object
      */
     Mat<T> &operator/=(T _a) {
-        for (int i = 0; i < this->row * this->col; i++) {
+        PANSFE_PROFILE_SCOPE("Mat::operator/=", double(this->row) * this->col,
+                             2 * sizeof(T) * double(this->row) * this->col);
+        this->Invalidate();
+        for (Index i = 0; i < this->row * this->col; i++) {
             this->values[i] /= _a;
         }
         return *this;
@@ -295,8 +567,13 @@ class Mat {
      * @return const Mat<T> Added matrix
      */
     const Mat<T> operator+(const Mat<T> &_mat) const {
-        Mat<T> retmat = *this;
-        retmat += _mat;
+        PANSFE_PROFILE_SCOPE("Mat::operator+", double(this->row) * this->col,
+                             3 * sizeof(T) * double(this->row) * this->col);
+        assert(this->row == _mat.row && this->col == _mat.col);
+        Mat<T> retmat(this->row, this->col, Uninitialized());
+        for (Index i = 0; i < this->row * this->col; i++) {
+            retmat.values[i] = this->values[i] + _mat.values[i];
+        }
         return retmat;
     }
 
@@ -307,8 +584,14 @@ class Mat {
      * @return const Mat<T> Subtracted matrix
      */
     const Mat<T> operator-(const Mat<T> &_mat) const {
-        Mat<T> retmat = *this;
-        retmat -= _mat;
+        PANSFE_PROFILE_SCOPE("Mat::operator-(Mat)",
+                             double(this->row) * this->col,
+                             3 * sizeof(T) * double(this->row) * this->col);
+        assert(this->row == _mat.row && this->col == _mat.col);
+        Mat<T> retmat(this->row, this->col, Uninitialized());
+        for (Index i = 0; i < this->row * this->col; i++) {
+            retmat.values[i] = this->values[i] - _mat.values[i];
+        }
         return retmat;
     }
 
@@ -318,7 +601,13 @@ class Mat {
      * @return const Mat<T> Sign reversed matrix
      */
     const Mat<T> operator-() const {
-        return Mat<T>(this->row, this->col) - *this;
+        PANSFE_PROFILE_SCOPE("Mat::operator-()", double(this->row) * this->col,
+                             2 * sizeof(T) * double(this->row) * this->col);
+        Mat<T> retmat(this->row, this->col, Uninitialized());
+        for (Index i = 0; i < this->row * this->col; i++) {
+            retmat.values[i] = -this->values[i];
+        }
+        return retmat;
     }
 
     /**
@@ -328,8 +617,12 @@ class Mat {
      * @return const Mat<T> Multipled matrix
      */
     const Mat<T> operator*(T _a) const {
-        Mat<T> retmat = *this;
-        retmat *= _a;
+        PANSFE_PROFILE_SCOPE("Mat::operator*(T)", double(this->row) * this->col,
+                             2 * sizeof(T) * double(this->row) * this->col);
+        Mat<T> retmat(this->row, this->col, Uninitialized());
+        for (Index i = 0; i < this->row * this->col; i++) {
+            retmat.values[i] = this->values[i] * _a;
+        }
         return retmat;
     }
 
@@ -340,9 +633,21 @@ class Mat {
      * @return const Mat<T> Matrix from matrix matrix product
      */
     const Mat<T> operator*(const Mat<T> &_mat) const {
-        Mat<T> retmat = *this;
-        retmat *= _mat;
-        return retmat;
+        int cutoff = GetStrassenCutoff();
+        bool strassen = cutoff > 0 && this->row > cutoff &&
+                        this->col > cutoff && _mat.col > cutoff;
+        PANSFE_PROFILE_SCOPE(
+            "Mat::operator*(Mat)",
+            strassen ? 0 : 2 * double(this->row) * _mat.col * this->col,
+            strassen ? 0
+                     : sizeof(T) * (double(this->row) * this->col +
+                                    double(_mat.row) * _mat.col +
+                                    double(this->row) * _mat.col));
+        assert(this->col == _mat.row);
+        if (strassen) {
+            return StrassenMultiply(*this, _mat, cutoff);
+        }
+        return this->Multiply(_mat);
     }
 
     /**
@@ -352,10 +657,14 @@ class Mat {
      * @return const Vec<T> Vector from matrix vector product
      */
     const Vec<T> operator*(const Vec<T> &_vec) const {
+        PANSFE_PROFILE_SCOPE(
+            "Mat::operator*(Vec)", 2 * double(this->row) * this->col,
+            sizeof(T) *
+                (double(this->row) * this->col + this->row + this->col));
         assert(this->col == _vec.size);
         Vec<T> retvec(this->row);
-        for (int i = 0; i < this->row; i++) {
-            for (int j = 0; j < this->col; j++) {
+        for (Index i = 0; i < this->row; i++) {
+            for (Index j = 0; j < this->col; j++) {
                 retvec.values[i] +=
                     this->values[this->col * i + j] * _vec.values[j];
             }
@@ -363,6 +672,79 @@ class Mat {
         return retvec;
     }
 
+    /**
+     * @brief Set _y = A _x without allocation, rows in parallel
+     *
+     * @param _x    Vector used matrix vector product
+     * @param _y    Vector from matrix vector product, sized Row()
+     */
+    void Apply(const Vec<T> &_x, Vec<T> &_y) const {
+        PANSFE_PROFILE_SCOPE(
+            "Mat::Apply", 2 * double(this->row) * this->col,
+            sizeof(T) *
+                (double(this->row) * this->col + this->row + this->col));
+        assert(this->col == _x.size && this->row == _y.size);
+        const T *x = _x.values;
+        T *y = _y.Values();
+        ParallelFor(
+            0, this->row,
+            [&](Index _i) {
+                const T *ai = &this->values[this->col * _i];
+                T sum = T();
+                for (Index j = 0; j < this->col; j++) {
+                    sum += ai[j] * x[j];
+                }
+                y[_i] = sum;
+            },
+            64);
+    }
+
+    /**
+     * @brief Set _y = A^T _x without allocation, column panels in parallel
+     * so that every row is read contiguously
+     *
+     * @param _x    Vector used matrix vector product, sized Row()
+     * @param _y    Vector from matrix vector product, sized Col()
+     */
+    void ApplyTranspose(const Vec<T> &_x, Vec<T> &_y) const {
+        PANSFE_PROFILE_SCOPE(
+            "Mat::ApplyTranspose", 2 * double(this->row) * this->col,
+            sizeof(T) *
+                (double(this->row) * this->col + this->row + this->col));
+        assert(this->row == _x.size && this->col == _y.size);
+        const T *x = _x.values;
+        T *y = _y.Values();
+        const Index panel = 256;
+        ParallelFor(0, (this->col + panel - 1) / panel, [&](Index _p) {
+            Index head = _p * panel,
+                tail = head + panel < this->col ? head + panel : this->col;
+            for (Index j = head; j < tail; j++) {
+                y[j] = T();
+            }
+            for (Index i = 0; i < this->row; i++) {
+                const T *ai = &this->values[this->col * i];
+                T xi = x[i];
+                for (Index j = head; j < tail; j++) {
+                    y[j] += ai[j] * xi;
+                }
+            }
+        });
+    }
+
+    /**
+     * @brief Get diagonal elements
+     *
+     * @return const Vec<T> Vector of (i, i) elements
+     */
+    const Vec<T> Diagonal() const {
+        Index n = this->row < this->col ? this->row : this->col;
+        Vec<T> retvec(n, Uninitialized());
+        for (Index i = 0; i < n; i++) {
+            retvec.values[i] = this->values[this->col * i + i];
+        }
+        return retvec;
+    }
+
     /**
      * @brief Get dividev matrix
      *
@@ -370,8 +752,12 @@ class Mat {
      * @return const Mat<T> Devided matrix
      */
     const Mat<T> operator/(T _a) const {
-        Mat<T> retmat = *this;
-        retmat /= _a;
+        PANSFE_PROFILE_SCOPE("Mat::operator/", double(this->row) * this->col,
+                             2 * sizeof(T) * double(this->row) * this->col);
+        Mat<T> retmat(this->row, this->col, Uninitialized());
+        for (Index i = 0; i < this->row * this->col; i++) {
+            retmat.values[i] = this->values[i] / _a;
+        }
         return retmat;
     }
 
@@ -381,9 +767,10 @@ class Mat {
      * @return Vec<T>   Vec object converted from this object
      */
     operator Vec<T>() const {
+        PANSFE_PROFILE_SCOPE("Mat::operator Vec", 0, 2 * sizeof(T) * this->row);
         assert(this->col == 1);
-        Vec<T> retvec(this->row);
-        for (int i = 0; i < retvec.size; i++) {
+        Vec<T> retvec(this->row, Uninitialized());
+        for (Index i = 0; i < retvec.size; i++) {
             retvec.values[i] = this->values[i];
         }
         return retvec;
@@ -405,9 +792,11 @@ class Mat {
      * @return const Mat<T> Transposed matrix
      */
     const Mat<T> Transpose() const {
-        Mat<T> retmat(this->col, this->row);
-        for (int i = 0; i < retmat.row; i++) {
-            for (int j = 0; j < retmat.col; j++) {
+        PANSFE_PROFILE_SCOPE("Mat::Transpose", 0,
+                             2 * sizeof(T) * double(this->row) * this->col);
+        Mat<T> retmat(this->col, this->row, Uninitialized());
+        for (Index i = 0; i < retmat.row; i++) {
+            for (Index j = 0; j < retmat.col; j++) {
                 retmat.values[retmat.col * i + j] =
                     this->values[this->col * j + i];
             }
@@ -418,10 +807,29 @@ class Mat {
     /**
      * @brief Get determinant of this matrix
      *
+     * With caching enabled the O(n^3) factorization is recorded by LU or
+     * Cholesky and only the product of the pivots by this operation, and the
+     * cofactor expansion records each minor determinant separately.
+     *
      * @return T    Determinant of this matrix
      */
     T Determinant() const {
+        PANSFE_PROFILE_SCOPE(
+            "Mat::Determinant",
+            this->caching    ? double(this->row)
+            : 3 < this->row  ? 3.0 * this->row
+            : this->row == 3 ? 17
+            : this->row == 2 ? 3
+                             : 0,
+            this->caching || 3 < this->row
+                ? sizeof(T) * double(this->row)
+                : sizeof(T) * double(this->row) * this->col);
         assert(this->row == this->col && 0 < this->row);
+        if (this->caching) {
+            std::shared_ptr<const Factorization> f = this->Factorize();
+            return f->cholesky ? f->cholesky->Determinant()
+                               : f->lu->Determinant();
+        }
         if (this->row == 1) {
             return this->values[0];
         } else if (this->row == 2) {
@@ -436,7 +844,7 @@ class Mat {
                    this->values[0] * this->values[4] * this->values[8];
         } else {
             T retvalue = T();
-            for (int i = 0; i < this->row; i++) {
+            for (Index i = 0; i < this->row; i++) {
                 retvalue += pow(-1.0, i) * this->values[this->col * i] *
                             this->Cofactor(i, 0).Determinant();
             }
@@ -450,14 +858,21 @@ class Mat {
      * @return const Mat<T> Inverse matrix
      */
     const Mat<T> Inverse() const {
+        PANSFE_PROFILE_SCOPE(
+            "Mat::Inverse", this->caching ? 0 : double(this->row) * this->col,
+            this->caching ? 0 : sizeof(T) * double(this->row) * this->col);
         assert(this->row == this->col);
+        if (this->caching) {
+            std::shared_ptr<const Factorization> f = this->Factorize();
+            return f->cholesky ? f->cholesky->Inverse() : f->lu->Inverse();
+        }
         Mat<T> retmat(this->row, this->col);
         if (this->row == 1) {
             retmat.values[0] = 1 / this->values[0];
             return retmat;
         } else {
-            for (int i = 0; i < this->row; i++) {
-                for (int j = 0; j < this->col; j++) {
+            for (Index i = 0; i < this->row; i++) {
+                for (Index j = 0; j < this->col; j++) {
                     retmat.values[retmat.col * i + j] =
                         pow(-1.0, i + j) * this->Cofactor(j, i).Determinant();
                 }
@@ -466,6 +881,101 @@ class Mat {
         }
     }
 
+    /**
+     * @brief Keep factorization computed by Determinant, Inverse, Solve and
+     * Condition until this matrix is mutated
+     *
+     * Cholesky factorization is used for symmetric positive definite matrix
+     * and LU factorization with partial pivoting otherwise, so the element
+     * type must be floating point.
+     *
+     * @param _caching  Whether to keep factorization
+     */
+    void SetFactorizationCache(bool _caching) {
+        static_assert(std::is_floating_point<T>::value,
+                      "factorization needs floating point elements");
+        this->caching = _caching;
+        this->Invalidate();
+    }
+
+    /**
+     * @brief Check whether a factorization is kept
+     *
+     * @return true     Factorization is kept
+     * @return false    Factorization is not kept
+     */
+    bool HasFactorization() const {
+        return bool(std::atomic_load(&this->factorization));
+    }
+
+    /**
+     * @brief Solve A x = _b
+     *
+     * @param _b            Right hand side
+     * @return const Vec<T> Solution
+     */
+    const Vec<T> Solve(const Vec<T> &_b) const {
+        static_assert(std::is_floating_point<T>::value,
+                      "factorization needs floating point elements");
+        assert(this->row == this->col && _b.size == this->row);
+        std::shared_ptr<const Factorization> f = this->Factorize();
+        Vec<T> retvec = _b;
+        if (f->cholesky) {
+            f->cholesky->SolveInPlace(retvec);
+        } else {
+            f->lu->SolveInPlace(retvec);
+        }
+        return retvec;
+    }
+
+    /**
+     * @brief Solve A X = _B for multiple right hand sides
+     *
+     * @param _b            Right hand sides
+     * @return const Mat<T> Solutions
+     */
+    const Mat<T> Solve(const Mat<T> &_b) const {
+        static_assert(std::is_floating_point<T>::value,
+                      "factorization needs floating point elements");
+        assert(this->row == this->col && _b.row == this->row);
+        std::shared_ptr<const Factorization> f = this->Factorize();
+        if (f->lu) {
+            return f->lu->Solve(_b);
+        }
+        Mat<T> retmat(_b.row, _b.col, Uninitialized());
+        Vec<T> x(_b.row, Uninitialized());
+        for (Index j = 0; j < _b.col; j++) {
+            for (Index i = 0; i < _b.row; i++) {
+                x.values[i] = _b.values[_b.col * i + j];
+            }
+            f->cholesky->SolveInPlace(x);
+            for (Index i = 0; i < _b.row; i++) {
+                retmat.values[retmat.col * i + j] = x.values[i];
+            }
+        }
+        return retmat;
+    }
+
+    /**
+     * @brief Get estimate of condition number in 1-norm by Hager's method,
+     * which needs only a few solves with the factorization
+     *
+     * The estimate is computed on the first call and kept with a cached
+     * factorization.
+     *
+     * @return T    Condition number, infinity for singular matrix
+     */
+    T Condition() const {
+        static_assert(std::is_floating_point<T>::value,
+                      "factorization needs floating point elements");
+        assert(this->row == this->col);
+        std::shared_ptr<const Factorization> f = this->Factorize();
+        std::call_once(f->estimated, [&]() {
+            f->condition = this->EstimateCondition(*f);
+        });
+        return f->condition;
+    }
+
     /**
      * @brief Get submatrix removed _i th row and _j th column
      *
@@ -473,11 +983,14 @@ class Mat {
      * @param _j            Index of column
      * @return const Mat<T> Submatrix
      */
-    const Mat<T> Cofactor(int _i, int _j) const {
+    const Mat<T> Cofactor(Index _i, Index _j) const {
+        PANSFE_PROFILE_SCOPE(
+            "Mat::Cofactor", 0,
+            2 * sizeof(T) * double(this->row - 1) * (this->col - 1));
         assert(0 <= _i && _i < this->row && 0 <= _j && _j < this->col);
-        Mat<T> retmat(this->row - 1, this->col - 1);
-        for (int i = 0; i < retmat.row; i++) {
-            for (int j = 0; j < retmat.col; j++) {
+        Mat<T> retmat(this->row - 1, this->col - 1, Uninitialized());
+        for (Index i = 0; i < retmat.row; i++) {
+            for (Index j = 0; j < retmat.col; j++) {
                 if (i < _i) {
                     if (j < _j) {
                         retmat.values[retmat.col * i + j] =
@@ -507,16 +1020,20 @@ class Mat {
      * @return const Mat<T> Stacked matrix
      */
     const Mat<T> Vstack(const Mat<T> &_mat) const {
+        PANSFE_PROFILE_SCOPE("Mat::Vstack", 0,
+                             2 * sizeof(T) *
+                                 (double(this->row) * this->col +
+                                  double(_mat.row) * _mat.col));
         assert(this->col == _mat.col);
-        Mat<T> retmat(this->row + _mat.row, this->col);
-        for (int i = 0; i < this->row; i++) {
-            for (int j = 0; j < this->col; j++) {
+        Mat<T> retmat(this->row + _mat.row, this->col, Uninitialized());
+        for (Index i = 0; i < this->row; i++) {
+            for (Index j = 0; j < this->col; j++) {
                 retmat.values[retmat.col * i + j] =
                     this->values[this->col * i + j];
             }
         }
-        for (int i = 0; i < _mat.row; i++) {
-            for (int j = 0; j < _mat.col; j++) {
+        for (Index i = 0; i < _mat.row; i++) {
+            for (Index j = 0; j < _mat.col; j++) {
                 retmat.values[retmat.col * (i + this->row) + j] =
                     _mat.values[_mat.col * i + j];
             }
@@ -531,16 +1048,20 @@ class Mat {
      * @return const Mat<T> Stacked matrix
      */
     const Mat<T> Hstack(const Mat<T> &_mat) const {
+        PANSFE_PROFILE_SCOPE("Mat::Hstack", 0,
+                             2 * sizeof(T) *
+                                 (double(this->row) * this->col +
+                                  double(_mat.row) * _mat.col));
         assert(this->row == _mat.row);
-        Mat<T> retmat(this->row, this->col + _mat.col);
-        for (int i = 0; i < this->row; i++) {
-            for (int j = 0; j < this->col; j++) {
+        Mat<T> retmat(this->row, this->col + _mat.col, Uninitialized());
+        for (Index i = 0; i < this->row; i++) {
+            for (Index j = 0; j < this->col; j++) {
                 retmat.values[retmat.col * i + j] =
                     this->values[this->col * i + j];
             }
         }
-        for (int i = 0; i < _mat.row; i++) {
-            for (int j = 0; j < _mat.col; j++) {
+        for (Index i = 0; i < _mat.row; i++) {
+            for (Index j = 0; j < _mat.col; j++) {
                 retmat.values[retmat.col * i + (j + this->col)] =
                     _mat.values[_mat.col * i + j];
             }
@@ -557,12 +1078,13 @@ class Mat {
      * @param _w            Width of submatrix
      * @return const Mat<T> Submatrix
      */
-    const Mat<T> Block(int _row, int _col, int _h, int _w) const {
+    const Mat<T> Block(Index _row, Index _col, Index _h, Index _w) const {
+        PANSFE_PROFILE_SCOPE("Mat::Block", 0, 2 * sizeof(T) * double(_h) * _w);
         assert(0 <= _row && 0 <= _col && 0 < _h && 0 < _w &&
                _row + _h <= this->row && _col + _w <= this->col);
-        Mat<T> retmat(_h, _w);
-        for (int i = 0; i < _h; i++) {
-            for (int j = 0; j < _w; j++) {
+        Mat<T> retmat(_h, _w, Uninitialized());
+        for (Index i = 0; i < _h; i++) {
+            for (Index j = 0; j < _w; j++) {
                 retmat.values[retmat.col * i + j] =
                     this->values[this->col * (_row + i) + (_col + j)];
             }
@@ -576,18 +1098,187 @@ class Mat {
      * @param _row      Matrix size
      * @return Mat<T>   Identity matrix
      */
-    static Mat<T> Identity(int _row) {
+    static Mat<T> Identity(Index _row) {
+        PANSFE_PROFILE_SCOPE("Mat::Identity", 0,
+                             sizeof(T) * double(_row) * _row);
         assert(0 < _row);
         Mat<T> retmat(_row, _row);
-        for (int i = 0; i < retmat.row; i++) {
+        for (Index i = 0; i < retmat.row; i++) {
             retmat.values[retmat.col * i + i] = 1;
         }
         return retmat;
     }
 
    private:
-    int row, col;
+    struct Factorization {
+        std::shared_ptr<const Cholesky<T> > cholesky;
+        std::shared_ptr<const LU<T> > lu;
+        mutable std::once_flag estimated;
+        mutable T condition;
+    };
+
+    Index row, col, capacity;
     T *values;
+    std::shared_ptr<T> shared;
+    bool caching, cow;
+    mutable std::shared_ptr<const Factorization> factorization;
+
+    void Invalidate() {
+        if (this->factorization) {
+            this->factorization.reset();
+        }
+        this->Detach();
+    }
+
+    void Allocate(Index _capacity) {
+        if (_capacity <= 0) {
+            this->values = nullptr;
+            this->capacity = 0;
+        } else {
+            this->values = new T[_capacity];
+            PANSFE_PROFILE_ALLOC(sizeof(T) * _capacity);
+            this->capacity = _capacity;
+        }
+        if (this->cow && this->values) {
+            this->shared.reset(this->values, std::default_delete<T[]>());
+        } else {
+            this->shared.reset();
+        }
+    }
+
+    void Release() {
+        if (this->shared) {
+            this->shared.reset();
+        } else if (this->values) {
+            delete[] this->values;
+        }
+    }
+
+    void Share(const Mat<T> &_mat) {
+        this->shared = _mat.shared;
+        this->values = this->shared.get();
+        this->capacity = _mat.capacity;
+    }
+
+    void Detach() {
+        if (this->shared && this->shared.use_count() > 1) {
+            PANSFE_PROFILE_SCOPE("Mat::Detach", 0,
+                                 2 * sizeof(T) * double(this->row) * this->col);
+            std::shared_ptr<T> shared = this->shared;
+            this->Allocate(this->capacity);
+            for (Index i = 0; i < this->row * this->col; i++) {
+                this->values[i] = shared.get()[i];
+            }
+        }
+    }
+
+    const Mat<T> Multiply(const Mat<T> &_mat) const {
+        Mat<T> retmat(this->row, _mat.col, Uninitialized());
+        for (Index i = 0; i < retmat.row; i++) {
+            T *ci = &retmat.values[retmat.col * i];
+            for (Index j = 0; j < retmat.col; j++) {
+                ci[j] = T();
+            }
+            for (Index k = 0; k < this->col; k++) {
+                T aik = this->values[this->col * i + k];
+                const T *bk = &_mat.values[_mat.col * k];
+                for (Index j = 0; j < retmat.col; j++) {
+                    ci[j] += aik * bk[j];
+                }
+            }
+        }
+        return retmat;
+    }
+
+    std::shared_ptr<const Factorization> Factorize() const {
+        std::shared_ptr<const Factorization> cached =
+            std::atomic_load(&this->factorization);
+        if (cached) {
+            return cached;
+        }
+        PANSFE_PROFILE_SCOPE("Mat::Factorize", 0, 0);
+        auto f = std::make_shared<Factorization>();
+        bool symmetric = true;
+        for (Index i = 0; i < this->row && symmetric; i++) {
+            for (Index j = 0; j < i; j++) {
+                if (this->values[this->col * i + j] !=
+                    this->values[this->col * j + i]) {
+                    symmetric = false;
+                    break;
+                }
+            }
+        }
+        if (symmetric) {
+            auto cholesky = std::make_shared<const Cholesky<T> >(*this);
+            if (cholesky->IsPositiveDefinite()) {
+                f->cholesky = cholesky;
+            }
+        }
+        if (!f->cholesky) {
+            f->lu = std::make_shared<const LU<T> >(*this);
+        }
+        if (this->caching) {
+            std::atomic_store(&this->factorization,
+                              std::shared_ptr<const Factorization>(f));
+        }
+        return f;
+    }
+
+    T EstimateCondition(const Factorization &_f) const {
+        Index n = this->row;
+        if (_f.lu && _f.lu->IsSingular()) {
+            return std::numeric_limits<T>::infinity();
+        }
+        T norm = T();
+        for (Index j = 0; j < n; j++) {
+            T sum = T();
+            for (Index i = 0; i < n; i++) {
+                sum += std::abs(this->values[this->col * i + j]);
+            }
+            norm = sum > norm ? sum : norm;
+        }
+        Vec<T> x(n, T(1) / T(n)), y(n), z(n);
+        T estimate = T();
+        for (Index k = 0; k < 5; k++) {
+            y = x;
+            if (_f.cholesky) {
+                _f.cholesky->SolveInPlace(y);
+            } else {
+                _f.lu->SolveInPlace(y);
+            }
+            T ynorm = T();
+            for (Index i = 0; i < n; i++) {
+                ynorm += std::abs(y.values[i]);
+            }
+            if (k > 0 && ynorm <= estimate) {
+                break;
+            }
+            estimate = ynorm;
+            for (Index i = 0; i < n; i++) {
+                z.values[i] = y.values[i] < T() ? T(-1) : T(1);
+            }
+            if (_f.cholesky) {
+                _f.cholesky->SolveInPlace(z);
+            } else {
+                _f.lu->SolveTransposeInPlace(z);
+            }
+            Index j = 0;
+            T zx = T();
+            for (Index i = 0; i < n; i++) {
+                zx += z.values[i] * x.values[i];
+                if (std::abs(z.values[i]) > std::abs(z.values[j])) {
+                    j = i;
+                }
+            }
+            if (std::abs(z.values[j]) <= zx) {
+                break;
+            }
+            for (Index i = 0; i < n; i++) {
+                x.values[i] = i == j ? T(1) : T();
+            }
+        }
+        return norm * estimate;
+    }
 };
 
 /**
@@ -600,11 +1291,11 @@ class Mat {
  */
 template <class U>
 inline std::ostream &operator<<(std::ostream &_out, const Mat<U> &_mat) {
-    for (int i = 0; i < _mat.row; i++) {
-        for (int j = 0; j < _mat.col; j++) {
+    for (Index i = 0; i < _mat.row; i++) {
+        for (Index j = 0; j < _mat.col; j++) {
             _out << _mat.values[_mat.col * i + j] << "\t";
         }
-        _out << std::endl;
+        _out << '\n';
     }
     return _out;
 }
@@ -622,3 +1313,6 @@ inline Mat<U> operator*(U _a, const Mat<U> &_mat) {
     return _mat * _a;
 }
 }  // namespace PANSFE
+
+#include "cholesky.h"
+#include "lu.h"
@@ -0,0 +1,138 @@
+/**
+ * @file mixedprecision.h
+ * @author PANFACTORY (github/PANFACTORY)
+ * @brief Definition and implementation of mixed precision solver
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#pragma once
+#include <cassert>
+#include <cmath>
+#include <limits>
+
+#include "lu.h"
+#include "mat.h"
+#include "profiler.h"
+#include "vec.h"
+
+namespace PANSFE {
+/**
+ * @brief Linear solver factorizing in low precision and refining the
+ * solution in high precision
+ *
+ * The matrix is factorized once in Low, residuals are computed in High and the
+ * correction equation is solved with the Low factor. When refinement does not
+ * reach High accuracy, the solver falls back to a High factorization.
+ *
+ * @tparam High Type of element of the system
+ * @tparam Low  Type of element used for factorization
+ */
+template <class High, class Low = float>
+class MixedPrecisionSolver {
+   public:
+    /**
+     * @brief Construct a new MixedPrecisionSolver object
+     *
+     * @param _mat          Square matrix
+     * @param _maxiteration Maximum number of refinement steps
+     */
+    explicit MixedPrecisionSolver(const Mat<High> &_mat,
+                                  int _maxiteration = 30)
+        : mat(_mat),
+          low(Mat<Low>(_mat)),
+          maxiteration(_maxiteration),
+          iteration(0),
+          fallback(false) {
+        assert(_mat.Row() == _mat.Col());
+        Index n = _mat.Row();
+        const High *a = _mat.Values();
+        this->norm = High();
+        for (Index i = 0; i < n; i++) {
+            High sum = High();
+            for (Index j = 0; j < n; j++) {
+                sum += std::abs(a[n * i + j]);
+            }
+            this->norm = sum > this->norm ? sum : this->norm;
+        }
+    }
+
+    /**
+     * @brief Solve A x = _b
+     *
+     * @param _b                Right hand side
+     * @return const Vec<High>  Solution accurate to High precision
+     */
+    const Vec<High> Solve(const Vec<High> &_b) {
+        PANSFE_PROFILE_SCOPE("MixedPrecisionSolver::Solve", 0, 0);
+        Index n = this->mat.Row();
+        assert(_b.Size() == n);
+        this->iteration = 0;
+        this->fallback = false;
+
+        Vec<High> x(n), r = _b;
+        const High eps = std::numeric_limits<High>::epsilon();
+        const High *a = this->mat.Values();
+        High previous = std::numeric_limits<High>::max();
+        if (!this->low.IsSingular()) {
+            for (; this->iteration <= this->maxiteration; this->iteration++) {
+                High rnorm = High(), xnorm = High();
+                for (Index i = 0; i < n; i++) {
+                    High sum = _b[i];
+                    for (Index j = 0; j < n; j++) {
+                        sum -= a[n * i + j] * x[j];
+                    }
+                    r[i] = sum;
+                    rnorm = std::abs(sum) > rnorm ? std::abs(sum) : rnorm;
+                    xnorm = std::abs(x[i]) > xnorm ? std::abs(x[i]) : xnorm;
+                }
+                if (this->iteration > 0 &&
+                    rnorm <= std::sqrt(High(n)) * xnorm * this->norm * eps) {
+                    return x;
+                }
+                if (!(rnorm < 0.5 * previous)) {
+                    break;
+                }
+                previous = rnorm;
+                Vec<Low> d(r);
+                this->low.SolveInPlace(d);
+                for (Index i = 0; i < n; i++) {
+                    x[i] += High(d[i]);
+                }
+            }
+        }
+
+        this->fallback = true;
+        if (this->high.Size() != n) {
+            this->high = LU<High>(this->mat);
+        }
+        return this->high.Solve(_b);
+    }
+
+    /**
+     * @brief Get number of refinement steps of the last Solve
+     *
+     * @return int  Number of refinement steps
+     */
+    int Iteration() const { return this->iteration; }
+
+    /**
+     * @brief Check whether the last Solve fell back to High factorization
+     *
+     * @return true     Solved with High factorization
+     * @return false    Solved with refinement
+     */
+    bool IsFallback() const { return this->fallback; }
+
+   private:
+    Mat<High> mat;
+    LU<Low> low;
+    LU<High> high;
+    High norm;
+    int maxiteration, iteration;
+    bool fallback;
+};
+}  // namespace PANSFE
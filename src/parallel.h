@@ -0,0 +1,200 @@
+/**
+ * @file parallel.h
+ * @author PANFACTORY (github/PANFACTORY)
+ * @brief Definition and implementation of thread parallel loop
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <exception>
+#include <thread>
+#include <vector>
+
+#include "index.h"
+
+namespace PANSFE {
+/**
+ * @brief Get storage of requested number of threads (0 means automatic)
+ *
+ * @return std::atomic<int>&    Requested number of threads
+ */
+inline std::atomic<int> &NumThreadsSetting() {
+    static std::atomic<int> numthreads(0);
+    return numthreads;
+}
+
+/**
+ * @brief Set number of threads used by parallel kernels
+ *
+ * @param _numthreads   Number of threads, 0 restores the default taken from
+ * PANSFE_NUM_THREADS or the hardware
+ */
+inline void SetNumThreads(int _numthreads) {
+    NumThreadsSetting() = _numthreads < 0 ? 0 : _numthreads;
+}
+
+/**
+ * @brief Get number of threads used by parallel kernels
+ *
+ * @return int  Number of threads
+ */
+inline int GetNumThreads() {
+    int numthreads = NumThreadsSetting();
+    if (numthreads > 0) {
+        return numthreads;
+    }
+    const char *env = std::getenv("PANSFE_NUM_THREADS");
+    if (env && std::atoi(env) > 0) {
+        return std::atoi(env);
+    }
+    return std::max(1, int(std::thread::hardware_concurrency()));
+}
+
+/**
+ * @brief Call _func(i) for every i in [_begin, _end) with static partition
+ * over threads
+ *
+ * An exception thrown by _func stops the indices left in its thread and is
+ * rethrown once every thread has finished.
+ *
+ * @tparam F        Type of function
+ * @param _begin    First index
+ * @param _end      Past the last index
+ * @param _func     Function called with each index
+ * @param _grain    Minimum number of indices per thread
+ */
+template <class F>
+inline void ParallelFor(Index _begin, Index _end, const F &_func,
+                        Index _grain = 1) {
+    Index length = _end - _begin;
+    if (length <= 0) {
+        return;
+    }
+    Index chunks = std::max<Index>(1, length / std::max<Index>(1, _grain));
+    int numthreads = int(std::min<Index>(GetNumThreads(), chunks));
+    if (numthreads <= 1) {
+        for (Index i = _begin; i < _end; i++) {
+            _func(i);
+        }
+        return;
+    }
+    std::vector<std::thread> threads;
+    std::vector<std::exception_ptr> errors(numthreads);
+    threads.reserve(numthreads - 1);
+    for (int t = 1; t < numthreads; t++) {
+        Index head = _begin + length * t / numthreads;
+        Index tail = _begin + length * (t + 1) / numthreads;
+        threads.emplace_back([=, &_func, &errors]() {
+            try {
+                for (Index i = head; i < tail; i++) {
+                    _func(i);
+                }
+            } catch (...) {
+                errors[t] = std::current_exception();
+            }
+        });
+    }
+    try {
+        Index tail = _begin + length / numthreads;
+        for (Index i = _begin; i < tail; i++) {
+            _func(i);
+        }
+    } catch (...) {
+        errors[0] = std::current_exception();
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    for (auto &error : errors) {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+}
+
+/**
+ * @brief Call _func(t) for every t in [0, _numthreads), each on its own
+ * thread, so that the calls run at once and may wait on a Barrier
+ *
+ * An exception thrown by _func is rethrown once every thread has finished,
+ * so _func must not throw while other calls wait for it.
+ *
+ * @tparam F            Type of function
+ * @param _numthreads   Number of threads
+ * @param _func         Function called with each thread index
+ */
+template <class F>
+inline void ParallelTeam(int _numthreads, const F &_func) {
+    std::vector<std::thread> threads;
+    std::vector<std::exception_ptr> errors(std::max(1, _numthreads));
+    threads.reserve(std::max(0, _numthreads - 1));
+    for (int t = 1; t < _numthreads; t++) {
+        threads.emplace_back([=, &_func, &errors]() {
+            try {
+                _func(t);
+            } catch (...) {
+                errors[t] = std::current_exception();
+            }
+        });
+    }
+    try {
+        _func(0);
+    } catch (...) {
+        errors[0] = std::current_exception();
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    for (auto &error : errors) {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+}
+
+/**
+ * @brief Reusable barrier for the threads of ParallelTeam
+ *
+ * Waiting threads spin and yield, which suits the short phases of sweeps
+ * such as level scheduled triangular solves.
+ *
+ */
+class Barrier {
+   public:
+    /**
+     * @brief Construct a new Barrier object
+     *
+     * @param _count    Number of threads waiting at each phase
+     */
+    explicit Barrier(int _count) : count(_count), waiting(0), phase(0) {}
+
+    /**
+     * @brief Wait until all threads have arrived, writes made before the
+     * call are visible to every thread after it
+     *
+     */
+    void Wait() {
+        int phase = this->phase.load(std::memory_order_acquire);
+        if (this->waiting.fetch_add(1, std::memory_order_acq_rel) + 1 ==
+            this->count) {
+            this->waiting.store(0, std::memory_order_relaxed);
+            this->phase.fetch_add(1, std::memory_order_acq_rel);
+            return;
+        }
+        while (this->phase.load(std::memory_order_acquire) == phase) {
+            std::this_thread::yield();
+        }
+    }
+
+   private:
+    const int count;
+    std::atomic<int> waiting, phase;
+};
+}  // namespace PANSFE
@@ -0,0 +1,740 @@
+/**
+ * @file preconditioner.h
+ * @author PANFACTORY (github/PANFACTORY)
+ * @brief Definition and implementation of Jacobi, block Jacobi, incomplete LU
+ * and incomplete Cholesky preconditioners
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#pragma once
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <functional>
+#include <queue>
+#include <utility>
+#include <vector>
+
+#include "linearoperator.h"
+#include "lu.h"
+#include "mat.h"
+#include "parallel.h"
+#include "profiler.h"
+#include "sparsemat.h"
+#include "vec.h"
+
+namespace PANSFE {
+/**
+ * @brief Sparse triangular matrix solved by level scheduling
+ *
+ * The strictly triangular part is stored as CSR. Rows are grouped into levels
+ * whose rows depend only on earlier levels. A solve starts one team of
+ * threads, which split every level among themselves and meet at a barrier
+ * before the next level.
+ *
+ * @tparam T Type of element
+ */
+template <class T>
+class SparseTriangular {
+   public:
+    /**
+     * @brief Minimum number of rows of the widest level per thread
+     *
+     */
+    static const int Grain = 16;
+
+    /**
+     * @brief Construct a new empty SparseTriangular object
+     *
+     */
+    SparseTriangular() : size(0), width(0), rowptr(1, 0) {}
+
+    /**
+     * @brief Construct a new SparseTriangular object
+     *
+     * @param _size     Size of the matrix
+     * @param _rowptr   Offset of each row of the strictly triangular part
+     * @param _colind   Column index of each nonzero
+     * @param _values   Value of each nonzero
+     * @param _invdiag  Inverse of diagonal elements, empty for unit diagonal
+     * @param _lower    Lower triangular or upper triangular
+     */
+    SparseTriangular(int _size, std::vector<int> _rowptr,
+                     std::vector<int> _colind, std::vector<T> _values,
+                     std::vector<T> _invdiag, bool _lower)
+        : size(_size),
+          width(0),
+          rowptr(std::move(_rowptr)),
+          colind(std::move(_colind)),
+          values(std::move(_values)),
+          invdiag(std::move(_invdiag)) {
+        assert(int(this->rowptr.size()) == this->size + 1);
+        assert(this->invdiag.empty() || int(this->invdiag.size()) == _size);
+        std::vector<int> level(this->size, 0);
+        int numlevels = 0;
+        for (int s = 0; s < this->size; s++) {
+            int i = _lower ? s : this->size - 1 - s;
+            for (int k = this->rowptr[i]; k < this->rowptr[i + 1]; k++) {
+                assert(_lower ? this->colind[k] < i : this->colind[k] > i);
+                level[i] = std::max(level[i], level[this->colind[k]] + 1);
+            }
+            numlevels = std::max(numlevels, level[i] + 1);
+        }
+        this->levelptr.assign(numlevels + 1, 0);
+        for (int i = 0; i < this->size; i++) {
+            this->levelptr[level[i] + 1]++;
+        }
+        for (int l = 0; l < numlevels; l++) {
+            this->width = std::max(this->width, this->levelptr[l + 1]);
+            this->levelptr[l + 1] += this->levelptr[l];
+        }
+        std::vector<int> position(this->levelptr.begin(),
+                                  this->levelptr.end() - 1);
+        this->order.resize(this->size);
+        for (int i = 0; i < this->size; i++) {
+            this->order[position[level[i]]++] = i;
+        }
+    }
+
+    /**
+     * @brief Get size of the matrix
+     *
+     * @return int  Size of the matrix
+     */
+    int Size() const { return this->size; }
+
+    /**
+     * @brief Get number of levels, rows of a level are solved in parallel
+     *
+     * @return int  Number of levels
+     */
+    int Levels() const { return int(this->levelptr.size()) - 1; }
+
+    /**
+     * @brief Get number of threads a solve runs on, at most Grain rows of the
+     * widest level per thread
+     *
+     * @return int  Number of threads
+     */
+    int Threads() const {
+        return std::max(1, std::min(GetNumThreads(), this->width / Grain));
+    }
+
+    /**
+     * @brief Solve T x = _x in place without allocation
+     *
+     * @param _x    Right hand side on input and solution on output
+     */
+    void SolveInPlace(Vec<T> &_x) const {
+        PANSFE_PROFILE_SCOPE(
+            "SparseTriangular::Solve", 2.0 * this->colind.size() + this->size,
+            (sizeof(T) + sizeof(int)) * double(this->colind.size()) +
+                2 * sizeof(T) * double(this->size));
+        assert(_x.Size() == this->size);
+        T *x = _x.Values();
+        auto solve = [&](int _s) {
+            int i = this->order[_s];
+            T sum = x[i];
+            for (int k = this->rowptr[i]; k < this->rowptr[i + 1]; k++) {
+                sum -= this->values[k] * x[this->colind[k]];
+            }
+            x[i] = this->invdiag.empty() ? sum : sum * this->invdiag[i];
+        };
+        int team = this->Threads();
+        if (team == 1) {
+            for (int s = 0; s < this->size; s++) {
+                solve(s);
+            }
+            return;
+        }
+        Barrier barrier(team);
+        ParallelTeam(team, [&](int _t) {
+            for (int l = 0; l < this->Levels(); l++) {
+                int head = this->levelptr[l],
+                    length = this->levelptr[l + 1] - head;
+                int tail = head + int((long long)length * (_t + 1) / team);
+                for (int s = head + int((long long)length * _t / team);
+                     s < tail; s++) {
+                    solve(s);
+                }
+                barrier.Wait();
+            }
+        });
+    }
+
+   private:
+    int size, width;
+    std::vector<int> rowptr, colind, order, levelptr;
+    std::vector<T> values, invdiag;
+};
+
+/**
+ * @brief Jacobi preconditioner M = diag(A)
+ *
+ * @tparam T Type of element
+ */
+template <class T>
+class Jacobi {
+   public:
+    /**
+     * @brief Construct a new Jacobi object
+     *
+     * @param _mat  Square sparse matrix whose diagonal is nonzero
+     */
+    explicit Jacobi(const SparseMat<T> &_mat)
+        : invdiag(_mat.Diagonal()) {
+        assert(_mat.Row() == _mat.Col());
+        for (int i = 0; i < this->invdiag.Size(); i++) {
+            assert(this->invdiag[i] != T());
+            this->invdiag[i] = T(1) / this->invdiag[i];
+        }
+    }
+
+    /**
+     * @brief Get number of row
+     *
+     * @return int  Number of row
+     */
+    int Row() const { return this->invdiag.Size(); }
+
+    /**
+     * @brief Get number of column
+     *
+     * @return int  Number of column
+     */
+    int Col() const { return this->invdiag.Size(); }
+
+    /**
+     * @brief Set _y = M^-1 _x without allocation
+     *
+     * @param _x    Vector sized Col()
+     * @param _y    Vector sized Row()
+     */
+    void Apply(const Vec<T> &_x, Vec<T> &_y) const {
+        assert(_x.Size() == this->Col() && _y.Size() == this->Row());
+        const T *x = _x.Values(), *invdiag = this->invdiag.Values();
+        T *y = _y.Values();
+        ParallelFor(
+            0, this->Row(), [&](int _i) { y[_i] = invdiag[_i] * x[_i]; },
+            4096);
+    }
+
+    /**
+     * @brief Get operator applying M^-1, which refers to this object
+     *
+     * @return const LinearOperator<T>  Operator applying M^-1
+     */
+    const LinearOperator<T> Operator() const {
+        auto apply = [this](const Vec<T> &_x, Vec<T> &_y) {
+            this->Apply(_x, _y);
+        };
+        return LinearOperator<T>(this->Row(), this->Col(), apply, apply,
+                                 this->invdiag);
+    }
+
+   private:
+    Vec<T> invdiag;
+};
+
+/**
+ * @brief Block Jacobi preconditioner whose blocks are contiguous diagonal
+ * blocks of A inverted densely
+ *
+ * @tparam T Type of element
+ */
+template <class T>
+class BlockJacobi {
+   public:
+    /**
+     * @brief Construct a new BlockJacobi object
+     *
+     * @param _mat          Square sparse matrix whose diagonal blocks are
+     * nonsingular
+     * @param _blocksize    Size of each block, the last one may be smaller
+     */
+    BlockJacobi(const SparseMat<T> &_mat, int _blocksize)
+        : size(_mat.Row()), blocksize(_blocksize) {
+        PANSFE_PROFILE_SCOPE("BlockJacobi::BlockJacobi", 0, 0);
+        assert(_mat.Row() == _mat.Col() && _blocksize > 0);
+        int numblocks = (this->size + _blocksize - 1) / _blocksize;
+        this->offset.assign(numblocks + 1, 0);
+        for (int b = 0; b < numblocks; b++) {
+            int n = this->BlockRow(b + 1) - this->BlockRow(b);
+            this->offset[b + 1] = this->offset[b] + (long long)n * n;
+        }
+        this->inverses.resize(this->offset[numblocks]);
+        const std::vector<int> &rowptr = _mat.RowPtr(),
+                               &colind = _mat.ColInd();
+        const T *values = _mat.Values();
+        ParallelFor(0, numblocks, [&](int _b) {
+            int head = this->BlockRow(_b), n = this->BlockRow(_b + 1) - head;
+            Mat<T> block(n, n);
+            for (int i = 0; i < n; i++) {
+                for (int k = rowptr[head + i]; k < rowptr[head + i + 1]; k++) {
+                    int j = colind[k] - head;
+                    if (0 <= j && j < n) {
+                        block[i][j] = values[k];
+                    }
+                }
+            }
+            LU<T> lu(block);
+            assert(!lu.IsSingular());
+            Mat<T> inverse = lu.Inverse();
+            T *dst = this->inverses.data() + this->offset[_b];
+            for (int i = 0; i < n; i++) {
+                for (int j = 0; j < n; j++) {
+                    dst[i * n + j] = inverse[i][j];
+                }
+            }
+        });
+    }
+
+    /**
+     * @brief Get number of row
+     *
+     * @return int  Number of row
+     */
+    int Row() const { return this->size; }
+
+    /**
+     * @brief Get number of column
+     *
+     * @return int  Number of column
+     */
+    int Col() const { return this->size; }
+
+    /**
+     * @brief Set _y = M^-1 _x without allocation, blocks in parallel
+     *
+     * @param _x    Vector sized Col()
+     * @param _y    Vector sized Row()
+     */
+    void Apply(const Vec<T> &_x, Vec<T> &_y) const {
+        this->Multiply(_x, _y, false);
+    }
+
+    /**
+     * @brief Set _y = M^-T _x without allocation, blocks in parallel
+     *
+     * @param _x    Vector sized Row()
+     * @param _y    Vector sized Col()
+     */
+    void ApplyTranspose(const Vec<T> &_x, Vec<T> &_y) const {
+        this->Multiply(_x, _y, true);
+    }
+
+    /**
+     * @brief Get operator applying M^-1, which refers to this object
+     *
+     * @return const LinearOperator<T>  Operator applying M^-1
+     */
+    const LinearOperator<T> Operator() const {
+        return LinearOperator<T>(
+            this->size, this->size,
+            [this](const Vec<T> &_x, Vec<T> &_y) { this->Apply(_x, _y); },
+            [this](const Vec<T> &_x, Vec<T> &_y) {
+                this->ApplyTranspose(_x, _y);
+            });
+    }
+
+   private:
+    int size, blocksize;
+    std::vector<long long> offset;
+    std::vector<T> inverses;
+
+    int BlockRow(int _b) const {
+        return std::min(this->size, _b * this->blocksize);
+    }
+
+    void Multiply(const Vec<T> &_x, Vec<T> &_y, bool _transpose) const {
+        PANSFE_PROFILE_SCOPE("BlockJacobi::Apply",
+                             2.0 * this->inverses.size(),
+                             sizeof(T) * double(this->inverses.size()));
+        assert(_x.Size() == this->size && _y.Size() == this->size);
+        assert(_x.Values() != _y.Values());
+        const T *x = _x.Values();
+        T *y = _y.Values();
+        ParallelFor(
+            0, int(this->offset.size()) - 1,
+            [&](int _b) {
+                int head = this->BlockRow(_b),
+                    n = this->BlockRow(_b + 1) - head;
+                const T *inverse = this->inverses.data() + this->offset[_b];
+                for (int i = 0; i < n; i++) {
+                    T sum = T();
+                    for (int j = 0; j < n; j++) {
+                        sum += (_transpose ? inverse[j * n + i]
+                                           : inverse[i * n + j]) *
+                               x[head + j];
+                    }
+                    y[head + i] = sum;
+                }
+            },
+            16);
+    }
+};
+
+/**
+ * @brief Incomplete LU preconditioner M = L U, with zero fill ILU(0) or with
+ * threshold dropping ILUT
+ *
+ * L has unit diagonal. Both triangular solves are level scheduled.
+ *
+ * @tparam T Type of element
+ */
+template <class T>
+class ILU {
+   public:
+    /**
+     * @brief Construct a new ILU object by ILU(0), the factors keep the
+     * pattern of A
+     *
+     * @param _mat  Square sparse matrix whose diagonal is stored and nonzero
+     */
+    explicit ILU(const SparseMat<T> &_mat) {
+        PANSFE_PROFILE_SCOPE("ILU::ILU", 0, 0);
+        assert(_mat.Row() == _mat.Col());
+        int n = _mat.Row();
+        const std::vector<int> &rowptr = _mat.RowPtr(),
+                               &colind = _mat.ColInd();
+        std::vector<T> values(_mat.Values(), _mat.Values() + _mat.NonZeros());
+        std::vector<int> diagonal(n, -1), position(n, -1);
+        for (int i = 0; i < n; i++) {
+            for (int k = rowptr[i]; k < rowptr[i + 1]; k++) {
+                position[colind[k]] = k;
+            }
+            for (int k = rowptr[i]; k < rowptr[i + 1] && colind[k] < i; k++) {
+                int p = colind[k];
+                values[k] /= values[diagonal[p]];
+                for (int q = diagonal[p] + 1; q < rowptr[p + 1]; q++) {
+                    if (position[colind[q]] >= 0) {
+                        values[position[colind[q]]] -= values[k] * values[q];
+                    }
+                }
+            }
+            diagonal[i] = position[i];
+            assert(diagonal[i] >= 0 && values[diagonal[i]] != T());
+            for (int k = rowptr[i]; k < rowptr[i + 1]; k++) {
+                position[colind[k]] = -1;
+            }
+        }
+
+        std::vector<int> lrowptr(n + 1, 0), urowptr(n + 1, 0), lcolind,
+            ucolind;
+        std::vector<T> lvalues, uvalues, invdiag(n);
+        for (int i = 0; i < n; i++) {
+            for (int k = rowptr[i]; k < rowptr[i + 1]; k++) {
+                if (colind[k] < i) {
+                    lcolind.push_back(colind[k]);
+                    lvalues.push_back(values[k]);
+                } else if (colind[k] > i) {
+                    ucolind.push_back(colind[k]);
+                    uvalues.push_back(values[k]);
+                }
+            }
+            lrowptr[i + 1] = int(lcolind.size());
+            urowptr[i + 1] = int(ucolind.size());
+            invdiag[i] = T(1) / values[diagonal[i]];
+        }
+        this->l = SparseTriangular<T>(n, std::move(lrowptr),
+                                      std::move(lcolind), std::move(lvalues),
+                                      std::vector<T>(), true);
+        this->u = SparseTriangular<T>(n, std::move(urowptr),
+                                      std::move(ucolind), std::move(uvalues),
+                                      std::move(invdiag), false);
+    }
+
+    /**
+     * @brief Construct a new ILU object by ILUT, entries smaller than
+     * _droptolerance times the norm of their row are dropped and at most
+     * _fill largest entries are kept in each row of L and of U
+     *
+     * @param _mat              Square sparse matrix
+     * @param _droptolerance    Relative drop tolerance
+     * @param _fill             Largest number of off diagonal entries kept in
+     * each row of L and of U
+     */
+    ILU(const SparseMat<T> &_mat, T _droptolerance, int _fill) {
+        PANSFE_PROFILE_SCOPE("ILU::ILU", 0, 0);
+        assert(_mat.Row() == _mat.Col() && _fill >= 0);
+        int n = _mat.Row();
+        const std::vector<int> &rowptr = _mat.RowPtr(),
+                               &colind = _mat.ColInd();
+        const T *values = _mat.Values();
+        std::vector<int> lrowptr(n + 1, 0), urowptr(n + 1, 0), lcolind,
+            ucolind;
+        std::vector<T> lvalues, uvalues, invdiag(n);
+        std::vector<T> work(n, T());
+        std::vector<char> used(n, 0);
+        std::vector<int> pattern, lower, upper;
+        std::priority_queue<int, std::vector<int>, std::greater<int> > queue;
+        auto larger = [&](int _a, int _b) {
+            return std::abs(work[_a]) > std::abs(work[_b]);
+        };
+        for (int i = 0; i < n; i++) {
+            T norm = T();
+            for (int k = rowptr[i]; k < rowptr[i + 1]; k++) {
+                int j = colind[k];
+                work[j] = values[k];
+                used[j] = 1;
+                pattern.push_back(j);
+                if (j < i) {
+                    queue.push(j);
+                }
+                norm += values[k] * values[k];
+            }
+            T tolerance = _droptolerance * std::sqrt(norm);
+            while (!queue.empty()) {
+                int p = queue.top();
+                queue.pop();
+                work[p] *= invdiag[p];
+                if (std::abs(work[p]) < tolerance) {
+                    work[p] = T();
+                    continue;
+                }
+                for (int q = urowptr[p]; q < urowptr[p + 1]; q++) {
+                    int j = ucolind[q];
+                    if (!used[j]) {
+                        used[j] = 1;
+                        pattern.push_back(j);
+                        if (j < i) {
+                            queue.push(j);
+                        }
+                    }
+                    work[j] -= work[p] * uvalues[q];
+                }
+            }
+            for (int j : pattern) {
+                if (j != i && std::abs(work[j]) >= tolerance &&
+                    work[j] != T()) {
+                    (j < i ? lower : upper).push_back(j);
+                }
+            }
+            for (std::vector<int> *part : {&lower, &upper}) {
+                if (int(part->size()) > _fill) {
+                    std::nth_element(part->begin(), part->begin() + _fill,
+                                     part->end(), larger);
+                    part->resize(_fill);
+                }
+                std::sort(part->begin(), part->end());
+            }
+            for (int j : lower) {
+                lcolind.push_back(j);
+                lvalues.push_back(work[j]);
+            }
+            for (int j : upper) {
+                ucolind.push_back(j);
+                uvalues.push_back(work[j]);
+            }
+            lrowptr[i + 1] = int(lcolind.size());
+            urowptr[i + 1] = int(ucolind.size());
+            T diagonal = work[i];
+            if (diagonal == T()) {
+                diagonal = tolerance != T() ? tolerance : T(1);
+            }
+            invdiag[i] = T(1) / diagonal;
+            for (int j : pattern) {
+                work[j] = T();
+                used[j] = 0;
+            }
+            pattern.clear();
+            lower.clear();
+            upper.clear();
+        }
+        this->l = SparseTriangular<T>(n, std::move(lrowptr),
+                                      std::move(lcolind), std::move(lvalues),
+                                      std::vector<T>(), true);
+        this->u = SparseTriangular<T>(n, std::move(urowptr),
+                                      std::move(ucolind), std::move(uvalues),
+                                      std::move(invdiag), false);
+    }
+
+    /**
+     * @brief Get number of row
+     *
+     * @return int  Number of row
+     */
+    int Row() const { return this->l.Size(); }
+
+    /**
+     * @brief Get number of column
+     *
+     * @return int  Number of column
+     */
+    int Col() const { return this->l.Size(); }
+
+    /**
+     * @brief Get unit lower triangular factor without its diagonal
+     *
+     * @return const SparseTriangular<T>&  Factor L
+     */
+    const SparseTriangular<T> &L() const { return this->l; }
+
+    /**
+     * @brief Get upper triangular factor
+     *
+     * @return const SparseTriangular<T>&  Factor U
+     */
+    const SparseTriangular<T> &U() const { return this->u; }
+
+    /**
+     * @brief Set _y = (L U)^-1 _x without allocation
+     *
+     * @param _x    Vector sized Col()
+     * @param _y    Vector sized Row()
+     */
+    void Apply(const Vec<T> &_x, Vec<T> &_y) const {
+        assert(_x.Size() == this->Col() && _y.Size() == this->Row());
+        if (&_x != &_y) {
+            std::copy(_x.Values(), _x.Values() + _x.Size(), _y.Values());
+        }
+        this->l.SolveInPlace(_y);
+        this->u.SolveInPlace(_y);
+    }
+
+    /**
+     * @brief Get operator applying M^-1, which refers to this object
+     *
+     * @return const LinearOperator<T>  Operator applying M^-1
+     */
+    const LinearOperator<T> Operator() const {
+        return LinearOperator<T>(
+            this->Row(), this->Col(),
+            [this](const Vec<T> &_x, Vec<T> &_y) { this->Apply(_x, _y); });
+    }
+
+   private:
+    SparseTriangular<T> l, u;
+};
+
+/**
+ * @brief Incomplete Cholesky preconditioner M = L L^T with zero fill IC(0)
+ *
+ * L keeps the pattern of the lower triangle of A. A nonpositive pivot is
+ * replaced by the diagonal of A and reported by IsPositiveDefinite.
+ *
+ * @tparam T Type of element
+ */
+template <class T>
+class IC {
+   public:
+    /**
+     * @brief Construct a new IC object
+     *
+     * @param _mat  Symmetric sparse matrix whose diagonal is stored
+     */
+    explicit IC(const SparseMat<T> &_mat) : definite(true) {
+        PANSFE_PROFILE_SCOPE("IC::IC", 0, 0);
+        assert(_mat.Row() == _mat.Col());
+        int n = _mat.Row();
+        const std::vector<int> &rowptr = _mat.RowPtr(),
+                               &colind = _mat.ColInd();
+        const T *values = _mat.Values();
+        std::vector<int> lrowptr(n + 1, 0), lcolind, position(n, -1);
+        std::vector<T> lvalues, invdiag(n);
+        for (int i = 0; i < n; i++) {
+            int head = int(lcolind.size());
+            T aii = T();
+            for (int k = rowptr[i]; k < rowptr[i + 1]; k++) {
+                if (colind[k] < i) {
+                    position[colind[k]] = int(lcolind.size());
+                    lcolind.push_back(colind[k]);
+                    lvalues.push_back(values[k]);
+                } else if (colind[k] == i) {
+                    aii = values[k];
+                }
+            }
+            int tail = int(lcolind.size());
+            T sum = T();
+            for (int k = head; k < tail; k++) {
+                int p = lcolind[k];
+                for (int q = lrowptr[p]; q < lrowptr[p + 1]; q++) {
+                    if (position[lcolind[q]] >= 0) {
+                        lvalues[k] -= lvalues[position[lcolind[q]]] *
+                                      lvalues[q];
+                    }
+                }
+                lvalues[k] *= invdiag[p];
+                sum += lvalues[k] * lvalues[k];
+            }
+            T pivot = aii - sum;
+            if (!(pivot > T())) {
+                this->definite = false;
+                pivot = std::abs(aii) > T() ? std::abs(aii) : T(1);
+            }
+            invdiag[i] = T(1) / std::sqrt(pivot);
+            for (int k = head; k < tail; k++) {
+                position[lcolind[k]] = -1;
+            }
+            lrowptr[i + 1] = tail;
+        }
+
+        SparseMat<T> lower(n, n, lrowptr, lcolind, lvalues);
+        SparseMat<T> upper = lower.Transpose();
+        this->l = SparseTriangular<T>(n, std::move(lrowptr),
+                                      std::move(lcolind), std::move(lvalues),
+                                      invdiag, true);
+        this->lt = SparseTriangular<T>(
+            n, upper.RowPtr(), upper.ColInd(),
+            std::vector<T>(upper.Values(), upper.Values() + upper.NonZeros()),
+            std::move(invdiag), false);
+    }
+
+    /**
+     * @brief Get number of row
+     *
+     * @return int  Number of row
+     */
+    int Row() const { return this->l.Size(); }
+
+    /**
+     * @brief Get number of column
+     *
+     * @return int  Number of column
+     */
+    int Col() const { return this->l.Size(); }
+
+    /**
+     * @brief Check whether no pivot was replaced
+     *
+     * @return true     All pivots were positive
+     * @return false    Some pivot was replaced
+     */
+    bool IsPositiveDefinite() const { return this->definite; }
+
+    /**
+     * @brief Set _y = (L L^T)^-1 _x without allocation
+     *
+     * @param _x    Vector sized Col()
+     * @param _y    Vector sized Row()
+     */
+    void Apply(const Vec<T> &_x, Vec<T> &_y) const {
+        assert(_x.Size() == this->Col() && _y.Size() == this->Row());
+        if (&_x != &_y) {
+            std::copy(_x.Values(), _x.Values() + _x.Size(), _y.Values());
+        }
+        this->l.SolveInPlace(_y);
+        this->lt.SolveInPlace(_y);
+    }
+
+    /**
+     * @brief Get operator applying M^-1, which refers to this object
+     *
+     * @return const LinearOperator<T>  Operator applying M^-1
+     */
+    const LinearOperator<T> Operator() const {
+        auto apply = [this](const Vec<T> &_x, Vec<T> &_y) {
+            this->Apply(_x, _y);
+        };
+        return LinearOperator<T>(this->Row(), this->Col(), apply, apply);
+    }
+
+   private:
+    SparseTriangular<T> l, lt;
+    bool definite;
+};
+}  // namespace PANSFE
@@ -0,0 +1,274 @@
+/**
+ * @file profiler.h
+ * @author PANFACTORY (github/PANFACTORY)
+ * @brief Definition and implementation of opt-in operation profiler
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2022
+ *
+ * Instrumentation is compiled out unless PANSFE_PROFILE is defined. When it
+ * is defined, every public operation of Vec and Mat records call count, wall
+ * time, estimated FLOPs, bytes moved and heap allocations. Set the
+ * environment variable PANSFE_PROFILE_REPORT to "table" or "json" to dump a
+ * summary to std::cerr at exit, or call Profiler::Report/ReportJSON at any
+ * time.
+ */
+
+#pragma once
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <string>
+
+namespace PANSFE {
+/**
+ * @brief Accumulated counters of one profiled operation
+ *
+ */
+struct ProfileRecord {
+    long long calls = 0;         ///< Number of calls
+    double seconds = 0;          ///< Inclusive wall time in seconds
+    double flops = 0;            ///< Estimated floating point operations
+    double bytes = 0;            ///< Estimated bytes read and written
+    long long allocations = 0;   ///< Inclusive number of heap allocations
+    double allocated_bytes = 0;  ///< Inclusive bytes of heap allocations
+};
+
+/**
+ * @brief Process wide collector of profile records
+ *
+ */
+class Profiler {
+   public:
+    /**
+     * @brief Get the profiler instance
+     *
+     * @return Profiler&    Singleton profiler
+     */
+    static Profiler &Instance() {
+        static Profiler profiler;
+        return profiler;
+    }
+
+    /**
+     * @brief Add one call of operation _name
+     *
+     * @param _name         Name of operation
+     * @param _seconds      Elapsed wall time
+     * @param _flops        Estimated floating point operations
+     * @param _bytes        Estimated bytes moved
+     * @param _allocations  Number of heap allocations during the call
+     * @param _allocated    Bytes allocated during the call
+     */
+    void Record(const char *_name, double _seconds, double _flops,
+                double _bytes, long long _allocations, double _allocated) {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        ProfileRecord &record = this->records[_name];
+        record.calls++;
+        record.seconds += _seconds;
+        record.flops += _flops;
+        record.bytes += _bytes;
+        record.allocations += _allocations;
+        record.allocated_bytes += _allocated;
+    }
+
+    /**
+     * @brief Clear all records
+     *
+     */
+    void Reset() {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->records.clear();
+    }
+
+    /**
+     * @brief Get copy of all records
+     *
+     * @return std::map<std::string, ProfileRecord>    Records keyed by name
+     */
+    std::map<std::string, ProfileRecord> Records() const {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        return this->records;
+    }
+
+    /**
+     * @brief Write records as a human readable table
+     *
+     * @param _out  Stream
+     */
+    void Report(std::ostream &_out) const {
+        std::map<std::string, ProfileRecord> copied = this->Records();
+        _out << std::left << std::setw(32) << "operation" << std::right
+             << std::setw(12) << "calls" << std::setw(14) << "time[s]"
+             << std::setw(14) << "GFLOP" << std::setw(14) << "GB"
+             << std::setw(12) << "allocs" << std::setw(14) << "alloc[MB]"
+             << "\n";
+        for (auto &record : copied) {
+            _out << std::left << std::setw(32) << record.first << std::right
+                 << std::setw(12) << record.second.calls << std::setw(14)
+                 << record.second.seconds << std::setw(14)
+                 << record.second.flops * 1e-9 << std::setw(14)
+                 << record.second.bytes * 1e-9 << std::setw(12)
+                 << record.second.allocations << std::setw(14)
+                 << record.second.allocated_bytes * 1e-6 << "\n";
+        }
+        _out.flush();
+    }
+
+    /**
+     * @brief Write records as JSON object keyed by operation name
+     *
+     * @param _out  Stream
+     */
+    void ReportJSON(std::ostream &_out) const {
+        std::map<std::string, ProfileRecord> copied = this->Records();
+        std::streamsize precision = _out.precision(17);
+        _out << "{";
+        bool first = true;
+        for (auto &record : copied) {
+            _out << (first ? "\n" : ",\n") << "  \"" << record.first
+                 << "\": {\"calls\": " << record.second.calls
+                 << ", \"seconds\": " << record.second.seconds
+                 << ", \"flops\": " << record.second.flops
+                 << ", \"bytes\": " << record.second.bytes
+                 << ", \"allocations\": " << record.second.allocations
+                 << ", \"allocated_bytes\": " << record.second.allocated_bytes
+                 << "}";
+            first = false;
+        }
+        _out << "\n}\n";
+        _out.precision(precision);
+        _out.flush();
+    }
+
+    /**
+     * @brief Choose report written to std::cerr at exit
+     *
+     * @param _format   "table", "json" or "" for no report
+     */
+    void DumpAtExit(const std::string &_format) {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->format = _format;
+    }
+
+    /**
+     * @brief Destroy the Profiler object and write the report at exit
+     *
+     */
+    ~Profiler() {
+        if (this->format == "json") {
+            this->ReportJSON(std::cerr);
+        } else if (this->format == "table") {
+            this->Report(std::cerr);
+        }
+    }
+
+    /**
+     * @brief Get number of heap allocations on this thread so far
+     *
+     * @return long long&   Allocation counter of this thread
+     */
+    static long long &ThreadAllocations() {
+        static thread_local long long allocations = 0;
+        return allocations;
+    }
+
+    /**
+     * @brief Get bytes of heap allocations on this thread so far
+     *
+     * @return double&  Allocated bytes counter of this thread
+     */
+    static double &ThreadAllocatedBytes() {
+        static thread_local double allocated = 0;
+        return allocated;
+    }
+
+   private:
+    Profiler() {
+        const char *env = std::getenv("PANSFE_PROFILE_REPORT");
+        if (env) {
+            this->format = env;
+        }
+    }
+    Profiler(const Profiler &) = delete;
+    Profiler &operator=(const Profiler &) = delete;
+
+    mutable std::mutex mutex;
+    std::map<std::string, ProfileRecord> records;
+    std::string format;
+};
+
+/**
+ * @brief Scope guard recording one call of an operation
+ *
+ * Time and allocations are inclusive, so an operation implemented with other
+ * operations is also charged for their cost. FLOPs and bytes are estimated
+ * only by the operation running the loop, so their sums over all records
+ * count every kernel once.
+ */
+class ProfileScope {
+   public:
+    /**
+     * @brief Start measuring operation _name
+     *
+     * @param _name     Name of operation (must outlive the scope)
+     * @param _flops    Estimated floating point operations
+     * @param _bytes    Estimated bytes moved
+     */
+    ProfileScope(const char *_name, double _flops, double _bytes)
+        : name(_name),
+          flops(_flops),
+          bytes(_bytes),
+          allocations(Profiler::ThreadAllocations()),
+          allocated(Profiler::ThreadAllocatedBytes()),
+          start(std::chrono::steady_clock::now()) {}
+
+    /**
+     * @brief Stop measuring and record the call
+     *
+     */
+    ~ProfileScope() {
+        std::chrono::duration<double> elapsed =
+            std::chrono::steady_clock::now() - this->start;
+        Profiler::Instance().Record(
+            this->name, elapsed.count(), this->flops, this->bytes,
+            Profiler::ThreadAllocations() - this->allocations,
+            Profiler::ThreadAllocatedBytes() - this->allocated);
+    }
+
+   private:
+    ProfileScope(const ProfileScope &) = delete;
+    ProfileScope &operator=(const ProfileScope &) = delete;
+
+    const char *name;
+    double flops, bytes;
+    long long allocations;
+    double allocated;
+    std::chrono::steady_clock::time_point start;
+};
+}  // namespace PANSFE
+
+#ifdef PANSFE_PROFILE
+/**
+ * @brief Record current scope as one call of operation _name
+ *
+ */
+#define PANSFE_PROFILE_SCOPE(_name, _flops, _bytes)                   \
+    PANSFE::ProfileScope pansfe_profile_scope((_name), double(_flops), \
+                                              double(_bytes))
+
+/**
+ * @brief Count one heap allocation of _bytes bytes on this thread
+ *
+ */
+#define PANSFE_PROFILE_ALLOC(_bytes)                                  \
+    (PANSFE::Profiler::ThreadAllocations()++,                         \
+     PANSFE::Profiler::ThreadAllocatedBytes() += double(_bytes))
+#else
+#define PANSFE_PROFILE_SCOPE(_name, _flops, _bytes) ((void)0)
+#define PANSFE_PROFILE_ALLOC(_bytes) ((void)0)
+#endif
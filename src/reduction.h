@@ -0,0 +1,104 @@
+/**
+ * @file reduction.h
+ * @author PANFACTORY (github/PANFACTORY)
+ * @brief Definition and implementation of deterministic parallel reduction
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#pragma once
+#include <algorithm>
+#include <vector>
+
+#include "parallel.h"
+
+namespace PANSFE {
+/**
+ * @brief Number of terms summed linearly (with 8 accumulators) at the leaves
+ * of the pairwise summation tree
+ *
+ */
+const int ReductionLeaf = 128;
+
+/**
+ * @brief Number of terms per parallel chunk, must be a multiple of
+ * ReductionLeaf
+ *
+ */
+const int ReductionChunk = 64 * ReductionLeaf;
+
+/**
+ * @brief Sum _term(i) for i in [_begin, _end) by pairwise summation
+ *
+ * @tparam T        Type of term
+ * @tparam F        Type of function
+ * @param _begin    First index
+ * @param _end      Past the last index
+ * @param _term     Function returning each term
+ * @return T        Sum of terms
+ */
+template <class T, class F>
+inline T PairwiseSum(Index _begin, Index _end, const F &_term) {
+    if (_end - _begin <= ReductionLeaf) {
+        T accumulator[8] = {T(), T(), T(), T(), T(), T(), T(), T()};
+        Index i = _begin;
+        for (; i + 8 <= _end; i += 8) {
+            for (int k = 0; k < 8; k++) {
+                accumulator[k] += _term(i + k);
+            }
+        }
+        Index rest = _end - i;
+        for (Index r = 0; r < rest; r++) {
+            accumulator[r] += _term(i + r);
+        }
+        return ((accumulator[0] + accumulator[1]) +
+                (accumulator[2] + accumulator[3])) +
+               ((accumulator[4] + accumulator[5]) +
+                (accumulator[6] + accumulator[7]));
+    }
+    Index half = (_end - _begin) / 2;
+    half = (half + ReductionLeaf - 1) / ReductionLeaf * ReductionLeaf;
+    return PairwiseSum<T>(_begin, _begin + half, _term) +
+           PairwiseSum<T>(_begin + half, _end, _term);
+}
+
+/**
+ * @brief Sum _term(i) for i in [0, _size) in parallel
+ *
+ * The summation tree depends only on _size, so the result is bit-identical for
+ * any number of threads.
+ *
+ * @tparam T        Type of term
+ * @tparam F        Type of function
+ * @param _size     Number of terms
+ * @param _term     Function returning each term
+ * @return T        Sum of terms
+ */
+template <class T, class F>
+inline T Reduce(Index _size, const F &_term) {
+    if (_size <= ReductionChunk) {
+        return PairwiseSum<T>(0, _size, _term);
+    }
+    Index numchunks = (_size + ReductionChunk - 1) / ReductionChunk;
+    std::vector<T> partials(numchunks);
+    ParallelFor(0, numchunks, [&](Index _chunk) {
+        Index head = _chunk * ReductionChunk;
+        Index tail = std::min(_size, head + ReductionChunk);
+        partials[_chunk] = PairwiseSum<T>(head, tail, _term);
+    });
+    while (numchunks > 1) {
+        Index half = (numchunks + 1) / 2;
+        for (Index i = 0; i < numchunks / 2; i++) {
+            partials[i] = partials[2 * i] + partials[2 * i + 1];
+        }
+        if (numchunks % 2) {
+            partials[half - 1] = partials[numchunks - 1];
+        }
+        numchunks = half;
+    }
+    return partials[0];
+}
+}  // namespace PANSFE
@@ -0,0 +1,620 @@
+/**
+ * @file reordering.h
+ * @author PANFACTORY (github/PANFACTORY)
+ * @brief Definition and implementation of bandwidth and fill reducing
+ * orderings and permutation of SparseMat and Vec
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#pragma once
+#include <algorithm>
+#include <cassert>
+#include <cstdlib>
+#include <utility>
+#include <vector>
+
+#include "parallel.h"
+#include "profiler.h"
+#include "sparsemat.h"
+#include "vec.h"
+
+namespace PANSFE {
+/**
+ * @brief Get adjacency graph of the pattern of A + A^T without diagonal
+ *
+ * @tparam T        Type of element
+ * @param _mat      Square sparse matrix
+ * @param _xadj     Offset of neighbors of each vertex, size Row() + 1
+ * @param _adj      Sorted neighbors of each vertex
+ */
+template <class T>
+inline void AdjacencyGraph(const SparseMat<T> &_mat, std::vector<int> &_xadj,
+                           std::vector<int> &_adj) {
+    assert(_mat.Row() == _mat.Col());
+    int n = _mat.Row();
+    const std::vector<int> &rowptr = _mat.RowPtr(), &colind = _mat.ColInd();
+    std::vector<int> degree(n, 0);
+    for (int i = 0; i < n; i++) {
+        for (int k = rowptr[i]; k < rowptr[i + 1]; k++) {
+            if (colind[k] != i) {
+                degree[i]++;
+                degree[colind[k]]++;
+            }
+        }
+    }
+    std::vector<int> xadj(n + 1, 0);
+    for (int i = 0; i < n; i++) {
+        xadj[i + 1] = xadj[i] + degree[i];
+    }
+    std::vector<int> adj(xadj[n]), position(xadj.begin(), xadj.end() - 1);
+    for (int i = 0; i < n; i++) {
+        for (int k = rowptr[i]; k < rowptr[i + 1]; k++) {
+            int j = colind[k];
+            if (j != i) {
+                adj[position[i]++] = j;
+                adj[position[j]++] = i;
+            }
+        }
+    }
+    ParallelFor(
+        0, n,
+        [&](int _i) {
+            auto head = adj.begin() + xadj[_i];
+            std::sort(head, adj.begin() + xadj[_i + 1]);
+            degree[_i] = int(
+                std::unique(head, adj.begin() + xadj[_i + 1]) - head);
+        },
+        1024);
+    _xadj.assign(n + 1, 0);
+    for (int i = 0; i < n; i++) {
+        _xadj[i + 1] = _xadj[i] + degree[i];
+    }
+    _adj.resize(_xadj[n]);
+    ParallelFor(
+        0, n,
+        [&](int _i) {
+            std::copy(adj.begin() + xadj[_i],
+                      adj.begin() + xadj[_i] + degree[_i],
+                      _adj.begin() + _xadj[_i]);
+        },
+        1024);
+}
+
+/**
+ * @brief Get inverse of permutation
+ *
+ * @param _perm                     Permutation, _perm[new] = old
+ * @return const std::vector<int>   Inverse permutation, [old] = new
+ */
+inline const std::vector<int> InversePermutation(
+    const std::vector<int> &_perm) {
+    int n = int(_perm.size());
+    std::vector<int> retperm(n, -1);
+    ParallelFor(
+        0, n,
+        [&](int _i) {
+            assert(0 <= _perm[_i] && _perm[_i] < n);
+            retperm[_perm[_i]] = _i;
+        },
+        4096);
+    return retperm;
+}
+
+/**
+ * @brief Check whether _perm is a permutation of 0, ..., size - 1
+ *
+ * @param _perm     Vector of index
+ * @return true     _perm is a permutation
+ * @return false    _perm is not a permutation
+ */
+inline bool IsPermutation(const std::vector<int> &_perm) {
+    int n = int(_perm.size());
+    std::vector<char> seen(n, 0);
+    for (int i : _perm) {
+        if (i < 0 || i >= n || seen[i]) {
+            return false;
+        }
+        seen[i] = 1;
+    }
+    return true;
+}
+
+/**
+ * @brief Get permuted vector y[i] = x[_perm[i]], in parallel
+ *
+ * @tparam T            Type of element
+ * @param _vec          Vector x
+ * @param _perm         Permutation, _perm[new] = old
+ * @return const Vec<T> Permuted vector
+ */
+template <class T>
+inline const Vec<T> Permute(const Vec<T> &_vec, const std::vector<int> &_perm) {
+    assert(_vec.Size() == int(_perm.size()));
+    Vec<T> retvec(_vec.Size());
+    const T *x = _vec.Values();
+    T *y = retvec.Values();
+    ParallelFor(
+        0, _vec.Size(), [&](int _i) { y[_i] = x[_perm[_i]]; }, 4096);
+    return retvec;
+}
+
+/**
+ * @brief Get inversely permuted vector y[_perm[i]] = x[i], in parallel
+ *
+ * @tparam T            Type of element
+ * @param _vec          Vector x
+ * @param _perm         Permutation, _perm[new] = old
+ * @return const Vec<T> Vector in the original order
+ */
+template <class T>
+inline const Vec<T> InversePermute(const Vec<T> &_vec,
+                                   const std::vector<int> &_perm) {
+    assert(_vec.Size() == int(_perm.size()));
+    Vec<T> retvec(_vec.Size());
+    ParallelFor(
+        0, _vec.Size(), [&](int _i) { retvec[_perm[_i]] = _vec[_i]; }, 4096);
+    return retvec;
+}
+
+/**
+ * @brief Get B(i, j) = A(_rowperm[i], _colperm[j]), rows in parallel
+ *
+ * @tparam T                    Type of element
+ * @param _mat                  Sparse matrix A
+ * @param _rowperm              Permutation of row, _rowperm[new] = old
+ * @param _colperm              Permutation of column, _colperm[new] = old
+ * @return const SparseMat<T>   Permuted matrix
+ */
+template <class T>
+inline const SparseMat<T> Permute(const SparseMat<T> &_mat,
+                                  const std::vector<int> &_rowperm,
+                                  const std::vector<int> &_colperm) {
+    PANSFE_PROFILE_SCOPE(
+        "Permute", 0, 2 * (sizeof(T) + sizeof(int)) * double(_mat.NonZeros()));
+    assert(_mat.Row() == int(_rowperm.size()) &&
+           _mat.Col() == int(_colperm.size()));
+    int n = _mat.Row();
+    const std::vector<int> &rowptr = _mat.RowPtr(), &colind = _mat.ColInd();
+    const T *values = _mat.Values();
+    std::vector<int> icolperm = InversePermutation(_colperm);
+    std::vector<int> retrowptr(n + 1, 0);
+    for (int i = 0; i < n; i++) {
+        int k = _rowperm[i];
+        retrowptr[i + 1] = retrowptr[i] + rowptr[k + 1] - rowptr[k];
+    }
+    std::vector<int> retcolind(_mat.NonZeros());
+    std::vector<T> retvalues(_mat.NonZeros());
+    ParallelFor(
+        0, n,
+        [&](int _i) {
+            int head = rowptr[_rowperm[_i]],
+                length = rowptr[_rowperm[_i] + 1] - head;
+            int *cols = retcolind.data() + retrowptr[_i];
+            T *vals = retvalues.data() + retrowptr[_i];
+            for (int k = 0; k < length; k++) {
+                cols[k] = icolperm[colind[head + k]];
+                vals[k] = values[head + k];
+            }
+            if (!std::is_sorted(cols, cols + length)) {
+                std::vector<std::pair<int, T> > entries(length);
+                for (int k = 0; k < length; k++) {
+                    entries[k] = std::make_pair(cols[k], vals[k]);
+                }
+                std::sort(entries.begin(), entries.end(),
+                          [](const std::pair<int, T> &_a,
+                             const std::pair<int, T> &_b) {
+                              return _a.first < _b.first;
+                          });
+                for (int k = 0; k < length; k++) {
+                    cols[k] = entries[k].first;
+                    vals[k] = entries[k].second;
+                }
+            }
+        },
+        256);
+    return SparseMat<T>(_mat.Row(), _mat.Col(), std::move(retrowptr),
+                        std::move(retcolind), std::move(retvalues));
+}
+
+/**
+ * @brief Get symmetrically permuted matrix P A P^T, B(i, j) = A(_perm[i],
+ * _perm[j])
+ *
+ * @tparam T                    Type of element
+ * @param _mat                  Square sparse matrix A
+ * @param _perm                 Permutation, _perm[new] = old
+ * @return const SparseMat<T>   Permuted matrix
+ */
+template <class T>
+inline const SparseMat<T> Permute(const SparseMat<T> &_mat,
+                                  const std::vector<int> &_perm) {
+    return Permute(_mat, _perm, _perm);
+}
+
+/**
+ * @brief Get half bandwidth max |i - j| over stored nonzeros
+ *
+ * @tparam T    Type of element
+ * @param _mat  Sparse matrix
+ * @return int  Half bandwidth
+ */
+template <class T>
+inline int Bandwidth(const SparseMat<T> &_mat) {
+    const std::vector<int> &rowptr = _mat.RowPtr(), &colind = _mat.ColInd();
+    int bandwidth = 0;
+    for (int i = 0; i < _mat.Row(); i++) {
+        for (int k = rowptr[i]; k < rowptr[i + 1]; k++) {
+            bandwidth = std::max(bandwidth, std::abs(i - colind[k]));
+        }
+    }
+    return bandwidth;
+}
+
+/**
+ * @brief Get breadth first level structure from _root over vertices with
+ * _mask[v] == _label
+ *
+ * @param _xadj     Offset of neighbors of each vertex
+ * @param _adj      Neighbors of each vertex
+ * @param _mask     Label of each vertex
+ * @param _label    Label of the vertices to visit
+ * @param _root     Vertex to start
+ * @param _order    Visited vertices in breadth first order
+ * @param _levelptr Offset of each level in _order
+ * @param _level    Work array of size of graph filled with -1, restored
+ */
+inline void LevelStructure(const std::vector<int> &_xadj,
+                           const std::vector<int> &_adj,
+                           const std::vector<int> &_mask, int _label,
+                           int _root, std::vector<int> &_order,
+                           std::vector<int> &_levelptr,
+                           std::vector<int> &_level) {
+    _order.assign(1, _root);
+    _levelptr.assign(1, 0);
+    _level[_root] = 0;
+    for (size_t head = 0; head < _order.size(); head++) {
+        int v = _order[head];
+        if (_level[v] == int(_levelptr.size())) {
+            _levelptr.push_back(int(head));
+        }
+        for (int k = _xadj[v]; k < _xadj[v + 1]; k++) {
+            int w = _adj[k];
+            if (_mask[w] == _label && _level[w] < 0) {
+                _level[w] = _level[v] + 1;
+                _order.push_back(w);
+            }
+        }
+    }
+    _levelptr.push_back(int(_order.size()));
+    for (int v : _order) {
+        _level[v] = -1;
+    }
+}
+
+/**
+ * @brief Find pseudo peripheral vertex by George-Liu algorithm
+ *
+ * @param _xadj     Offset of neighbors of each vertex
+ * @param _adj      Neighbors of each vertex
+ * @param _mask     Label of each vertex
+ * @param _label    Label of the vertices to visit
+ * @param _root     Vertex to start
+ * @param _order    Breadth first order from the found vertex
+ * @param _levelptr Offset of each level in _order
+ * @param _level    Work array of size of graph filled with -1, restored
+ * @return int      Pseudo peripheral vertex
+ */
+inline int PseudoPeripheral(const std::vector<int> &_xadj,
+                            const std::vector<int> &_adj,
+                            const std::vector<int> &_mask, int _label,
+                            int _root, std::vector<int> &_order,
+                            std::vector<int> &_levelptr,
+                            std::vector<int> &_level) {
+    LevelStructure(_xadj, _adj, _mask, _label, _root, _order, _levelptr,
+                   _level);
+    while (true) {
+        int last = _levelptr[_levelptr.size() - 2], next = _order[last];
+        for (int k = last; k < int(_order.size()); k++) {
+            int v = _order[k];
+            if (_xadj[v + 1] - _xadj[v] < _xadj[next + 1] - _xadj[next]) {
+                next = v;
+            }
+        }
+        std::vector<int> order, levelptr;
+        LevelStructure(_xadj, _adj, _mask, _label, next, order, levelptr,
+                       _level);
+        if (levelptr.size() <= _levelptr.size()) {
+            return _root;
+        }
+        _root = next;
+        _order.swap(order);
+        _levelptr.swap(levelptr);
+    }
+}
+
+/**
+ * @brief Get Reverse Cuthill-McKee ordering reducing bandwidth of A + A^T
+ *
+ * @tparam T                        Type of element
+ * @param _mat                      Square sparse matrix
+ * @return const std::vector<int>   Permutation, [new] = old
+ */
+template <class T>
+inline const std::vector<int> ReverseCuthillMcKee(const SparseMat<T> &_mat) {
+    PANSFE_PROFILE_SCOPE("ReverseCuthillMcKee", 0, 0);
+    std::vector<int> xadj, adj;
+    AdjacencyGraph(_mat, xadj, adj);
+    int n = _mat.Row();
+    std::vector<int> mask(n, 0), level(n, -1), order, levelptr, retperm;
+    retperm.reserve(n);
+    for (int s = 0; s < n; s++) {
+        if (mask[s] != 0) {
+            continue;
+        }
+        int root = PseudoPeripheral(xadj, adj, mask, 0, s, order, levelptr,
+                                    level);
+        size_t head = retperm.size();
+        retperm.push_back(root);
+        mask[root] = 1;
+        for (; head < retperm.size(); head++) {
+            int v = retperm[head];
+            size_t tail = retperm.size();
+            for (int k = xadj[v]; k < xadj[v + 1]; k++) {
+                if (mask[adj[k]] == 0) {
+                    mask[adj[k]] = 1;
+                    retperm.push_back(adj[k]);
+                }
+            }
+            std::sort(retperm.begin() + tail, retperm.end(),
+                      [&](int _a, int _b) {
+                          int da = xadj[_a + 1] - xadj[_a],
+                              db = xadj[_b + 1] - xadj[_b];
+                          return da < db || (da == db && _a < _b);
+                      });
+        }
+    }
+    std::reverse(retperm.begin(), retperm.end());
+    return retperm;
+}
+
+/**
+ * @brief Get approximate minimum degree ordering reducing fill of Cholesky
+ * factorization of A + A^T
+ *
+ * Elimination runs on the quotient graph, each eliminated vertex becomes an
+ * element absorbing its adjacent elements, and degree is bounded by the
+ * approximate external degree of Amestoy, Davis and Duff.
+ *
+ * @tparam T                        Type of element
+ * @param _mat                      Square sparse matrix
+ * @return const std::vector<int>   Permutation, [new] = old
+ */
+template <class T>
+inline const std::vector<int> ApproximateMinimumDegree(
+    const SparseMat<T> &_mat) {
+    PANSFE_PROFILE_SCOPE("ApproximateMinimumDegree", 0, 0);
+    std::vector<int> xadj, adj;
+    AdjacencyGraph(_mat, xadj, adj);
+    int n = _mat.Row();
+    std::vector<std::vector<int> > variables(n), elements(n), members(n);
+    std::vector<int> degree(n), head(n + 1, -1), next(n, -1), prev(n, -1),
+        weight(n, -1), mark(n, -1);
+    std::vector<char> eliminated(n, 0);
+    auto insert = [&](int _v) {
+        int d = degree[_v];
+        prev[_v] = -1;
+        next[_v] = head[d];
+        if (head[d] >= 0) {
+            prev[head[d]] = _v;
+        }
+        head[d] = _v;
+    };
+    auto remove = [&](int _v) {
+        if (prev[_v] >= 0) {
+            next[prev[_v]] = next[_v];
+        } else {
+            head[degree[_v]] = next[_v];
+        }
+        if (next[_v] >= 0) {
+            prev[next[_v]] = prev[_v];
+        }
+    };
+    for (int i = 0; i < n; i++) {
+        variables[i].assign(adj.begin() + xadj[i], adj.begin() + xadj[i + 1]);
+        degree[i] = int(variables[i].size());
+        insert(i);
+    }
+
+    std::vector<int> retperm;
+    retperm.reserve(n);
+    int mindegree = 0;
+    for (int k = 0; k < n; k++) {
+        while (head[mindegree] < 0) {
+            mindegree++;
+        }
+        int p = head[mindegree];
+        remove(p);
+        eliminated[p] = 1;
+        retperm.push_back(p);
+
+        std::vector<int> &boundary = members[p];
+        mark[p] = p;
+        for (int v : variables[p]) {
+            if (mark[v] != p) {
+                mark[v] = p;
+                boundary.push_back(v);
+            }
+        }
+        for (int e : elements[p]) {
+            for (int v : members[e]) {
+                if (!eliminated[v] && mark[v] != p) {
+                    mark[v] = p;
+                    boundary.push_back(v);
+                }
+            }
+            std::vector<int>().swap(members[e]);
+        }
+        std::vector<int> absorbed;
+        absorbed.swap(elements[p]);
+        std::vector<int>().swap(variables[p]);
+        for (int e : absorbed) {
+            mark[e] = p;
+        }
+
+        for (int i : boundary) {
+            std::vector<int> &ev = elements[i];
+            ev.erase(std::remove_if(ev.begin(), ev.end(),
+                                    [&](int _e) { return mark[_e] == p; }),
+                     ev.end());
+            ev.push_back(p);
+            std::vector<int> &av = variables[i];
+            av.erase(std::remove_if(av.begin(), av.end(),
+                                    [&](int _v) { return mark[_v] == p; }),
+                     av.end());
+        }
+        for (int e : absorbed) {
+            mark[e] = -1;
+        }
+
+        for (int i : boundary) {
+            for (int e : elements[i]) {
+                if (e != p) {
+                    if (weight[e] < 0) {
+                        weight[e] = int(members[e].size());
+                    }
+                    weight[e]--;
+                }
+            }
+        }
+        int size = int(boundary.size());
+        for (int i : boundary) {
+            int d = int(variables[i].size()) + size - 1;
+            for (int e : elements[i]) {
+                if (e != p) {
+                    d += weight[e];
+                }
+            }
+            d = std::min(d, std::min(n - k - 2, degree[i] + size - 1));
+            remove(i);
+            degree[i] = std::max(d, 0);
+            insert(i);
+            mindegree = std::min(mindegree, degree[i]);
+        }
+        for (int i : boundary) {
+            for (int e : elements[i]) {
+                weight[e] = -1;
+            }
+        }
+    }
+    return retperm;
+}
+
+/**
+ * @brief Get nested dissection ordering reducing fill of Cholesky
+ * factorization of A + A^T
+ *
+ * The graph is recursively split at the middle level of a breadth first level
+ * structure from a pseudo peripheral vertex, each separator is numbered after
+ * both parts, and parts not larger than _leafsize keep Reverse Cuthill-McKee
+ * like breadth first order.
+ *
+ * @tparam T                        Type of element
+ * @param _mat                      Square sparse matrix
+ * @param _leafsize                 Largest part not split further
+ * @return const std::vector<int>   Permutation, [new] = old
+ */
+template <class T>
+inline const std::vector<int> NestedDissection(const SparseMat<T> &_mat,
+                                               int _leafsize = 64) {
+    PANSFE_PROFILE_SCOPE("NestedDissection", 0, 0);
+    assert(_leafsize > 0);
+    std::vector<int> xadj, adj;
+    AdjacencyGraph(_mat, xadj, adj);
+    int n = _mat.Row();
+    std::vector<int> retperm(n), mask(n, 0), level(n, -1), order, levelptr;
+    struct Part {
+        std::vector<int> vertices;
+        int head, label;
+    };
+    std::vector<Part> stack;
+    std::vector<int> all(n);
+    for (int i = 0; i < n; i++) {
+        all[i] = i;
+    }
+    int labels = 0;
+    stack.push_back(Part{std::move(all), 0, labels++});
+    while (!stack.empty()) {
+        Part part = std::move(stack.back());
+        stack.pop_back();
+        int size = int(part.vertices.size());
+        if (size == 0) {
+            continue;
+        }
+        PseudoPeripheral(xadj, adj, mask, part.label, part.vertices[0], order,
+                         levelptr, level);
+        int numlevels = int(levelptr.size()) - 1;
+        if (size <= _leafsize) {
+            std::copy(order.begin(), order.end(), retperm.begin() + part.head);
+            if (int(order.size()) < size) {
+                for (int v : order) {
+                    mask[v] = -1;
+                }
+                std::vector<int> rest;
+                for (int v : part.vertices) {
+                    if (mask[v] == part.label) {
+                        rest.push_back(v);
+                    }
+                }
+                stack.push_back(Part{std::move(rest),
+                                     part.head + int(order.size()),
+                                     part.label});
+            }
+            continue;
+        }
+
+        std::vector<int> first, second, separator;
+        if (int(order.size()) < size) {
+            int label = labels++;
+            for (int v : order) {
+                mask[v] = label;
+            }
+            first = order;
+            for (int v : part.vertices) {
+                if (mask[v] == part.label) {
+                    second.push_back(v);
+                }
+            }
+        } else if (numlevels < 3) {
+            std::copy(order.begin(), order.end(), retperm.begin() + part.head);
+            continue;
+        } else {
+            int middle = 1;
+            while (middle < numlevels - 2 && levelptr[middle + 1] < size / 2) {
+                middle++;
+            }
+            first.assign(order.begin(), order.begin() + levelptr[middle]);
+            separator.assign(order.begin() + levelptr[middle],
+                             order.begin() + levelptr[middle + 1]);
+            second.assign(order.begin() + levelptr[middle + 1], order.end());
+            int label = labels++;
+            for (int v : first) {
+                mask[v] = label;
+            }
+            for (int v : separator) {
+                mask[v] = -1;
+            }
+        }
+        std::copy(separator.begin(), separator.end(),
+                  retperm.begin() + part.head + size - separator.size());
+        int firstlabel = mask[first[0]];
+        int secondhead = part.head + int(first.size());
+        stack.push_back(Part{std::move(second), secondhead, part.label});
+        stack.push_back(Part{std::move(first), part.head, firstlabel});
+    }
+    return retperm;
+}
+}  // namespace PANSFE
@@ -0,0 +1,591 @@
+/**
+ * @file sparsecholesky.h
+ * @author PANFACTORY (github/PANFACTORY)
+ * @brief Definition and implementation of supernodal sparse Cholesky
+ * factorization
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#pragma once
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <vector>
+
+#include "mat.h"
+#include "parallel.h"
+#include "profiler.h"
+#include "reordering.h"
+#include "sparsemat.h"
+#include "strassen.h"
+#include "vec.h"
+
+namespace PANSFE {
+/**
+ * @brief Supernodal sparse Cholesky factorization P A P^T = L L^T for
+ * symmetric positive definite sparse matrix
+ *
+ * Analyze computes a postordered elimination tree, supernodes relaxed to admit
+ * a few explicit zeros and the row structure of each supernode, which
+ * Factorize reuses for any matrix with the same pattern. Each supernode is a
+ * dense column-major panel updated by its descendants and factorized by dense
+ * kernels, and supernodes of the same height in the supernodal elimination
+ * tree are factorized in parallel.
+ *
+ * @tparam T Type of element
+ */
+template <class T>
+class SparseCholesky {
+   public:
+    /**
+     * @brief Construct a new empty SparseCholesky object
+     *
+     */
+    SparseCholesky() : size(0), definite(false), supernodeptr(1, 0) {}
+
+    /**
+     * @brief Construct a new SparseCholesky object ordered by approximate
+     * minimum degree and factorize
+     *
+     * @param _a    Symmetric positive definite sparse matrix
+     */
+    explicit SparseCholesky(const SparseMat<T> &_a)
+        : SparseCholesky(_a, ApproximateMinimumDegree(_a)) {}
+
+    /**
+     * @brief Construct a new SparseCholesky object with given ordering and
+     * factorize
+     *
+     * @param _a    Symmetric positive definite sparse matrix
+     * @param _perm Fill reducing permutation, _perm[new] = old
+     */
+    SparseCholesky(const SparseMat<T> &_a, const std::vector<int> &_perm)
+        : SparseCholesky() {
+        this->Analyze(_a, _perm);
+        this->Factorize(_a);
+    }
+
+    /**
+     * @brief Symbolic analysis of the pattern of _a
+     *
+     * @param _a    Symmetric sparse matrix
+     * @param _perm Fill reducing permutation, _perm[new] = old
+     */
+    void Analyze(const SparseMat<T> &_a, const std::vector<int> &_perm) {
+        PANSFE_PROFILE_SCOPE("SparseCholesky::Analyze", 0, 0);
+        assert(_a.Row() == _a.Col() && int(_perm.size()) == _a.Row());
+        assert(IsPermutation(_perm));
+        int n = _a.Row();
+        this->size = n;
+        this->definite = false;
+        std::vector<int> parent = EliminationTree(Permute(_a, _perm));
+
+        std::vector<int> head(n, -1), next(n, -1), post;
+        post.reserve(n);
+        for (int j = n - 1; j >= 0; j--) {
+            if (parent[j] >= 0) {
+                next[j] = head[parent[j]];
+                head[parent[j]] = j;
+            }
+        }
+        std::vector<int> stack;
+        for (int root = 0; root < n; root++) {
+            if (parent[root] >= 0) {
+                continue;
+            }
+            stack.push_back(root);
+            while (!stack.empty()) {
+                int j = stack.back();
+                if (head[j] >= 0) {
+                    int child = head[j];
+                    head[j] = next[child];
+                    stack.push_back(child);
+                } else {
+                    stack.pop_back();
+                    post.push_back(j);
+                }
+            }
+        }
+        this->perm.resize(n);
+        for (int k = 0; k < n; k++) {
+            this->perm[k] = _perm[post[k]];
+        }
+        SparseMat<T> c = Permute(_a, this->perm);
+        parent = EliminationTree(c);
+        const std::vector<int> &rowptr = c.RowPtr(), &colind = c.ColInd();
+
+        std::vector<int> count(n, 1), mark(n, -1), children(n, 0);
+        for (int i = 0; i < n; i++) {
+            mark[i] = i;
+            for (int k = rowptr[i]; k < rowptr[i + 1] && colind[k] < i; k++) {
+                for (int j = colind[k]; mark[j] != i; j = parent[j]) {
+                    count[j]++;
+                    mark[j] = i;
+                }
+            }
+            if (parent[i] >= 0) {
+                children[parent[i]]++;
+            }
+        }
+
+        std::vector<int> fundamental(1, 0);
+        for (int j = 1; j <= n; j++) {
+            if (j == n || parent[j - 1] != j || count[j - 1] != count[j] + 1 ||
+                children[j] != 1) {
+                fundamental.push_back(j);
+            }
+        }
+        this->supernodeptr.assign(1, 0);
+        std::vector<int> expected;
+        long long zeros = 0;
+        for (size_t f = 0; f + 1 < fundamental.size(); f++) {
+            int first = this->supernodeptr.back(), last = fundamental[f + 1];
+            if (first == fundamental[f]) {
+                expected.push_back(count[first]);
+                zeros = 0;
+            } else {
+                int ncols = fundamental[f] - first;
+                int pcols = last - fundamental[f];
+                int nrows = expected.back(), prows = count[fundamental[f]];
+                long long merged = zeros +
+                                   Entries(ncols + pcols, ncols + prows) -
+                                   Entries(ncols, nrows) -
+                                   Entries(pcols, prows);
+                double fraction =
+                    double(merged) / Entries(ncols + pcols, ncols + prows);
+                int width = ncols + pcols;
+                if (parent[fundamental[f] - 1] == fundamental[f] &&
+                    (width <= 4 || (width <= 16 && fraction <= 0.8) ||
+                     (width <= 48 && fraction <= 0.1))) {
+                    expected.back() = ncols + prows;
+                    zeros = merged;
+                } else {
+                    this->supernodeptr.push_back(fundamental[f]);
+                    expected.push_back(count[fundamental[f]]);
+                    zeros = 0;
+                }
+            }
+        }
+        if (n > 0) {
+            this->supernodeptr.push_back(n);
+        }
+        int ns = this->Supernodes();
+        std::vector<int> supernode(n), snparent(ns, -1);
+        for (int s = 0; s < ns; s++) {
+            for (int j = this->supernodeptr[s]; j < this->supernodeptr[s + 1];
+                 j++) {
+                supernode[j] = s;
+            }
+        }
+        for (int s = 0; s < ns; s++) {
+            int last = this->supernodeptr[s + 1] - 1;
+            if (parent[last] >= 0) {
+                snparent[s] = supernode[parent[last]];
+            }
+        }
+
+        std::vector<std::vector<int> > snchildren(ns);
+        for (int s = 0; s < ns; s++) {
+            if (snparent[s] >= 0) {
+                snchildren[snparent[s]].push_back(s);
+            }
+        }
+        this->rowptr.assign(ns + 1, 0);
+        this->rowind.clear();
+        std::fill(mark.begin(), mark.end(), -1);
+        for (int s = 0; s < ns; s++) {
+            int first = this->supernodeptr[s], last = this->supernodeptr[s + 1];
+            for (int j = first; j < last; j++) {
+                this->rowind.push_back(j);
+                mark[j] = s;
+            }
+            size_t below = this->rowind.size();
+            for (int j = first; j < last; j++) {
+                for (int k = rowptr[j + 1] - 1;
+                     k >= rowptr[j] && colind[k] >= last; k--) {
+                    if (mark[colind[k]] != s) {
+                        mark[colind[k]] = s;
+                        this->rowind.push_back(colind[k]);
+                    }
+                }
+            }
+            for (int child : snchildren[s]) {
+                for (int k = this->rowptr[child]; k < this->rowptr[child + 1];
+                     k++) {
+                    int r = this->rowind[k];
+                    if (r >= last && mark[r] != s) {
+                        mark[r] = s;
+                        this->rowind.push_back(r);
+                    }
+                }
+            }
+            std::sort(this->rowind.begin() + below, this->rowind.end());
+            this->rowptr[s + 1] = int(this->rowind.size());
+            assert(this->Rows(s) == expected[s]);
+        }
+
+        this->valueptr.assign(ns + 1, 0);
+        for (int s = 0; s < ns; s++) {
+            this->valueptr[s + 1] =
+                this->valueptr[s] + (long long)this->Rows(s) * this->Cols(s);
+        }
+
+        std::vector<int> last(ns, -1);
+        this->updateptr.assign(ns + 1, 0);
+        for (int pass = 0; pass < 2; pass++) {
+            std::fill(last.begin(), last.end(), -1);
+            std::vector<int> position(this->updateptr.begin(),
+                                      this->updateptr.end() - 1);
+            for (int d = 0; d < ns; d++) {
+                for (int k = this->rowptr[d] + this->Cols(d);
+                     k < this->rowptr[d + 1]; k++) {
+                    int s = supernode[this->rowind[k]];
+                    if (last[s] != d) {
+                        last[s] = d;
+                        if (pass == 0) {
+                            this->updateptr[s + 1]++;
+                        } else {
+                            this->updateind[position[s]++] = d;
+                        }
+                    }
+                }
+            }
+            if (pass == 0) {
+                for (int s = 0; s < ns; s++) {
+                    this->updateptr[s + 1] += this->updateptr[s];
+                }
+                this->updateind.resize(this->updateptr[ns]);
+            }
+        }
+
+        std::vector<int> height(ns, 0);
+        int numlevels = ns > 0 ? 1 : 0;
+        for (int s = 0; s < ns; s++) {
+            if (snparent[s] >= 0) {
+                height[snparent[s]] =
+                    std::max(height[snparent[s]], height[s] + 1);
+            }
+            numlevels = std::max(numlevels, height[s] + 1);
+        }
+        this->levelptr.assign(numlevels + 1, 0);
+        for (int s = 0; s < ns; s++) {
+            this->levelptr[height[s] + 1]++;
+        }
+        for (int l = 0; l < numlevels; l++) {
+            this->levelptr[l + 1] += this->levelptr[l];
+        }
+        std::vector<int> position(this->levelptr.begin(),
+                                  this->levelptr.end() - 1);
+        this->levelorder.resize(ns);
+        for (int s = 0; s < ns; s++) {
+            this->levelorder[position[height[s]]++] = s;
+        }
+        this->values.clear();
+    }
+
+    /**
+     * @brief Numeric factorization reusing the symbolic analysis, _a must have
+     * the pattern given to Analyze
+     *
+     * @param _a        Symmetric sparse matrix
+     * @return true     _a is positive definite
+     * @return false    Some pivot is not positive, the factor is not valid
+     */
+    bool Factorize(const SparseMat<T> &_a) {
+        PANSFE_PROFILE_SCOPE("SparseCholesky::Factorize", 0, 0);
+        assert(_a.Row() == this->size && _a.Col() == this->size);
+        int ns = this->Supernodes();
+        SparseMat<T> c = Permute(_a, this->perm);
+        const std::vector<int> &rowptr = c.RowPtr(), &colind = c.ColInd();
+        const T *cvalues = c.Values();
+        this->values.assign(this->valueptr[ns], T());
+        ParallelFor(
+            0, ns,
+            [&](int _s) {
+                const int *rows = this->rowind.data() + this->rowptr[_s];
+                int first = this->supernodeptr[_s], nrows = this->Rows(_s);
+                T *panel = this->values.data() + this->valueptr[_s];
+                for (int j = first; j < this->supernodeptr[_s + 1]; j++) {
+                    for (int k = rowptr[j + 1] - 1;
+                         k >= rowptr[j] && colind[k] >= j; k--) {
+                        int r = int(std::lower_bound(rows, rows + nrows,
+                                                     colind[k]) -
+                                    rows);
+                        assert(r < nrows && rows[r] == colind[k]);
+                        panel[r + (long long)(j - first) * nrows] = cvalues[k];
+                    }
+                }
+            },
+            64);
+
+        std::vector<char> positive(ns, 1);
+        for (int l = 0; l + 1 < int(this->levelptr.size()); l++) {
+            ParallelFor(this->levelptr[l], this->levelptr[l + 1], [&](int _k) {
+                int s = this->levelorder[_k];
+                std::vector<T> update, packed;
+                std::vector<int> relative;
+                for (int u = this->updateptr[s]; u < this->updateptr[s + 1];
+                     u++) {
+                    this->UpdateFrom(this->updateind[u], s, update, packed,
+                                     relative);
+                }
+                positive[s] = this->FactorizePanel(s, update, packed);
+            });
+        }
+        this->definite = std::find(positive.begin(), positive.end(), 0) ==
+                         positive.end();
+        return this->definite;
+    }
+
+    /**
+     * @brief Get size of the matrix
+     *
+     * @return int  Size of the matrix
+     */
+    int Size() const { return this->size; }
+
+    /**
+     * @brief Get number of supernodes
+     *
+     * @return int  Number of supernodes
+     */
+    int Supernodes() const { return int(this->supernodeptr.size()) - 1; }
+
+    /**
+     * @brief Get number of nonzeros of L
+     *
+     * @return long long    Number of nonzeros of L
+     */
+    long long NonZeros() const {
+        long long nonzeros = 0;
+        for (int s = 0; s < this->Supernodes(); s++) {
+            nonzeros += Entries(this->Cols(s), this->Rows(s));
+        }
+        return nonzeros;
+    }
+
+    /**
+     * @brief Get permutation including the postorder of elimination tree
+     *
+     * @return const std::vector<int>&  Permutation, [new] = old
+     */
+    const std::vector<int> &Permutation() const { return this->perm; }
+
+    /**
+     * @brief Check whether the last Factorize succeeded
+     *
+     * @return true     Matrix is positive definite
+     * @return false    Matrix is not positive definite or not factorized
+     */
+    bool IsPositiveDefinite() const { return this->definite; }
+
+    /**
+     * @brief Solve A x = _x in place
+     *
+     * @param _x    Right hand side on input and solution on output
+     */
+    void SolveInPlace(Vec<T> &_x) const {
+        PANSFE_PROFILE_SCOPE("SparseCholesky::Solve",
+                             4.0 * this->values.size(),
+                             sizeof(T) * 2.0 * this->values.size());
+        assert(_x.Size() == this->size && !this->values.empty());
+        Vec<T> y = Permute(_x, this->perm);
+        for (int s = 0; s < this->Supernodes(); s++) {
+            const int *rows = this->rowind.data() + this->rowptr[s];
+            const T *panel = this->values.data() + this->valueptr[s];
+            int first = this->supernodeptr[s], nrows = this->Rows(s);
+            for (int c = 0; c < this->Cols(s); c++) {
+                const T *column = panel + (long long)c * nrows;
+                T yc = y[first + c] / column[c];
+                y[first + c] = yc;
+                for (int r = c + 1; r < nrows; r++) {
+                    y[rows[r]] -= column[r] * yc;
+                }
+            }
+        }
+        for (int s = this->Supernodes() - 1; s >= 0; s--) {
+            const int *rows = this->rowind.data() + this->rowptr[s];
+            const T *panel = this->values.data() + this->valueptr[s];
+            int first = this->supernodeptr[s], nrows = this->Rows(s);
+            for (int c = this->Cols(s) - 1; c >= 0; c--) {
+                const T *column = panel + (long long)c * nrows;
+                T sum = y[first + c];
+                for (int r = c + 1; r < nrows; r++) {
+                    sum -= column[r] * y[rows[r]];
+                }
+                y[first + c] = sum / column[c];
+            }
+        }
+        _x = InversePermute(y, this->perm);
+    }
+
+    /**
+     * @brief Solve A x = _b
+     *
+     * @param _b            Right hand side
+     * @return const Vec<T> Solution
+     */
+    const Vec<T> Solve(const Vec<T> &_b) const {
+        Vec<T> retvec = _b;
+        this->SolveInPlace(retvec);
+        return retvec;
+    }
+
+    /**
+     * @brief Solve A X = _b for every column of _b, columns in parallel
+     *
+     * @param _b            Right hand sides as columns
+     * @return const Mat<T> Solutions as columns
+     */
+    const Mat<T> Solve(const Mat<T> &_b) const {
+        assert(_b.Row() == this->size);
+        Mat<T> retmat(_b.Row(), _b.Col());
+        T *x = retmat.Values();
+        ParallelFor(0, _b.Col(), [&](int _j) {
+            Vec<T> column(_b.Row());
+            for (int i = 0; i < _b.Row(); i++) {
+                column[i] = _b[i][_j];
+            }
+            this->SolveInPlace(column);
+            for (int i = 0; i < _b.Row(); i++) {
+                x[_b.Col() * i + _j] = column[i];
+            }
+        });
+        return retmat;
+    }
+
+   private:
+    static const int BlockSize = 64, SyrkBlockSize = 16;
+
+    int size;
+    bool definite;
+    std::vector<int> perm, supernodeptr, rowptr, rowind, updateptr, updateind,
+        levelptr, levelorder;
+    std::vector<long long> valueptr;
+    std::vector<T> values;
+
+    int Cols(int _s) const {
+        return this->supernodeptr[_s + 1] - this->supernodeptr[_s];
+    }
+
+    int Rows(int _s) const { return this->rowptr[_s + 1] - this->rowptr[_s]; }
+
+    static long long Entries(long long _ncols, long long _nrows) {
+        return _ncols * _nrows - _ncols * (_ncols - 1) / 2;
+    }
+
+    static std::vector<int> EliminationTree(const SparseMat<T> &_c) {
+        int n = _c.Row();
+        const std::vector<int> &rowptr = _c.RowPtr(), &colind = _c.ColInd();
+        std::vector<int> parent(n, -1), ancestor(n, -1);
+        for (int i = 0; i < n; i++) {
+            for (int k = rowptr[i]; k < rowptr[i + 1] && colind[k] < i; k++) {
+                int r = colind[k];
+                while (ancestor[r] >= 0 && ancestor[r] != i) {
+                    int next = ancestor[r];
+                    ancestor[r] = i;
+                    r = next;
+                }
+                if (ancestor[r] < 0) {
+                    ancestor[r] = i;
+                    parent[r] = i;
+                }
+            }
+        }
+        return parent;
+    }
+
+    void UpdateFrom(int _d, int _s, std::vector<T> &_update,
+                    std::vector<T> &_packed, std::vector<int> &_relative) {
+        const int *drows = this->rowind.data() + this->rowptr[_d],
+                  *srows = this->rowind.data() + this->rowptr[_s];
+        int dn = this->Rows(_d), dc = this->Cols(_d), sn = this->Rows(_s);
+        int first = this->supernodeptr[_s], last = this->supernodeptr[_s + 1];
+        int p = int(std::lower_bound(drows + dc, drows + dn, first) - drows);
+        int q = int(std::lower_bound(drows + p, drows + dn, last) - drows);
+        int m = dn - p, w = q - p;
+        const T *dpanel = this->values.data() + this->valueptr[_d];
+        _update.resize((size_t)m * w);
+        Syrk(dpanel + p, dn, w, m, dc, _update.data(), _packed);
+        _relative.resize(m);
+        for (int r = 0, t = 0; r < m; r++) {
+            while (srows[t] != drows[p + r]) {
+                t++;
+            }
+            _relative[r] = t;
+        }
+        T *spanel = this->values.data() + this->valueptr[_s];
+        for (int c = 0; c < w; c++) {
+            T *column = spanel + (long long)(drows[p + c] - first) * sn;
+            const T *source = _update.data() + (size_t)c * m;
+            for (int r = c; r < m; r++) {
+                column[_relative[r]] -= source[r];
+            }
+        }
+    }
+
+    bool FactorizePanel(int _s, std::vector<T> &_update,
+                        std::vector<T> &_packed) {
+        int nrows = this->Rows(_s), ncols = this->Cols(_s);
+        T *panel = this->values.data() + this->valueptr[_s];
+        bool positive = true;
+        for (int head = 0; head < ncols; head += BlockSize) {
+            int tail = std::min(ncols, head + BlockSize);
+            for (int j = head; j < tail; j++) {
+                T *column = panel + (long long)j * nrows;
+                if (!(column[j] > T())) {
+                    positive = false;
+                    column[j] = T(1);
+                }
+                T diagonal = std::sqrt(column[j]);
+                column[j] = diagonal;
+                for (int r = j + 1; r < nrows; r++) {
+                    column[r] /= diagonal;
+                }
+                for (int k = j + 1; k < tail; k++) {
+                    T *target = panel + (long long)k * nrows;
+                    T factor = column[k];
+                    for (int r = k; r < nrows; r++) {
+                        target[r] -= column[r] * factor;
+                    }
+                }
+            }
+            if (tail < ncols) {
+                int m = nrows - tail, w = ncols - tail;
+                _update.resize((size_t)m * w);
+                Syrk(panel + (long long)head * nrows + tail, nrows, w, m,
+                     tail - head, _update.data(), _packed);
+                for (int c = 0; c < w; c++) {
+                    T *target = panel + (long long)(tail + c) * nrows + tail;
+                    const T *source = _update.data() + (size_t)c * m;
+                    for (int r = c; r < m; r++) {
+                        target[r] -= source[r];
+                    }
+                }
+            }
+        }
+        return positive;
+    }
+
+    static void Syrk(const T *_panel, int _ld, int _w, int _m, int _k,
+                     T *_update, std::vector<T> &_packed) {
+        _packed.resize((size_t)_w * _k);
+        for (int c = 0; c < _w; c++) {
+            for (int j = 0; j < _k; j++) {
+                _packed[(size_t)c * _k + j] = _panel[(long long)j * _ld + c];
+            }
+        }
+        for (int head = 0; head < _w; head += SyrkBlockSize) {
+            int width = std::min(_w, head + SyrkBlockSize) - head;
+            GemmKernel<T>(width, _m - head, _k,
+                          _packed.data() + (size_t)head * _k, _k,
+                          _panel + head, _ld,
+                          _update + (size_t)head * _m + head, _m);
+        }
+    }
+};
+}  // namespace PANSFE
@@ -0,0 +1,376 @@
+/**
+ * @file sparsemat.h
+ * @author PANFACTORY (github/PANFACTORY)
+ * @brief Definition and implementation of compressed sparse row matrix class
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#pragma once
+#include <algorithm>
+#include <cassert>
+#include <utility>
+#include <vector>
+
+#include "mat.h"
+#include "parallel.h"
+#include "profiler.h"
+#include "vec.h"
+
+namespace PANSFE {
+/**
+ * @brief Sparse matrix class in compressed sparse row (CSR) format
+ *
+ * Column indices of each row are kept sorted.
+ *
+ * @tparam T Type of element
+ */
+template <class T>
+class SparseMat {
+   public:
+    /**
+     * @brief Construct a new SparseMat object whose row and column are zero
+     *
+     */
+    SparseMat() : row(0), col(0), rowptr(1, 0) {}
+
+    /**
+     * @brief Construct a new SparseMat object without nonzero
+     *
+     * @param _row  Row of the SparseMat object
+     * @param _col  Column of the SparseMat object
+     */
+    SparseMat(int _row, int _col) : row(_row), col(_col), rowptr(_row + 1, 0) {}
+
+    /**
+     * @brief Construct a new SparseMat object from CSR arrays
+     *
+     * @param _row      Row of the SparseMat object
+     * @param _col      Column of the SparseMat object
+     * @param _rowptr   Offset of each row, size _row + 1
+     * @param _colind   Sorted column index of each nonzero in a row
+     * @param _values   Value of each nonzero
+     */
+    SparseMat(int _row, int _col, std::vector<int> _rowptr,
+              std::vector<int> _colind, std::vector<T> _values)
+        : row(_row),
+          col(_col),
+          rowptr(std::move(_rowptr)),
+          colind(std::move(_colind)),
+          values(std::move(_values)) {
+        assert(int(this->rowptr.size()) == this->row + 1);
+        assert(this->colind.size() == this->values.size() &&
+               int(this->colind.size()) == this->rowptr[this->row]);
+    }
+
+    /**
+     * @brief Construct a new SparseMat object from nonzeros of _mat
+     *
+     * @param _mat  Dense matrix
+     */
+    explicit SparseMat(const Mat<T> &_mat)
+        : row(_mat.Row()), col(_mat.Col()), rowptr(_mat.Row() + 1, 0) {
+        for (int i = 0; i < this->row; i++) {
+            for (int j = 0; j < this->col; j++) {
+                if (_mat[i][j] != T()) {
+                    this->colind.push_back(j);
+                    this->values.push_back(_mat[i][j]);
+                }
+            }
+            this->rowptr[i + 1] = int(this->colind.size());
+        }
+    }
+
+    /**
+     * @brief Get number of row
+     *
+     * @return int  Number of row
+     */
+    int Row() const { return this->row; }
+
+    /**
+     * @brief Get number of column
+     *
+     * @return int  Number of column
+     */
+    int Col() const { return this->col; }
+
+    /**
+     * @brief Get number of stored nonzeros
+     *
+     * @return int  Number of stored nonzeros
+     */
+    int NonZeros() const { return this->rowptr[this->row]; }
+
+    /**
+     * @brief Get offset of each row
+     *
+     * @return const std::vector<int>&  Offset of each row
+     */
+    const std::vector<int> &RowPtr() const { return this->rowptr; }
+
+    /**
+     * @brief Get column index of each nonzero
+     *
+     * @return const std::vector<int>&  Column index of each nonzero
+     */
+    const std::vector<int> &ColInd() const { return this->colind; }
+
+    /**
+     * @brief Get pointer indicating value of each nonzero
+     *
+     * @return T*   Pointer indicating value
+     */
+    T *Values() { return this->values.data(); }
+
+    /**
+     * @brief Get pointer indicating value of each nonzero
+     *
+     * @return const T* Pointer indicating value
+     */
+    const T *Values() const { return this->values.data(); }
+
+    /**
+     * @brief Get (_i, _j) element value, zero if not stored
+     *
+     * @param _i    Index of row
+     * @param _j    Index of column
+     * @return T    (_i, _j) element value
+     */
+    T operator()(int _i, int _j) const {
+        assert(0 <= _i && _i < this->row && 0 <= _j && _j < this->col);
+        const int *head = this->colind.data() + this->rowptr[_i],
+                  *tail = this->colind.data() + this->rowptr[_i + 1];
+        const int *found = std::lower_bound(head, tail, _j);
+        return found != tail && *found == _j
+                   ? this->values[found - this->colind.data()]
+                   : T();
+    }
+
+    /**
+     * @brief Check the same
+     *
+     * @param _mat      Comparison
+     * @return true     Same with _mat
+     * @return false    Not the same
+     */
+    bool operator==(const SparseMat<T> &_mat) const {
+        return this->row == _mat.row && this->col == _mat.col &&
+               this->rowptr == _mat.rowptr && this->colind == _mat.colind &&
+               this->values == _mat.values;
+    }
+
+    /**
+     * @brief Check not the same
+     *
+     * @param _mat      Comparison
+     * @return true     Not the same
+     * @return false    Same with _mat
+     */
+    bool operator!=(const SparseMat<T> &_mat) const {
+        return !(*this == _mat);
+    }
+
+    /**
+     * @brief Get sparse matrix vector product (SpMV), rows in parallel
+     *
+     * @param _vec          Vector used matrix vector product
+     * @return const Vec<T> Vector from matrix vector product
+     */
+    const Vec<T> operator*(const Vec<T> &_vec) const {
+        Vec<T> retvec(this->row);
+        this->Apply(_vec, retvec);
+        return retvec;
+    }
+
+    /**
+     * @brief Get sparse matrix matrix product (SpGEMM) by Gustavson's
+     * algorithm, blocks of rows in parallel
+     *
+     * @param _mat                  Sparse matrix used matrix matrix product
+     * @return const SparseMat<T>   Sparse matrix from matrix matrix product
+     */
+    const SparseMat<T> operator*(const SparseMat<T> &_mat) const {
+        PANSFE_PROFILE_SCOPE(
+            "SparseMat::operator*(SparseMat)", 2 * this->Products(_mat),
+            (sizeof(T) + sizeof(int)) *
+                (double(this->NonZeros()) + this->Products(_mat)));
+        assert(this->col == _mat.row);
+        int chunks = std::max(1, std::min(GetNumThreads(), this->row / 256));
+        auto chunkrow = [&](int _c) {
+            return int((long long)this->row * _c / chunks);
+        };
+        std::vector<int> rowptr(this->row + 1, 0);
+        ParallelFor(0, chunks, [&](int _c) {
+            std::vector<int> marker(_mat.col, -1);
+            for (int i = chunkrow(_c); i < chunkrow(_c + 1); i++) {
+                int count = 0;
+                for (int k = this->rowptr[i]; k < this->rowptr[i + 1]; k++) {
+                    int p = this->colind[k];
+                    for (int q = _mat.rowptr[p]; q < _mat.rowptr[p + 1]; q++) {
+                        if (marker[_mat.colind[q]] != i) {
+                            marker[_mat.colind[q]] = i;
+                            count++;
+                        }
+                    }
+                }
+                rowptr[i + 1] = count;
+            }
+        });
+        for (int i = 0; i < this->row; i++) {
+            rowptr[i + 1] += rowptr[i];
+        }
+        std::vector<int> colind(rowptr[this->row]);
+        std::vector<T> values(rowptr[this->row]);
+        ParallelFor(0, chunks, [&](int _c) {
+            std::vector<int> marker(_mat.col, -1);
+            std::vector<T> accumulator(_mat.col, T());
+            for (int i = chunkrow(_c); i < chunkrow(_c + 1); i++) {
+                int head = rowptr[i], tail = head;
+                for (int k = this->rowptr[i]; k < this->rowptr[i + 1]; k++) {
+                    int p = this->colind[k];
+                    for (int q = _mat.rowptr[p]; q < _mat.rowptr[p + 1]; q++) {
+                        int j = _mat.colind[q];
+                        if (marker[j] != i) {
+                            marker[j] = i;
+                            colind[tail++] = j;
+                            accumulator[j] = T();
+                        }
+                        accumulator[j] += this->values[k] * _mat.values[q];
+                    }
+                }
+                std::sort(colind.begin() + head, colind.begin() + tail);
+                for (int k = head; k < tail; k++) {
+                    values[k] = accumulator[colind[k]];
+                }
+            }
+        });
+        return SparseMat<T>(this->row, _mat.col, std::move(rowptr),
+                            std::move(colind), std::move(values));
+    }
+
+    /**
+     * @brief Set _y = A _x without allocation, rows in parallel
+     *
+     * @param _x    Vector used matrix vector product
+     * @param _y    Vector from matrix vector product, sized Row()
+     */
+    void Apply(const Vec<T> &_x, Vec<T> &_y) const {
+        PANSFE_PROFILE_SCOPE(
+            "SparseMat::Apply", 2.0 * this->NonZeros(),
+            (sizeof(T) + sizeof(int)) * double(this->NonZeros()) +
+                sizeof(T) * double(this->row + this->col));
+        assert(_x.Size() == this->col && _y.Size() == this->row);
+        const T *x = _x.Values();
+        T *y = _y.Values();
+        ParallelFor(
+            0, this->row,
+            [&](int _i) {
+                T sum = T();
+                for (int k = this->rowptr[_i]; k < this->rowptr[_i + 1]; k++) {
+                    sum += this->values[k] * x[this->colind[k]];
+                }
+                y[_i] = sum;
+            },
+            1024);
+    }
+
+    /**
+     * @brief Set _y = A^T _x without allocation by scattering each row
+     *
+     * @param _x    Vector used matrix vector product, sized Row()
+     * @param _y    Vector from matrix vector product, sized Col()
+     */
+    void ApplyTranspose(const Vec<T> &_x, Vec<T> &_y) const {
+        PANSFE_PROFILE_SCOPE(
+            "SparseMat::ApplyTranspose", 2.0 * this->NonZeros(),
+            (sizeof(T) + sizeof(int)) * double(this->NonZeros()) +
+                sizeof(T) * double(this->row + this->col));
+        assert(_x.Size() == this->row && _y.Size() == this->col);
+        const T *x = _x.Values();
+        T *y = _y.Values();
+        std::fill(y, y + this->col, T());
+        for (int i = 0; i < this->row; i++) {
+            T xi = x[i];
+            for (int k = this->rowptr[i]; k < this->rowptr[i + 1]; k++) {
+                y[this->colind[k]] += this->values[k] * xi;
+            }
+        }
+    }
+
+    /**
+     * @brief Get diagonal elements, zero where not stored
+     *
+     * @return const Vec<T> Vector of (i, i) elements
+     */
+    const Vec<T> Diagonal() const {
+        int n = std::min(this->row, this->col);
+        Vec<T> retvec(n);
+        for (int i = 0; i < n; i++) {
+            retvec[i] = (*this)(i, i);
+        }
+        return retvec;
+    }
+
+    /**
+     * @brief Transpose this matrix
+     *
+     * @return const SparseMat<T>  Transposed matrix
+     */
+    const SparseMat<T> Transpose() const {
+        PANSFE_PROFILE_SCOPE(
+            "SparseMat::Transpose", 0,
+            2 * (sizeof(T) + sizeof(int)) * double(this->NonZeros()));
+        std::vector<int> rowptr(this->col + 1, 0), colind(this->NonZeros());
+        std::vector<T> values(this->NonZeros());
+        for (int k = 0; k < this->NonZeros(); k++) {
+            rowptr[this->colind[k] + 1]++;
+        }
+        for (int j = 0; j < this->col; j++) {
+            rowptr[j + 1] += rowptr[j];
+        }
+        std::vector<int> position(rowptr.begin(), rowptr.end() - 1);
+        for (int i = 0; i < this->row; i++) {
+            for (int k = this->rowptr[i]; k < this->rowptr[i + 1]; k++) {
+                int p = position[this->colind[k]]++;
+                colind[p] = i;
+                values[p] = this->values[k];
+            }
+        }
+        return SparseMat<T>(this->col, this->row, std::move(rowptr),
+                            std::move(colind), std::move(values));
+    }
+
+    /**
+     * @brief Convert to Mat
+     *
+     * @return Mat<T>   Dense matrix
+     */
+    operator Mat<T>() const {
+        Mat<T> retmat(this->row, this->col);
+        for (int i = 0; i < this->row; i++) {
+            for (int k = this->rowptr[i]; k < this->rowptr[i + 1]; k++) {
+                retmat[i][this->colind[k]] = this->values[k];
+            }
+        }
+        return retmat;
+    }
+
+   private:
+    double Products(const SparseMat<T> &_mat) const {
+        double products = 0;
+        for (int k = 0; k < this->NonZeros(); k++) {
+            int p = this->colind[k];
+            products += _mat.rowptr[p + 1] - _mat.rowptr[p];
+        }
+        return products;
+    }
+
+    int row, col;
+    std::vector<int> rowptr, colind;
+    std::vector<T> values;
+};
+}  // namespace PANSFE
@@ -0,0 +1,254 @@
+/**
+ * @file strassen.h
+ * @author PANFACTORY (github/PANFACTORY)
+ * @brief Definition and implementation of Strassen-Winograd matrix product
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2022
+ *
+ * Strassen-Winograd needs 7 half size products instead of 8, so its cost is
+ * O(n^2.81). The price is accuracy: the error bound of the conventional
+ * product is elementwise, |C - fl(AB)| <= n eps |A||B|, while Strassen-Winograd
+ * only satisfies a normwise bound growing like n^(log2 12) ~ n^3.6 times eps
+ * ||A|| ||B|| as the recursion deepens. A larger cutoff means fewer recursion
+ * levels and a smaller error. Integer products are exact.
+ */
+
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <vector>
+
+#include "mat.h"
+#include "parallel.h"
+#include "profiler.h"
+
+namespace PANSFE {
+template <class T>
+class Mat;
+
+/**
+ * @brief Get storage of Strassen-Winograd cutoff used by Mat * Mat
+ *
+ * @return std::atomic<int>&    Cutoff, 0 means disabled
+ */
+inline std::atomic<int> &StrassenCutoffSetting() {
+    static std::atomic<int> cutoff(0);
+    return cutoff;
+}
+
+/**
+ * @brief Enable Strassen-Winograd product in Mat * Mat for matrices whose
+ * every dimension exceeds _cutoff
+ *
+ * @param _cutoff   Cutoff, 0 disables Strassen-Winograd product (default)
+ */
+inline void SetStrassenCutoff(int _cutoff) {
+    StrassenCutoffSetting() = _cutoff < 0 ? 0 : _cutoff;
+}
+
+/**
+ * @brief Get Strassen-Winograd cutoff used by Mat * Mat
+ *
+ * @return int  Cutoff, 0 means disabled
+ */
+inline int GetStrassenCutoff() { return StrassenCutoffSetting(); }
+
+/**
+ * @brief Conventional product C = A B of row-major strided blocks
+ *
+ * B is traversed in blocks of 128 rows and 256 columns kept in cache while
+ * four rows of C are updated at once, so each loaded row of B is reused four
+ * times. Every element still accumulates its products in
+ * increasing inner index, so the result equals the unblocked triple loop.
+ *
+ * @tparam T    Type of element
+ * @param _m    Row of A and C
+ * @param _n    Column of B and C
+ * @param _k    Column of A and row of B
+ * @param _a    Pointer of A
+ * @param _lda  Leading dimension of A
+ * @param _b    Pointer of B
+ * @param _ldb  Leading dimension of B
+ * @param _c    Pointer of C
+ * @param _ldc  Leading dimension of C
+ */
+template <class T>
+inline void GemmKernel(Index _m, Index _n, Index _k, const T *_a, Index _lda,
+                       const T *_b, Index _ldb, T *_c, Index _ldc) {
+    const Index depth = 128, width = 256;
+    for (Index i = 0; i < _m; i++) {
+        T *ci = _c + _ldc * i;
+        for (Index j = 0; j < _n; j++) {
+            ci[j] = T();
+        }
+    }
+    for (Index jj = 0; jj < _n; jj += width) {
+        Index nw = std::min(width, _n - jj);
+        for (Index pp = 0; pp < _k; pp += depth) {
+            Index kw = std::min(depth, _k - pp);
+            Index i = 0;
+            for (; i + 4 <= _m; i += 4) {
+                const T *a0 = _a + _lda * i + pp, *a1 = a0 + _lda,
+                        *a2 = a1 + _lda, *a3 = a2 + _lda;
+                T *c0 = _c + _ldc * i + jj, *c1 = c0 + _ldc, *c2 = c1 + _ldc,
+                  *c3 = c2 + _ldc;
+                for (Index p = 0; p < kw; p++) {
+                    T a0p = a0[p], a1p = a1[p], a2p = a2[p], a3p = a3[p];
+                    const T *bp = _b + _ldb * (pp + p) + jj;
+                    for (Index j = 0; j < nw; j++) {
+                        T bpj = bp[j];
+                        c0[j] += a0p * bpj;
+                        c1[j] += a1p * bpj;
+                        c2[j] += a2p * bpj;
+                        c3[j] += a3p * bpj;
+                    }
+                }
+            }
+            for (; i < _m; i++) {
+                const T *ai = _a + _lda * i + pp;
+                T *ci = _c + _ldc * i + jj;
+                for (Index p = 0; p < kw; p++) {
+                    T aip = ai[p];
+                    const T *bp = _b + _ldb * (pp + p) + jj;
+                    for (Index j = 0; j < nw; j++) {
+                        ci[j] += aip * bp[j];
+                    }
+                }
+            }
+        }
+    }
+}
+
+/**
+ * @brief Elementwise _z = _x + _sign * _y of row-major strided blocks
+ *
+ */
+template <class T>
+inline void StrassenAdd(Index _m, Index _n, const T *_x, Index _ldx,
+                        const T *_y, Index _ldy, T _sign, T *_z, Index _ldz) {
+    for (Index i = 0; i < _m; i++) {
+        const T *xi = _x + _ldx * i, *yi = _y + _ldy * i;
+        T *zi = _z + _ldz * i;
+        for (Index j = 0; j < _n; j++) {
+            zi[j] = xi[j] + _sign * yi[j];
+        }
+    }
+}
+
+/**
+ * @brief Recursive Strassen-Winograd product C = A B of strided blocks
+ *
+ * Even leading parts are multiplied recursively and the odd last row, column
+ * and inner index are peeled and fixed up with conventional kernels.
+ *
+ * @param _depth    Recursion depth, the 7 products of depth 0 run in parallel
+ */
+template <class T>
+inline void StrassenRecursive(Index _m, Index _n, Index _k, const T *_a,
+                              Index _lda, const T *_b, Index _ldb, T *_c,
+                              Index _ldc, int _cutoff, int _depth) {
+    if (_m <= _cutoff || _n <= _cutoff || _k <= _cutoff) {
+        GemmKernel(_m, _n, _k, _a, _lda, _b, _ldb, _c, _ldc);
+        return;
+    }
+
+    Index m = _m / 2, n = _n / 2, k = _k / 2;
+    const T *a11 = _a, *a12 = _a + k, *a21 = _a + _lda * m, *a22 = a21 + k;
+    const T *b11 = _b, *b12 = _b + n, *b21 = _b + _ldb * k, *b22 = b21 + n;
+    T *c11 = _c, *c12 = _c + n, *c21 = _c + _ldc * m, *c22 = c21 + n;
+
+    std::vector<T> s(4 * m * k), t(4 * k * n), p(7 * m * n);
+    T *s1 = &s[0], *s2 = s1 + m * k, *s3 = s2 + m * k, *s4 = s3 + m * k;
+    T *t1 = &t[0], *t2 = t1 + k * n, *t3 = t2 + k * n, *t4 = t3 + k * n;
+    StrassenAdd(m, k, a21, _lda, a22, _lda, T(1), s1, k);
+    StrassenAdd(m, k, s1, k, a11, _lda, T(-1), s2, k);
+    StrassenAdd(m, k, a11, _lda, a21, _lda, T(-1), s3, k);
+    StrassenAdd(m, k, a12, _lda, s2, k, T(-1), s4, k);
+    StrassenAdd(k, n, b12, _ldb, b11, _ldb, T(-1), t1, n);
+    StrassenAdd(k, n, b22, _ldb, t1, n, T(-1), t2, n);
+    StrassenAdd(k, n, b22, _ldb, b12, _ldb, T(-1), t3, n);
+    StrassenAdd(k, n, t2, n, b21, _ldb, T(-1), t4, n);
+
+    const T *left[7] = {a11, a12, s4, a22, s1, s2, s3};
+    const Index ldleft[7] = {_lda, _lda, k, _lda, k, k, k};
+    const T *right[7] = {b11, b21, b22, t4, t1, t2, t3};
+    const Index ldright[7] = {_ldb, _ldb, _ldb, n, n, n, n};
+    auto product = [&](Index _i) {
+        StrassenRecursive(m, n, k, left[_i], ldleft[_i], right[_i],
+                          ldright[_i], &p[m * n * _i], n, _cutoff, _depth + 1);
+    };
+    if (_depth == 0) {
+        ParallelFor(0, 7, product);
+    } else {
+        for (Index i = 0; i < 7; i++) {
+            product(i);
+        }
+    }
+
+    Index mn = m * n;
+    const T *p1 = &p[0], *p2 = p1 + mn, *p3 = p2 + mn, *p4 = p3 + mn,
+            *p5 = p4 + mn, *p6 = p5 + mn, *p7 = p6 + mn;
+    for (Index i = 0; i < m; i++) {
+        for (Index j = 0; j < n; j++) {
+            Index ij = n * i + j;
+            T u2 = p1[ij] + p6[ij], u3 = u2 + p7[ij];
+            c11[_ldc * i + j] = p1[ij] + p2[ij];
+            c12[_ldc * i + j] = u2 + p5[ij] + p3[ij];
+            c21[_ldc * i + j] = u3 - p4[ij];
+            c22[_ldc * i + j] = u3 + p5[ij];
+        }
+    }
+
+    if (_k % 2) {
+        const T *acol = _a + (_k - 1), *brow = _b + _ldb * (_k - 1);
+        for (Index i = 0; i < 2 * m; i++) {
+            T aik = acol[_lda * i];
+            T *ci = _c + _ldc * i;
+            for (Index j = 0; j < 2 * n; j++) {
+                ci[j] += aik * brow[j];
+            }
+        }
+    }
+    if (_n % 2) {
+        std::vector<T> column(_m);
+        GemmKernel(_m, 1, _k, _a, _lda, _b + (_n - 1), _ldb, &column[0], 1);
+        for (Index i = 0; i < _m; i++) {
+            _c[_ldc * i + (_n - 1)] = column[i];
+        }
+    }
+    if (_m % 2) {
+        GemmKernel(1, 2 * n, _k, _a + _lda * (_m - 1), _lda, _b, _ldb,
+                   _c + _ldc * (_m - 1), _ldc);
+    }
+}
+
+/**
+ * @brief Get matrix matrix product by Strassen-Winograd algorithm
+ *
+ * @tparam T            Type of element
+ * @param _a            Left matrix
+ * @param _b            Right matrix
+ * @param _cutoff       Blocks with a dimension not exceeding _cutoff are
+ * multiplied by the conventional kernel
+ * @return const Mat<T> Matrix product
+ */
+template <class T>
+inline const Mat<T> StrassenMultiply(const Mat<T> &_a, const Mat<T> &_b,
+                                     int _cutoff) {
+    PANSFE_PROFILE_SCOPE("StrassenMultiply", 0,
+                         sizeof(T) * (double(_a.Row()) * _a.Col() +
+                                      double(_b.Row()) * _b.Col() +
+                                      double(_a.Row()) * _b.Col()));
+    assert(_a.Col() == _b.Row() && 0 < _cutoff);
+    Mat<T> retmat(_a.Row(), _b.Col());
+    if (_a.Row() * _b.Col() > 0) {
+        StrassenRecursive(_a.Row(), _b.Col(), _a.Col(), _a.Values(), _a.Col(),
+                          _b.Values(), _b.Col(), retmat.Values(), _b.Col(),
+                          _cutoff, 0);
+    }
+    return retmat;
+}
+}  // namespace PANSFE
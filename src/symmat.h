@@ -0,0 +1,305 @@
+/**
+ * @file symmat.h
+ * @author PANFACTORY (github/PANFACTORY)
+ * @brief Definition and implementation of symmetric packed matrix class
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#pragma once
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <vector>
+
+#include "mat.h"
+#include "parallel.h"
+#include "profiler.h"
+#include "vec.h"
+
+namespace PANSFE {
+/**
+ * @brief Symmetric matrix class storing the lower triangle packed by row
+ *
+ * Element (i, j) with j <= i is stored at i (i + 1) / 2 + j, so a matrix of
+ * size n needs n (n + 1) / 2 elements.
+ *
+ * @tparam T Type of element
+ */
+template <class T>
+class SymMat {
+   public:
+    /**
+     * @brief Construct a new SymMat object whose size is zero
+     *
+     */
+    SymMat() : size(0) {}
+
+    /**
+     * @brief Construct a new SymMat object whose each element is _value
+     *
+     * @param _size     Number of row and column
+     * @param _value    Each element value
+     */
+    explicit SymMat(Index _size, T _value = T())
+        : size(_size), values(_size * (_size + 1) / 2, _value) {
+        PANSFE_PROFILE_ALLOC(sizeof(T) * this->values.size());
+    }
+
+    /**
+     * @brief Construct a new SymMat object from lower triangle of _mat
+     *
+     * @param _mat  Square matrix
+     */
+    explicit SymMat(const Mat<T> &_mat) : SymMat(_mat.Row()) {
+        assert(_mat.Row() == _mat.Col());
+        for (Index i = 0; i < this->size; i++) {
+            for (Index j = 0; j <= i; j++) {
+                this->values[Position(i, j)] = _mat[i][j];
+            }
+        }
+    }
+
+    /**
+     * @brief Get number of row and column
+     *
+     * @return Index    Number of row and column
+     */
+    Index Size() const { return this->size; }
+
+    /**
+     * @brief Get number of row
+     *
+     * @return Index    Number of row
+     */
+    Index Row() const { return this->size; }
+
+    /**
+     * @brief Get number of column
+     *
+     * @return Index    Number of column
+     */
+    Index Col() const { return this->size; }
+
+    /**
+     * @brief Get (_i, _j) element value with validation, (_i, _j) and
+     * (_j, _i) share the same storage
+     *
+     * @param _i    Index of row
+     * @param _j    Index of column
+     * @return T&   Reference of (_i, _j) element value
+     */
+    T &operator()(Index _i, Index _j) {
+        assert(0 <= _i && _i < this->size && 0 <= _j && _j < this->size);
+        return _j <= _i ? this->values[Position(_i, _j)]
+                        : this->values[Position(_j, _i)];
+    }
+
+    /**
+     * @brief Get (_i, _j) element value with validation
+     *
+     * @param _i        Index of row
+     * @param _j        Index of column
+     * @return const T& Reference of (_i, _j) element value
+     */
+    const T &operator()(Index _i, Index _j) const {
+        assert(0 <= _i && _i < this->size && 0 <= _j && _j < this->size);
+        return _j <= _i ? this->values[Position(_i, _j)]
+                        : this->values[Position(_j, _i)];
+    }
+
+    /**
+     * @brief Get pointer of packed lower triangle
+     *
+     * @return T*   Pointer of packed lower triangle
+     */
+    T *Values() { return this->values.data(); }
+
+    /**
+     * @brief Get pointer of packed lower triangle
+     *
+     * @return const T* Pointer of packed lower triangle
+     */
+    const T *Values() const { return this->values.data(); }
+
+    /**
+     * @brief Check the same
+     *
+     * @param _mat      Comparison
+     * @return true     Same with _mat
+     * @return false    Not the same
+     */
+    bool operator==(const SymMat<T> &_mat) const {
+        return this->size == _mat.size && this->values == _mat.values;
+    }
+
+    /**
+     * @brief Check not the same
+     *
+     * @param _mat      Comparison
+     * @return true     Not the same
+     * @return false    Same with _mat
+     */
+    bool operator!=(const SymMat<T> &_mat) const { return !(*this == _mat); }
+
+    /**
+     * @brief Get symmetric matrix vector product (SYMV)
+     *
+     * Each stored element is read once and used for both (i, j) and (j, i).
+     * Rows are split among threads by equal element count and each thread
+     * accumulates the transposed contribution in its own buffer.
+     *
+     * @param _vec          Vector used matrix vector product
+     * @return const Vec<T> Vector from matrix vector product
+     */
+    const Vec<T> operator*(const Vec<T> &_vec) const {
+        Vec<T> retvec(this->size);
+        this->Apply(_vec, retvec);
+        return retvec;
+    }
+
+    /**
+     * @brief Set _y = A _x in the same way as operator*, without allocation
+     * when run on one thread
+     *
+     * The first thread accumulates into _y and each other thread into a
+     * buffer of size n, so _x and _y must not be the same vector.
+     *
+     * @param _x    Vector used matrix vector product
+     * @param _y    Vector from matrix vector product
+     */
+    void Apply(const Vec<T> &_x, Vec<T> &_y) const {
+        PANSFE_PROFILE_SCOPE("SymMat::Apply",
+                             2.0 * this->size * this->size,
+                             sizeof(T) * double(this->values.size()));
+        assert(_x.Size() == this->size && _y.Size() == this->size);
+        Index n = this->size;
+        int numthreads =
+            std::max(1, std::min(GetNumThreads(), int(this->values.size() /
+                                                      (1 << 16))));
+        const T *x = _x.Values();
+        T *y = _y.Values();
+        std::fill(y, y + n, T());
+        auto rows = [&](Index _head, Index _tail, T *_sum) {
+            for (Index i = _head; i < _tail; i++) {
+                const T *rowi = &this->values[Position(i, 0)];
+                T xi = x[i], sum = T();
+                for (Index j = 0; j < i; j++) {
+                    sum += rowi[j] * x[j];
+                    _sum[j] += rowi[j] * xi;
+                }
+                _sum[i] += sum + rowi[i] * xi;
+            }
+        };
+        if (numthreads == 1) {
+            rows(0, n, y);
+            return;
+        }
+        std::vector<Index> head(numthreads + 1);
+        for (int t = 0; t <= numthreads; t++) {
+            head[t] = Index(n * std::sqrt(double(t) / numthreads));
+        }
+        head[numthreads] = n;
+        std::vector<std::vector<T> > partial(numthreads - 1,
+                                             std::vector<T>(n, T()));
+        ParallelFor(0, numthreads, [&](int _t) {
+            rows(head[_t], head[_t + 1], _t == 0 ? y : partial[_t - 1].data());
+        });
+        for (int t = 0; t < numthreads - 1; t++) {
+            for (Index i = 0; i < n; i++) {
+                y[i] += partial[t][i];
+            }
+        }
+    }
+
+    /**
+     * @brief Set _y = A^T _x, which equals A _x for symmetric matrix
+     *
+     * @param _x    Vector used matrix vector product
+     * @param _y    Vector from matrix vector product
+     */
+    void ApplyTranspose(const Vec<T> &_x, Vec<T> &_y) const {
+        this->Apply(_x, _y);
+    }
+
+    /**
+     * @brief Get diagonal elements
+     *
+     * @return const Vec<T> Vector of (i, i) elements
+     */
+    const Vec<T> Diagonal() const {
+        Vec<T> retvec(this->size);
+        for (Index i = 0; i < this->size; i++) {
+            retvec[i] = this->values[Position(i, i)];
+        }
+        return retvec;
+    }
+
+    /**
+     * @brief Symmetric rank k update this = _alpha _a _a^T + _beta this
+     * (SYRK)
+     *
+     * @param _alpha    Coefficient of _a _a^T
+     * @param _a        Matrix whose row is the size of this matrix
+     * @param _beta     Coefficient of this matrix
+     * @return SymMat<T>&   Reference of this object
+     */
+    SymMat<T> &RankUpdate(T _alpha, const Mat<T> &_a, T _beta = T(1)) {
+        PANSFE_PROFILE_SCOPE(
+            "SymMat::RankUpdate", double(this->values.size()) * 2 * _a.Col(),
+            sizeof(T) * (2.0 * this->values.size() +
+                         double(_a.Row()) * _a.Col()));
+        assert(_a.Row() == this->size);
+        Index k = _a.Col();
+        ParallelFor(
+            0, this->size,
+            [&](Index _i) {
+                const T *ai = _a[_i];
+                T *rowi = &this->values[Position(_i, 0)];
+                for (Index j = 0; j <= _i; j++) {
+                    const T *aj = _a[j];
+                    T sum = T();
+                    for (Index p = 0; p < k; p++) {
+                        sum += ai[p] * aj[p];
+                    }
+                    rowi[j] = _alpha * sum + _beta * rowi[j];
+                }
+            },
+            16);
+        return *this;
+    }
+
+    /**
+     * @brief Convert to Mat
+     *
+     * @return Mat<T>   Dense symmetric matrix
+     */
+    operator Mat<T>() const {
+        Mat<T> retmat(this->size, this->size);
+        for (Index i = 0; i < this->size; i++) {
+            for (Index j = 0; j <= i; j++) {
+                retmat[i][j] = retmat[j][i] = this->values[Position(i, j)];
+            }
+        }
+        return retmat;
+    }
+
+    /**
+     * @brief Get position of (_i, _j) element in packed storage
+     *
+     * @param _i            Index of row
+     * @param _j            Index of column, _j <= _i
+     * @return Index    Position of element
+     */
+    static Index Position(Index _i, Index _j) {
+        return _i * (_i + 1) / 2 + _j;
+    }
+
+   private:
+    Index size;
+    std::vector<T> values;
+};
+}  // namespace PANSFE
@@ -0,0 +1,634 @@
+/**
+ * @file tiledmat.h
+ * @author PANFACTORY (github/PANFACTORY)
+ * @brief Definition and implementation of out-of-core tiled matrix class
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cmath>
+#include <fstream>
+#include <future>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "mat.h"
+#include "parallel.h"
+#include "profiler.h"
+#include "vec.h"
+
+namespace PANSFE {
+/**
+ * @brief Matrix stored in a file as square tiles, of which a bounded number
+ * are kept in memory
+ *
+ * Tiles are stored row-major one after another, each as a row-major
+ * TileSize() x TileSize() block padded at the edges. Resident tiles are
+ * replaced in least recently used order, written back when modified, and
+ * tiles needed next by the kernels are read asynchronously in advance.
+ * A tile obtained by WriteTile must be written before any other tile is
+ * requested, since it may be written back and evicted after that. The
+ * kernels run over tiles in parallel and replace the tiles they modify as a
+ * whole. Failures of the backing file throw std::runtime_error, and a tile
+ * whose read failed is dropped from the cache so that it is read again on
+ * the next request.
+ *
+ * @tparam T Type of element
+ */
+template <class T>
+class TiledMat {
+   public:
+    /**
+     * @brief Number of tiles requested ahead of the one in use by kernels
+     *
+     */
+    static const int PrefetchDistance = 2;
+
+    /**
+     * @brief Construct a new TiledMat object on a file
+     *
+     * @param _path         Path of the backing file
+     * @param _row          Row of the matrix
+     * @param _col          Column of the matrix
+     * @param _tilesize     Row and column of each tile
+     * @param _cachetiles   Maximum number of resident tiles, at least 8
+     * @param _create       Create a zero matrix, otherwise open an existing
+     * file written with the same shape
+     * @exception std::runtime_error    The file cannot be opened or extended
+     */
+    TiledMat(const std::string &_path, long long _row, long long _col,
+             int _tilesize = 256, int _cachetiles = 64, bool _create = true)
+        : row(_row),
+          col(_col),
+          tilesize(_tilesize),
+          cachetiles(_cachetiles),
+          loads(0) {
+        assert(0 <= _row && 0 <= _col && 0 < _tilesize && 8 <= _cachetiles);
+        this->tilerows = (_row + _tilesize - 1) / _tilesize;
+        this->tilecols = (_col + _tilesize - 1) / _tilesize;
+        std::ios::openmode mode =
+            std::ios::in | std::ios::out | std::ios::binary;
+        this->file.open(_path, _create ? mode | std::ios::trunc : mode);
+        if (!this->file.is_open()) {
+            throw std::runtime_error("TiledMat: cannot open " + _path);
+        }
+        if (_create && this->tilerows * this->tilecols > 0) {
+            this->file.seekp(this->Offset(this->tilerows * this->tilecols) -
+                             1);
+            this->file.put(0);
+            this->file.flush();
+            if (!this->file) {
+                throw std::runtime_error("TiledMat: cannot extend " + _path);
+            }
+        }
+    }
+
+    TiledMat(const TiledMat<T> &) = delete;
+    TiledMat<T> &operator=(const TiledMat<T> &) = delete;
+
+    /**
+     * @brief Destroy the TiledMat object after writing modified tiles back,
+     * errors of which are ignored, so call Flush before to detect them
+     *
+     */
+    ~TiledMat() {
+        try {
+            this->Flush();
+        } catch (const std::exception &) {
+        }
+        std::lock_guard<std::mutex> lock(this->cachemutex);
+        for (auto &entry : this->cache) {
+            entry.second.tile.wait();
+        }
+    }
+
+    /**
+     * @brief Get number of row
+     *
+     * @return long long    Number of row
+     */
+    long long Row() const { return this->row; }
+
+    /**
+     * @brief Get number of column
+     *
+     * @return long long    Number of column
+     */
+    long long Col() const { return this->col; }
+
+    /**
+     * @brief Get row and column of each tile
+     *
+     * @return int  Row and column of each tile
+     */
+    int TileSize() const { return this->tilesize; }
+
+    /**
+     * @brief Get number of tile rows
+     *
+     * @return long long    Number of tile rows
+     */
+    long long TileRows() const { return this->tilerows; }
+
+    /**
+     * @brief Get number of tile columns
+     *
+     * @return long long    Number of tile columns
+     */
+    long long TileCols() const { return this->tilecols; }
+
+    /**
+     * @brief Get number of tiles read from the file so far
+     *
+     * @return long long    Number of tiles read
+     */
+    long long Loads() const { return this->loads; }
+
+    /**
+     * @brief Get (_i, _j) element value through the tile cache
+     *
+     * @param _i    Index of row
+     * @param _j    Index of column
+     * @return T    (_i, _j) element value
+     */
+    T operator()(long long _i, long long _j) const {
+        assert(0 <= _i && _i < this->row && 0 <= _j && _j < this->col);
+        auto tile = this->ReadTile(_i / this->tilesize, _j / this->tilesize);
+        return (*tile)[this->tilesize * (_i % this->tilesize) +
+                       _j % this->tilesize];
+    }
+
+    /**
+     * @brief Set (_i, _j) element value through the tile cache
+     *
+     * @param _i        Index of row
+     * @param _j        Index of column
+     * @param _value    Element value
+     */
+    void Set(long long _i, long long _j, T _value) {
+        assert(0 <= _i && _i < this->row && 0 <= _j && _j < this->col);
+        auto tile = this->WriteTile(_i / this->tilesize, _j / this->tilesize);
+        (*tile)[this->tilesize * (_i % this->tilesize) + _j % this->tilesize] =
+            _value;
+    }
+
+    /**
+     * @brief Get (_bi, _bj) tile for reading
+     *
+     * @param _bi   Index of tile row
+     * @param _bj   Index of tile column
+     * @return std::shared_ptr<const std::vector<T> >   Row-major tile
+     */
+    std::shared_ptr<const std::vector<T> > ReadTile(long long _bi,
+                                                    long long _bj) const {
+        return this->Get(this->Key(_bi, _bj), false);
+    }
+
+    /**
+     * @brief Get (_bi, _bj) tile for writing, marked to be written back
+     *
+     * @param _bi   Index of tile row
+     * @param _bj   Index of tile column
+     * @return std::shared_ptr<std::vector<T> > Row-major tile
+     */
+    std::shared_ptr<std::vector<T> > WriteTile(long long _bi, long long _bj) {
+        return this->Get(this->Key(_bi, _bj), true);
+    }
+
+    /**
+     * @brief Start reading (_bi, _bj) tile in background if not resident
+     *
+     * @param _bi   Index of tile row
+     * @param _bj   Index of tile column
+     */
+    void Prefetch(long long _bi, long long _bj) const {
+        if (0 <= _bi && _bi < this->tilerows && 0 <= _bj &&
+            _bj < this->tilecols) {
+            this->Fetch(this->Key(_bi, _bj), false);
+        }
+    }
+
+    /**
+     * @brief Write modified resident tiles back to the file
+     *
+     * @exception std::runtime_error    A tile cannot be written
+     */
+    void Flush() {
+        std::lock_guard<std::mutex> lock(this->cachemutex);
+        for (auto &entry : this->cache) {
+            if (entry.second.dirty) {
+                Tile tile = entry.second.tile.get();
+                if (tile) {
+                    this->Store(entry.first, *tile);
+                }
+                entry.second.dirty = false;
+            }
+        }
+        std::lock_guard<std::mutex> filelock(this->filemutex);
+        if (!this->file.flush()) {
+            throw std::runtime_error("TiledMat: cannot flush the file");
+        }
+    }
+
+    /**
+     * @brief Get matrix vector product streaming tiles, tile rows in
+     * parallel
+     *
+     * @param _vec          Vector used matrix vector product
+     * @return const Vec<T> Vector from matrix vector product
+     */
+    const Vec<T> operator*(const Vec<T> &_vec) const {
+        PANSFE_PROFILE_SCOPE("TiledMat::operator*",
+                             2.0 * this->row * this->col,
+                             sizeof(T) * double(this->row) * this->col);
+        assert(_vec.Size() == this->col);
+        Vec<T> retvec(this->row);
+        const T *x = _vec.Values();
+        T *y = retvec.Values();
+        ParallelFor(0, this->tilerows, [&](Index _bi) {
+            int m = this->Extent(_bi, this->row);
+            T *yi = y + _bi * this->tilesize;
+            for (long long bj = 0; bj < this->tilecols; bj++) {
+                auto tile = this->ReadTile(_bi, bj);
+                for (int d = 1; d <= PrefetchDistance; d++) {
+                    this->Prefetch(_bi, bj + d);
+                }
+                int n = this->Extent(bj, this->col);
+                const T *a = tile->data(), *xj = x + bj * this->tilesize;
+                for (int r = 0; r < m; r++) {
+                    const T *ar = a + (long long)this->tilesize * r;
+                    T sum = T();
+                    for (int c = 0; c < n; c++) {
+                        sum += ar[c] * xj[c];
+                    }
+                    yi[r] += sum;
+                }
+            }
+        });
+        return retvec;
+    }
+
+    /**
+     * @brief Compute _c = _a _b tile by tile, tiles of _c in parallel, each
+     * thread keeping one accumulator tile in memory besides the cache
+     *
+     * @param _a    Left matrix
+     * @param _b    Right matrix with the same tile size
+     * @param _c    Product with the same tile size, distinct from _a and _b
+     */
+    static void Multiply(const TiledMat<T> &_a, const TiledMat<T> &_b,
+                         TiledMat<T> &_c) {
+        PANSFE_PROFILE_SCOPE(
+            "TiledMat::Multiply", 2.0 * _a.row * _a.col * _b.col,
+            sizeof(T) * (double(_a.row) * _a.col * _b.tilecols +
+                         double(_b.row) * _b.col * _a.tilerows));
+        assert(_a.col == _b.row && _c.row == _a.row && _c.col == _b.col);
+        assert(_a.tilesize == _b.tilesize && _a.tilesize == _c.tilesize);
+        assert(&_c != &_a && &_c != &_b);
+        int ts = _a.tilesize;
+        ParallelFor(0, _c.tilerows * _c.tilecols, [&](Index _t) {
+            long long bi = _t / _c.tilecols, bj = _t % _c.tilecols;
+            std::vector<T> accumulator((long long)ts * ts);
+            for (long long bk = 0; bk < _a.tilecols; bk++) {
+                auto atile = _a.ReadTile(bi, bk);
+                auto btile = _b.ReadTile(bk, bj);
+                if (bk + 1 < _a.tilecols) {
+                    _a.Prefetch(bi, bk + 1);
+                    _b.Prefetch(bk + 1, bj);
+                } else if (bj + 1 < _c.tilecols) {
+                    _a.Prefetch(bi, 0);
+                    _b.Prefetch(0, bj + 1);
+                } else {
+                    _a.Prefetch(bi + 1, 0);
+                    _b.Prefetch(0, 0);
+                }
+                MultiplyAdd(_a.Extent(bi, _a.row), _b.Extent(bj, _b.col),
+                            _a.Extent(bk, _a.col), atile->data(),
+                            btile->data(), ts, T(1), false, false,
+                            accumulator.data());
+            }
+            _c.Replace(_c.Key(bi, bj), accumulator);
+        });
+    }
+
+    /**
+     * @brief Factorize symmetric positive definite matrix in place by tiled
+     * right-looking Cholesky, the lower triangle is overwritten with L and
+     * the strictly upper triangle is left as it was
+     *
+     * Panel tiles and trailing tiles of each step are updated in parallel,
+     * the diagonal trailing tiles only in their lower triangle.
+     *
+     * @return true     Matrix is positive definite
+     * @return false    Matrix is not positive definite
+     */
+    bool FactorizeCholesky() {
+        PANSFE_PROFILE_SCOPE("TiledMat::FactorizeCholesky",
+                             double(this->row) * this->row * this->row / 3.0,
+                             sizeof(T) * double(this->row) * this->row *
+                                 this->tilerows / 3.0);
+        assert(this->row == this->col);
+        int ts = this->tilesize;
+        long long nt = this->tilerows;
+        for (long long k = 0; k < nt; k++) {
+            int nk = this->Extent(k, this->row);
+            auto diagonal = this->WriteTile(k, k);
+            T *l = diagonal->data();
+            for (int i = 0; i < nk; i++) {
+                for (int j = 0; j <= i; j++) {
+                    T sum = l[ts * i + j];
+                    for (int p = 0; p < j; p++) {
+                        sum -= l[ts * i + p] * l[ts * j + p];
+                    }
+                    if (j < i) {
+                        l[ts * i + j] = sum / l[ts * j + j];
+                    } else if (sum > T()) {
+                        l[ts * i + i] = std::sqrt(sum);
+                    } else {
+                        return false;
+                    }
+                }
+            }
+            this->Prefetch(k + 1, k);
+            ParallelFor(k + 1, nt, [&](Index _i) {
+                std::vector<T> panel = *this->ReadTile(_i, k);
+                this->Prefetch(_i + 1, k);
+                for (int r = 0; r < this->Extent(_i, this->row); r++) {
+                    T *ar = panel.data() + (long long)ts * r;
+                    for (int c = 0; c < nk; c++) {
+                        T sum = ar[c];
+                        for (int p = 0; p < c; p++) {
+                            sum -= ar[p] * l[ts * c + p];
+                        }
+                        ar[c] = sum / l[ts * c + c];
+                    }
+                }
+                this->Replace(this->Key(_i, k), panel);
+            });
+            long long rest = nt - k - 1;
+            ParallelFor(0, rest * rest, [&](Index _t) {
+                long long i = k + 1 + _t / rest, j = k + 1 + _t % rest;
+                if (j > i) {
+                    return;
+                }
+                auto lik = this->ReadTile(i, k);
+                auto ljk = this->ReadTile(j, k);
+                std::vector<T> aij = *this->ReadTile(i, j);
+                long long ni = j < i ? i : i + 1, nj = j < i ? j + 1 : k + 1;
+                this->Prefetch(ni, k);
+                this->Prefetch(ni, nj);
+                MultiplyAdd(this->Extent(i, this->row),
+                            this->Extent(j, this->row), nk, lik->data(),
+                            ljk->data(), ts, T(-1), true, i == j, aij.data());
+                this->Replace(this->Key(i, j), aij);
+            });
+        }
+        return true;
+    }
+
+    /**
+     * @brief Solve A x = _b in place with the factor of FactorizeCholesky
+     *
+     * @param _x    Right hand side on input and solution on output
+     */
+    void CholeskySolveInPlace(Vec<T> &_x) const {
+        PANSFE_PROFILE_SCOPE("TiledMat::CholeskySolve",
+                             2.0 * this->row * this->row,
+                             sizeof(T) * double(this->row) * this->row);
+        assert(this->row == this->col && _x.Size() == this->row);
+        int ts = this->tilesize;
+        long long nt = this->tilerows;
+        T *x = _x.Values();
+        for (long long bi = 0; bi < nt; bi++) {
+            int m = this->Extent(bi, this->row);
+            T *xi = x + bi * ts;
+            for (long long bj = 0; bj <= bi; bj++) {
+                auto tile = this->ReadTile(bi, bj);
+                this->Prefetch(bj < bi ? bi : bi + 1, bj < bi ? bj + 1 : 0);
+                const T *a = tile->data(), *xj = x + bj * ts;
+                for (int r = 0; r < m; r++) {
+                    const T *ar = a + (long long)ts * r;
+                    T sum = xi[r];
+                    for (int c = 0; c < (bj < bi ? ts : r); c++) {
+                        sum -= ar[c] * xj[c];
+                    }
+                    xi[r] = bj < bi ? sum : sum / ar[r];
+                }
+            }
+        }
+        for (long long bi = nt - 1; bi >= 0; bi--) {
+            int m = this->Extent(bi, this->row);
+            T *xi = x + bi * ts;
+            for (long long bj = nt - 1; bj >= bi; bj--) {
+                auto tile = this->ReadTile(bj, bi);
+                this->Prefetch(bj > bi ? bj - 1 : nt - 1,
+                               bj > bi ? bi : bi - 1);
+                const T *a = tile->data(), *xj = x + bj * ts;
+                if (bj > bi) {
+                    for (int r = 0; r < this->Extent(bj, this->row); r++) {
+                        const T *ar = a + (long long)ts * r;
+                        for (int c = 0; c < m; c++) {
+                            xi[c] -= ar[c] * xj[r];
+                        }
+                    }
+                } else {
+                    for (int r = m - 1; r >= 0; r--) {
+                        const T *ar = a + (long long)ts * r;
+                        xi[r] /= ar[r];
+                        for (int c = 0; c < r; c++) {
+                            xi[c] -= ar[c] * xi[r];
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Convert to Mat, only for matrices which fit in memory
+     *
+     * @return Mat<T>   Dense matrix
+     */
+    operator Mat<T>() const {
+        Mat<T> retmat(this->row, this->col);
+        for (long long bi = 0; bi < this->tilerows; bi++) {
+            for (long long bj = 0; bj < this->tilecols; bj++) {
+                auto tile = this->ReadTile(bi, bj);
+                for (int r = 0; r < this->Extent(bi, this->row); r++) {
+                    for (int c = 0; c < this->Extent(bj, this->col); c++) {
+                        retmat[bi * this->tilesize + r]
+                              [bj * this->tilesize + c] =
+                                  (*tile)[this->tilesize * r + c];
+                    }
+                }
+            }
+        }
+        return retmat;
+    }
+
+   private:
+    typedef std::shared_ptr<std::vector<T> > Tile;
+
+    struct Entry {
+        std::shared_future<Tile> tile;
+        std::list<long long>::iterator position;
+        bool dirty;
+    };
+
+    long long row, col, tilerows, tilecols;
+    int tilesize, cachetiles;
+    mutable std::fstream file;
+    mutable std::mutex cachemutex, filemutex;
+    mutable std::unordered_map<long long, Entry> cache;
+    mutable std::list<long long> lru;
+    mutable std::atomic<long long> loads;
+
+    long long Key(long long _bi, long long _bj) const {
+        assert(0 <= _bi && _bi < this->tilerows && 0 <= _bj &&
+               _bj < this->tilecols);
+        return _bi * this->tilecols + _bj;
+    }
+
+    long long Offset(long long _key) const {
+        return _key * this->tilesize * this->tilesize * (long long)sizeof(T);
+    }
+
+    int Extent(long long _b, long long _size) const {
+        return int(std::min<long long>(this->tilesize,
+                                       _size - _b * this->tilesize));
+    }
+
+    Tile Load(long long _key) const {
+        Tile tile = std::make_shared<std::vector<T> >(
+            (long long)this->tilesize * this->tilesize);
+        std::lock_guard<std::mutex> lock(this->filemutex);
+        this->file.clear();
+        this->file.seekg(this->Offset(_key));
+        this->file.read(reinterpret_cast<char *>(tile->data()),
+                        sizeof(T) * tile->size());
+        if (!this->file) {
+            return Tile();
+        }
+        this->loads++;
+        return tile;
+    }
+
+    Tile Get(long long _key, bool _write) const {
+        Tile tile = this->Fetch(_key, _write).get();
+        if (!tile) {
+            this->Evict(_key);
+            throw std::runtime_error("TiledMat: cannot read tile " +
+                                     std::to_string(_key));
+        }
+        return tile;
+    }
+
+    void Evict(long long _key) const {
+        std::lock_guard<std::mutex> lock(this->cachemutex);
+        auto found = this->cache.find(_key);
+        if (found != this->cache.end() && !found->second.tile.get()) {
+            this->lru.erase(found->second.position);
+            this->cache.erase(found);
+        }
+    }
+
+    void Store(long long _key, const std::vector<T> &_tile) const {
+        std::lock_guard<std::mutex> lock(this->filemutex);
+        this->file.clear();
+        this->file.seekp(this->Offset(_key));
+        this->file.write(reinterpret_cast<const char *>(_tile.data()),
+                         sizeof(T) * _tile.size());
+        if (!this->file) {
+            throw std::runtime_error("TiledMat: cannot write tile " +
+                                     std::to_string(_key));
+        }
+    }
+
+    void Replace(long long _key, const std::vector<T> &_tile) {
+        std::lock_guard<std::mutex> lock(this->cachemutex);
+        auto found = this->cache.find(_key);
+        if (found == this->cache.end()) {
+            this->Store(_key, _tile);
+            return;
+        }
+        Tile tile = found->second.tile.get();
+        if (!tile) {
+            this->lru.erase(found->second.position);
+            this->cache.erase(found);
+            this->Store(_key, _tile);
+            return;
+        }
+        std::copy(_tile.begin(), _tile.end(), tile->begin());
+        found->second.dirty = true;
+    }
+
+    std::shared_future<Tile> Fetch(long long _key, bool _write) const {
+        std::lock_guard<std::mutex> lock(this->cachemutex);
+        auto found = this->cache.find(_key);
+        if (found != this->cache.end()) {
+            this->lru.splice(this->lru.begin(), this->lru,
+                             found->second.position);
+            found->second.dirty = found->second.dirty || _write;
+            return found->second.tile;
+        }
+        if (int(this->cache.size()) >= this->cachetiles) {
+            long long victim = this->lru.back();
+            Entry &entry = this->cache[victim];
+            Tile tile = entry.tile.get();
+            if (entry.dirty && tile) {
+                this->Store(victim, *tile);
+            }
+            this->lru.pop_back();
+            this->cache.erase(victim);
+        }
+        this->lru.push_front(_key);
+        Entry &entry = this->cache[_key];
+        entry.tile = std::async(std::launch::async,
+                                [this, _key]() { return this->Load(_key); })
+                         .share();
+        entry.position = this->lru.begin();
+        entry.dirty = _write;
+        return entry.tile;
+    }
+
+    static void MultiplyAdd(int _m, int _n, int _k, const T *_a, const T *_b,
+                            int _ld, T _alpha, bool _transpose, bool _lower,
+                            T *_c) {
+        for (int i = 0; i < _m; i++) {
+            const T *ai = _a + (long long)_ld * i;
+            T *ci = _c + (long long)_ld * i;
+            if (_transpose) {
+                int n = _lower ? std::min(_n, i + 1) : _n;
+                for (int j = 0; j < n; j++) {
+                    const T *bj = _b + (long long)_ld * j;
+                    T sum = T();
+                    for (int p = 0; p < _k; p++) {
+                        sum += ai[p] * bj[p];
+                    }
+                    ci[j] += _alpha * sum;
+                }
+            } else {
+                for (int p = 0; p < _k; p++) {
+                    T aip = _alpha * ai[p];
+                    const T *bp = _b + (long long)_ld * p;
+                    for (int j = 0; j < _n; j++) {
+                        ci[j] += aip * bp[j];
+                    }
+                }
+            }
+        }
+    }
+};
+}  // namespace PANSFE
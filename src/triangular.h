@@ -0,0 +1,266 @@
+/**
+ * @file triangular.h
+ * @author PANFACTORY (github/PANFACTORY)
+ * @brief Definition and implementation of triangular matrix view and
+ * triangular solvers
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#pragma once
+#include <algorithm>
+#include <cassert>
+
+#include "mat.h"
+#include "parallel.h"
+#include "profiler.h"
+#include "uplo.h"
+#include "vec.h"
+
+namespace PANSFE {
+/**
+ * @brief Triangular view over a square Mat, only the referenced triangle is
+ * ever read
+ *
+ * The view keeps a pointer to the matrix, which must outlive it.
+ *
+ * @tparam T Type of element
+ */
+template <class T>
+class TriangularView {
+   public:
+    /**
+     * @brief Number of rows per block of blocked solvers
+     *
+     */
+    static const int BlockSize = 64;
+
+    /**
+     * @brief Construct a new TriangularView object
+     *
+     * @param _mat  Square matrix
+     * @param _uplo Referenced triangle
+     * @param _diag Whether the diagonal is implicitly one
+     */
+    TriangularView(const Mat<T> &_mat, Uplo _uplo, Diag _diag = Diag::NonUnit)
+        : mat(&_mat), uplo(_uplo), diag(_diag) {
+        assert(_mat.Row() == _mat.Col());
+    }
+
+    /**
+     * @brief Get number of row and column
+     *
+     * @return Index    Number of row and column
+     */
+    Index Size() const { return this->mat->Row(); }
+
+    /**
+     * @brief Get (_i, _j) element of the triangular matrix
+     *
+     * @param _i    Index of row
+     * @param _j    Index of column
+     * @return T    (_i, _j) element value
+     */
+    T operator()(Index _i, Index _j) const {
+        assert(0 <= _i && _i < this->Size() && 0 <= _j && _j < this->Size());
+        if (_i == _j && this->diag == Diag::Unit) {
+            return T(1);
+        }
+        if (this->uplo == Uplo::Lower ? _j > _i : _j < _i) {
+            return T();
+        }
+        return (*this->mat)[_i][_j];
+    }
+
+    /**
+     * @brief Get triangular matrix vector product (TRMV)
+     *
+     * @param _vec          Vector used matrix vector product
+     * @return const Vec<T> Vector from matrix vector product
+     */
+    const Vec<T> operator*(const Vec<T> &_vec) const {
+        PANSFE_PROFILE_SCOPE("TriangularView::operator*",
+                             double(this->Size()) * this->Size(),
+                             sizeof(T) * double(this->Size()) * this->Size() /
+                                 2);
+        Index n = this->Size();
+        assert(_vec.Size() == n);
+        Vec<T> retvec(n);
+        const T *x = _vec.Values();
+        T *y = retvec.Values();
+        ParallelFor(
+            0, n,
+            [&](Index _i) {
+                const T *ai = (*this->mat)[_i];
+                Index head = this->uplo == Uplo::Lower ? 0 : _i + 1,
+                    tail = this->uplo == Uplo::Lower ? _i : n;
+                T sum = this->diag == Diag::Unit ? x[_i] : ai[_i] * x[_i];
+                for (Index j = head; j < tail; j++) {
+                    sum += ai[j] * x[j];
+                }
+                y[_i] = sum;
+            },
+            256);
+        return retvec;
+    }
+
+    /**
+     * @brief Solve A x = _b in place by blocked substitution (TRSV)
+     *
+     * After each diagonal block is solved, the remaining rows are updated in
+     * parallel.
+     *
+     * @param _x    Right hand side on input and solution on output
+     */
+    void SolveInPlace(Vec<T> &_x) const {
+        PANSFE_PROFILE_SCOPE("TriangularView::Solve",
+                             double(this->Size()) * this->Size(),
+                             sizeof(T) * double(this->Size()) * this->Size() /
+                                 2);
+        Index n = this->Size();
+        assert(_x.Size() == n);
+        T *x = _x.Values();
+        const Mat<T> &a = *this->mat;
+        Index numblocks = (n + BlockSize - 1) / BlockSize;
+        for (Index b = 0; b < numblocks; b++) {
+            Index head, tail;
+            if (this->uplo == Uplo::Lower) {
+                head = b * BlockSize;
+                tail = std::min(n, head + BlockSize);
+                for (Index i = head; i < tail; i++) {
+                    T sum = x[i];
+                    for (Index j = head; j < i; j++) {
+                        sum -= a[i][j] * x[j];
+                    }
+                    x[i] = this->diag == Diag::Unit ? sum : sum / a[i][i];
+                }
+                ParallelFor(
+                    tail, n,
+                    [&](Index _i) {
+                        const T *ai = a[_i];
+                        T sum = T();
+                        for (Index j = head; j < tail; j++) {
+                            sum += ai[j] * x[j];
+                        }
+                        x[_i] -= sum;
+                    },
+                    4096);
+            } else {
+                tail = n - b * BlockSize;
+                head = std::max<Index>(0, tail - BlockSize);
+                for (Index i = tail - 1; i >= head; i--) {
+                    T sum = x[i];
+                    for (Index j = i + 1; j < tail; j++) {
+                        sum -= a[i][j] * x[j];
+                    }
+                    x[i] = this->diag == Diag::Unit ? sum : sum / a[i][i];
+                }
+                ParallelFor(
+                    0, head,
+                    [&](Index _i) {
+                        const T *ai = a[_i];
+                        T sum = T();
+                        for (Index j = head; j < tail; j++) {
+                            sum += ai[j] * x[j];
+                        }
+                        x[_i] -= sum;
+                    },
+                    4096);
+            }
+        }
+    }
+
+    /**
+     * @brief Solve A x = _b
+     *
+     * @param _b            Right hand side
+     * @return const Vec<T> Solution
+     */
+    const Vec<T> Solve(const Vec<T> &_b) const {
+        Vec<T> retvec = _b;
+        this->SolveInPlace(retvec);
+        return retvec;
+    }
+
+    /**
+     * @brief Solve A X = _B in place for multiple right hand sides (TRSM)
+     *
+     * Columns of _B are split into panels solved in parallel, and each row
+     * update runs over a contiguous panel.
+     *
+     * @param _x    Right hand sides on input and solutions on output
+     */
+    void SolveInPlace(Mat<T> &_x) const {
+        PANSFE_PROFILE_SCOPE(
+            "TriangularView::Solve",
+            double(this->Size()) * this->Size() * _x.Col(),
+            sizeof(T) * (double(this->Size()) * this->Size() / 2 +
+                         2.0 * _x.Row() * _x.Col()));
+        Index n = this->Size(), m = _x.Col();
+        assert(_x.Row() == n);
+        const Mat<T> &a = *this->mat;
+        T *x = _x.Values();
+        Index numpanels = (m + BlockSize - 1) / BlockSize;
+        ParallelFor(0, numpanels, [&](Index _p) {
+            Index head = _p * BlockSize,
+                  width = std::min(m, head + BlockSize) - head;
+            for (Index k = 0; k < n; k++) {
+                Index i = this->uplo == Uplo::Lower ? k : n - 1 - k;
+                Index jhead = this->uplo == Uplo::Lower ? 0 : i + 1,
+                    jtail = this->uplo == Uplo::Lower ? i : n;
+                T *xi = x + m * i + head;
+                const T *ai = a[i];
+                for (Index j = jhead; j < jtail; j++) {
+                    T aij = ai[j];
+                    const T *xj = x + m * j + head;
+                    for (Index c = 0; c < width; c++) {
+                        xi[c] -= aij * xj[c];
+                    }
+                }
+                if (this->diag == Diag::NonUnit) {
+                    T inv = T(1) / ai[i];
+                    for (Index c = 0; c < width; c++) {
+                        xi[c] *= inv;
+                    }
+                }
+            }
+        });
+    }
+
+    /**
+     * @brief Solve A X = _B for multiple right hand sides
+     *
+     * @param _b            Right hand sides
+     * @return const Mat<T> Solutions
+     */
+    const Mat<T> Solve(const Mat<T> &_b) const {
+        Mat<T> retmat = _b;
+        this->SolveInPlace(retmat);
+        return retmat;
+    }
+
+    /**
+     * @brief Convert to Mat
+     *
+     * @return Mat<T>   Dense triangular matrix
+     */
+    operator Mat<T>() const {
+        Index n = this->Size();
+        Mat<T> retmat(n, n);
+        for (Index i = 0; i < n; i++) {
+            for (Index j = 0; j < n; j++) {
+                retmat[i][j] = (*this)(i, j);
+            }
+        }
+        return retmat;
+    }
+
+   private:
+    const Mat<T> *mat;
+    Uplo uplo;
+    Diag diag;
+};
+}  // namespace PANSFE
@@ -0,0 +1,255 @@
+/**
+ * @file tripletbuilder.h
+ * @author PANFACTORY (github/PANFACTORY)
+ * @brief Definition and implementation of parallel builder of compressed
+ * sparse row matrix from triplets
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "parallel.h"
+#include "profiler.h"
+#include "sparsemat.h"
+
+namespace PANSFE {
+/**
+ * @brief Builder collecting (row, column, value) triplets from any number of
+ * threads and compressing them into SparseMat, duplicates are summed
+ *
+ * Each thread appends to its own buffer without locking. Build sorts the
+ * triplets by two stable parallel counting sorts, by column and then by row,
+ * so the whole construction is O(nnz + row + column).
+ *
+ * @tparam T Type of element
+ */
+template <class T>
+class TripletBuilder {
+   public:
+    /**
+     * @brief Construct a new TripletBuilder object
+     *
+     * @param _row  Row of the matrix to build
+     * @param _col  Column of the matrix to build
+     */
+    TripletBuilder(int _row, int _col)
+        : row(_row), col(_col), id(NextId()) {}
+
+    TripletBuilder(const TripletBuilder<T> &) = delete;
+    TripletBuilder<T> &operator=(const TripletBuilder<T> &) = delete;
+
+    /**
+     * @brief Add _value to (_i, _j) element, safe to call from many threads
+     *
+     * @param _i        Index of row
+     * @param _j        Index of column
+     * @param _value    Value to add
+     */
+    void Add(int _i, int _j, T _value) {
+        assert(0 <= _i && _i < this->row && 0 <= _j && _j < this->col);
+        Buffer &buffer = this->Local();
+        buffer.rows.push_back(_i);
+        buffer.cols.push_back(_j);
+        buffer.values.push_back(_value);
+    }
+
+    /**
+     * @brief Get number of triplets collected
+     *
+     * @return long long    Number of triplets
+     */
+    long long Size() const {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        long long size = 0;
+        for (auto &buffer : this->buffers) {
+            size += buffer->rows.size();
+        }
+        return size;
+    }
+
+    /**
+     * @brief Discard collected triplets
+     *
+     */
+    void Clear() {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->buffers.clear();
+        this->id = NextId();
+    }
+
+    /**
+     * @brief Build CSR matrix with sorted columns and summed duplicates, the
+     * triplets are consumed
+     *
+     * No thread may Add during Build.
+     *
+     * @return const SparseMat<T>   Compressed matrix
+     */
+    const SparseMat<T> Build() {
+        PANSFE_PROFILE_SCOPE("TripletBuilder::Build", 0, 0);
+        std::vector<std::unique_ptr<Buffer> > buffers;
+        {
+            std::lock_guard<std::mutex> lock(this->mutex);
+            buffers.swap(this->buffers);
+            this->id = NextId();
+        }
+        std::vector<long long> head(buffers.size() + 1, 0);
+        for (size_t b = 0; b < buffers.size(); b++) {
+            head[b + 1] = head[b] + buffers[b]->rows.size();
+        }
+        long long n = head.back();
+        assert(n <= 2147483647LL);
+
+        std::vector<int> rows(n), cols(n);
+        std::vector<T> values(n);
+        ParallelFor(0, int(buffers.size()), [&](int _b) {
+            std::copy(buffers[_b]->rows.begin(), buffers[_b]->rows.end(),
+                      rows.begin() + head[_b]);
+            std::copy(buffers[_b]->cols.begin(), buffers[_b]->cols.end(),
+                      cols.begin() + head[_b]);
+            std::copy(buffers[_b]->values.begin(), buffers[_b]->values.end(),
+                      values.begin() + head[_b]);
+            buffers[_b].reset();
+        });
+
+        std::vector<int> sortedrows(n), sortedcols(n);
+        std::vector<T> sortedvalues(n);
+        CountingSort(n, cols.data(), this->col,
+                     [&](long long _e, long long _p) {
+                         sortedrows[_p] = rows[_e];
+                         sortedcols[_p] = cols[_e];
+                         sortedvalues[_p] = values[_e];
+                     });
+        std::vector<int>().swap(cols);
+        std::vector<T>().swap(values);
+
+        std::vector<long long> start;
+        std::vector<int> &rowcols = rows;
+        std::vector<T> rowvalues(n);
+        CountingSort(
+            n, sortedrows.data(), this->row,
+            [&](long long _e, long long _p) {
+                rowcols[_p] = sortedcols[_e];
+                rowvalues[_p] = sortedvalues[_e];
+            },
+            &start);
+        std::vector<int>().swap(sortedrows);
+        std::vector<int>().swap(sortedcols);
+        std::vector<T>().swap(sortedvalues);
+
+        std::vector<int> rowptr(this->row + 1, 0);
+        ParallelFor(
+            0, this->row,
+            [&](int _i) {
+                int unique = 0;
+                for (long long e = start[_i]; e < start[_i + 1]; e++) {
+                    unique += e == start[_i] || rowcols[e] != rowcols[e - 1];
+                }
+                rowptr[_i + 1] = unique;
+            },
+            1024);
+        for (int i = 0; i < this->row; i++) {
+            rowptr[i + 1] += rowptr[i];
+        }
+        std::vector<int> colind(rowptr[this->row]);
+        std::vector<T> compressed(rowptr[this->row]);
+        ParallelFor(
+            0, this->row,
+            [&](int _i) {
+                int p = rowptr[_i] - 1;
+                for (long long e = start[_i]; e < start[_i + 1]; e++) {
+                    if (e == start[_i] || rowcols[e] != rowcols[e - 1]) {
+                        p++;
+                        colind[p] = rowcols[e];
+                        compressed[p] = rowvalues[e];
+                    } else {
+                        compressed[p] += rowvalues[e];
+                    }
+                }
+            },
+            1024);
+        return SparseMat<T>(this->row, this->col, std::move(rowptr),
+                            std::move(colind), std::move(compressed));
+    }
+
+   private:
+    struct Buffer {
+        std::vector<int> rows, cols;
+        std::vector<T> values;
+    };
+
+    int row, col;
+    unsigned long long id;
+    mutable std::mutex mutex;
+    std::vector<std::unique_ptr<Buffer> > buffers;
+
+    static unsigned long long NextId() {
+        static std::atomic<unsigned long long> counter(0);
+        return ++counter;
+    }
+
+    Buffer &Local() {
+        static thread_local std::pair<unsigned long long, Buffer *> cache(
+            0, nullptr);
+        if (cache.first != this->id) {
+            std::lock_guard<std::mutex> lock(this->mutex);
+            this->buffers.emplace_back(new Buffer());
+            cache = std::make_pair(this->id, this->buffers.back().get());
+        }
+        return *cache.second;
+    }
+
+    template <class F>
+    static void CountingSort(long long _n, const int *_key, int _numkeys,
+                             const F &_move,
+                             std::vector<long long> *_start = nullptr) {
+        int chunks = int(std::max<long long>(
+            1, std::min<long long>(GetNumThreads(),
+                                   _n / (2 * ((long long)_numkeys + 1)))));
+        long long chunksize = (_n + chunks - 1) / chunks;
+        std::vector<long long> offset((long long)chunks * _numkeys, 0);
+        ParallelFor(0, chunks, [&](int _c) {
+            long long *count = &offset[(long long)_numkeys * _c];
+            long long tail = std::min(_n, chunksize * (_c + 1));
+            for (long long e = chunksize * _c; e < tail; e++) {
+                count[_key[e]]++;
+            }
+        });
+        if (_start) {
+            _start->assign(_numkeys + 1, 0);
+        }
+        long long position = 0;
+        for (int k = 0; k < _numkeys; k++) {
+            if (_start) {
+                (*_start)[k] = position;
+            }
+            for (int c = 0; c < chunks; c++) {
+                long long count = offset[(long long)_numkeys * c + k];
+                offset[(long long)_numkeys * c + k] = position;
+                position += count;
+            }
+        }
+        if (_start) {
+            (*_start)[_numkeys] = position;
+        }
+        ParallelFor(0, chunks, [&](int _c) {
+            long long *next = &offset[(long long)_numkeys * _c];
+            long long tail = std::min(_n, chunksize * (_c + 1));
+            for (long long e = chunksize * _c; e < tail; e++) {
+                _move(e, next[_key[e]]++);
+            }
+        });
+    }
+};
+}  // namespace PANSFE
@@ -0,0 +1,26 @@
+/**
+ * @file uplo.h
+ * @author PANFACTORY (github/PANFACTORY)
+ * @brief Definition of triangle and diagonal specifiers
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#pragma once
+
+namespace PANSFE {
+/**
+ * @brief Which triangle of a matrix is referenced
+ *
+ */
+enum class Uplo { Lower, Upper };
+
+/**
+ * @brief Whether the diagonal is implicitly one (Unit) or read (NonUnit)
+ *
+ */
+enum class Diag { NonUnit, Unit };
+}  // namespace PANSFE
@@ -13,8 +13,21 @@
 #include <cassert>
 #include <cmath>
 #include <iostream>
+#include <memory>
 
+#include "index.h"
 #include "mat.h"
+#include "profiler.h"
+#include "reduction.h"
+
+/**
+ * @brief Number of elements a Vec stores inline without heap allocation,
+ * may be redefined before including any header
+ *
+ */
+#ifndef PANSFE_VEC_INLINE_CAPACITY
+#define PANSFE_VEC_INLINE_CAPACITY 4
+#endif
 
 namespace PANSFE {
 template <class T>
@@ -23,6 +36,13 @@ class Mat;
 /**
  * @brief Linear algebraic vector class
  *
+ * Vectors of at most PANSFE_VEC_INLINE_CAPACITY elements are stored inside
+ * the object and larger ones on the heap. With SetCopyOnWrite, copies share
+ * the heap buffer until one of them is mutated. Element access through
+ * operator[] and operator() is a plain load or store, so call BeginWrite
+ * once before writing elements of a vector that may share its buffer;
+ * Values() and the other mutating members do so themselves.
+ *
  * @tparam T Type of element
  */
 template <class T>
@@ -34,6 +54,8 @@ class Vec {
 
     template <class U>
     friend class Mat;
+    template <class U>
+    friend class Vec;
 
    public:
     /**
@@ -42,7 +64,9 @@ class Vec {
      */
     Vec() {
         this->size = 0;
+        this->capacity = 0;
         this->values = nullptr;
+        this->cow = false;
     }
 
     /**
@@ -52,68 +76,179 @@ class Vec {
      * @param _size     Size of the Vec object
      * @param _value    Each element value of the Vec object
      */
-    explicit Vec(int _size, T _value = T()) {
+    explicit Vec(Index _size, T _value = T()) {
+        PANSFE_PROFILE_SCOPE("Vec::Vec", 0, sizeof(T) * _size);
         this->size = _size;
-        if (this->size > 0) {
-            this->values = new T[this->size];
-            for (int i = 0; i < this->size; i++) {
-                this->values[i] = _value;
-            }
-        } else {
-            this->values = nullptr;
+        this->cow = false;
+        this->Allocate(this->size);
+        for (Index i = 0; i < this->size; i++) {
+            this->values[i] = _value;
         }
     }
 
+    /**
+     * @brief Construct a new Vec object whose size is _size without
+     * initializing elements
+     *
+     * @param _size     Size of the Vec object
+     */
+    Vec(Index _size, Uninitialized) {
+        this->size = _size;
+        this->cow = false;
+        this->Allocate(this->size);
+    }
+
     /**
      * @brief Construct a new Vec object
      *
      * @param _values   Format like {1, 2, 3}
      */
     Vec(const std::initializer_list<T> &_values) {
+        PANSFE_PROFILE_SCOPE("Vec::Vec", 0, 2 * sizeof(T) * _values.size());
         this->size = _values.size();
-        if (this->size > 0) {
-            this->values = new T[this->size];
-            for (int i = 0; i < this->size; i++) {
-                this->values[i] = *(_values.begin() + i);
-            }
-        } else {
-            this->values = nullptr;
+        this->cow = false;
+        this->Allocate(this->size);
+        for (Index i = 0; i < this->size; i++) {
+            this->values[i] = *(_values.begin() + i);
         }
     }
 
     /**
-     * @brief Copy constructor (deep copy)
+     * @brief Copy constructor (deep copy, or sharing the buffer when _vec is
+     * copy-on-write)
      *
      * @param _vec      Copy source
      */
     Vec(const Vec<T> &_vec) {
+        PANSFE_PROFILE_SCOPE("Vec::Vec", 0, 2 * sizeof(T) * _vec.size);
         this->size = _vec.size;
-        if (this->size > 0) {
-            this->values = new T[this->size];
-            for (int i = 0; i < this->size; i++) {
-                this->values[i] = _vec.values[i];
-            }
-        } else {
-            this->values = nullptr;
+        this->cow = _vec.cow;
+        if (_vec.cow && _vec.shared) {
+            this->Share(_vec);
+            return;
+        }
+        this->Allocate(this->size);
+        for (Index i = 0; i < this->size; i++) {
+            this->values[i] = _vec.values[i];
         }
     }
 
     /**
-     * @brief Destroy the Vec object
+     * @brief Construct a new Vec object converting each element of _vec
      *
+     * @tparam U    Element type of the source vector
+     * @param _vec  Conversion source
      */
-    ~Vec() {
-        if (this->values) {
-            delete[] this->values;
+    template <class U>
+    explicit Vec(const Vec<U> &_vec) {
+        PANSFE_PROFILE_SCOPE("Vec::Vec", _vec.size,
+                             (sizeof(T) + sizeof(U)) * _vec.size);
+        this->size = _vec.size;
+        this->cow = false;
+        this->Allocate(this->size);
+        const U *source = _vec.values;
+        T *destination = this->values;
+        for (Index i = 0; i < this->size; i++) {
+            destination[i] = static_cast<T>(source[i]);
         }
     }
 
+    /**
+     * @brief Destroy the Vec object
+     *
+     */
+    ~Vec() { this->Release(); }
+
     /**
      * @brief Get number of element
      *
-     * @return int  number of element
+     * @return Index  number of element
+     */
+    Index Size() const { return this->size; }
+
+    /**
+     * @brief Get number of elements storable without reallocation
+     *
+     * @return Index    Number of elements storable without reallocation
+     */
+    Index Capacity() const { return this->capacity; }
+
+    /**
+     * @brief Share heap buffer among copies until one of them is mutated
+     *
+     * The reference count is thread-safe, so copies may be read and detached
+     * from different threads.
+     *
+     * @param _cow  Whether copies share the buffer
+     */
+    void SetCopyOnWrite(bool _cow) {
+        this->Detach();
+        this->cow = _cow;
+        if (this->cow && this->values && this->values != this->buffer &&
+            !this->shared) {
+            this->shared.reset(this->values, std::default_delete<T[]>());
+        }
+    }
+
+    /**
+     * @brief Check whether the buffer is shared with another copy
+     *
+     * @return true     Buffer is shared
+     * @return false    Buffer is owned exclusively
+     */
+    bool IsShared() const {
+        return this->shared && this->shared.use_count() > 1;
+    }
+
+    /**
+     * @brief Ensure storage for _capacity elements keeping element values
+     *
+     * @param _capacity Number of elements storable without reallocation
+     */
+    void Reserve(Index _capacity) {
+        if (_capacity <= this->capacity) {
+            return;
+        }
+        PANSFE_PROFILE_SCOPE("Vec::Reserve", 0, 2 * sizeof(T) * this->size);
+        T *values = this->values;
+        std::shared_ptr<T> shared = this->shared;
+        this->Allocate(_capacity);
+        for (Index i = 0; i < this->size; i++) {
+            this->values[i] = values[i];
+        }
+        if (values && values != this->buffer && !shared) {
+            delete[] values;
+        }
+    }
+
+    /**
+     * @brief Change size keeping leading element values, added elements are
+     * _value and storage is reallocated only when capacity is exceeded
+     *
+     * @param _size     New size
+     * @param _value    Value of added elements
+     */
+    void Resize(Index _size, T _value = T()) {
+        Index size = this->size;
+        this->Resize(_size, Uninitialized());
+        for (Index i = size; i < this->size; i++) {
+            this->values[i] = _value;
+        }
+    }
+
+    /**
+     * @brief Change size keeping leading element values, added elements are
+     * not initialized and storage is reallocated only when capacity is
+     * exceeded
+     *
+     * @param _size     New size
      */
-    int Size() const { return this->size; }
+    void Resize(Index _size, Uninitialized) {
+        assert(0 <= _size);
+        this->Detach();
+        this->Reserve(_size);
+        this->size = _size;
+    }
 
     /**
      * @brief Get _i th element value without validation
@@ -121,7 +256,15 @@ class Vec {
      * @param _i    Index of element
      * @return T&   Reference of _i th element
      */
-    T &operator[](int _i) { return this->values[_i]; }
+    T &operator[](Index _i) { return this->values[_i]; }
+
+    /**
+     * @brief Get _i th element value without validation
+     *
+     * @param _i        Index of element
+     * @return const T& Reference of _i th element
+     */
+    const T &operator[](Index _i) const { return this->values[_i]; }
 
     /**
      * @brief Get _i th element value with validation
@@ -129,17 +272,34 @@ class Vec {
      * @param _i    Index of element
      * @return T&   Reference of _i th element
      */
-    T &operator()(int _i) {
+    T &operator()(Index _i) {
         assert(0 <= _i && _i < this->size);
         return this->values[_i];
     }
 
+    /**
+     * @brief Detach shared buffer before writing elements through operator[]
+     * or operator()
+     *
+     */
+    void BeginWrite() { this->Detach(); }
+
     /**
      * @brief Get pointer indicating value
      *
      * @return T*   Pointer indicating value
      */
-    T *Values() { return this->values; }
+    T *Values() {
+        this->Detach();
+        return this->values;
+    }
+
+    /**
+     * @brief Get pointer indicating value
+     *
+     * @return const T* Pointer indicating value
+     */
+    const T *Values() const { return this->values; }
 
     /**
      * @brief Check the same
@@ -152,7 +312,7 @@ class Vec {
         if (this->size != _vec.size) {
             return false;
         }
-        for (int i = 0; i < this->size; ++i) {
+        for (Index i = 0; i < this->size; ++i) {
             if (this->values[i] != _vec.values[i]) {
                 return false;
             }
@@ -176,13 +336,21 @@ class Vec {
      * @return Vec<T>&  Reference of this object
      */
     Vec<T> &operator=(const Vec<T> &_vec) {
+        PANSFE_PROFILE_SCOPE("Vec::operator=", 0, 2 * sizeof(T) * _vec.size);
         if (this != &_vec) {
-            if (this->values) {
-                delete[] this->values;
+            if (_vec.cow && _vec.shared) {
+                this->Release();
+                this->size = _vec.size;
+                this->cow = true;
+                this->Share(_vec);
+                return *this;
+            }
+            if (this->capacity < _vec.size || this->IsShared()) {
+                this->Release();
+                this->Allocate(_vec.size);
             }
             this->size = _vec.size;
-            this->values = new T[this->size];
-            for (int i = 0; i < this->size; i++) {
+            for (Index i = 0; i < this->size; i++) {
                 this->values[i] = _vec.values[i];
             }
         }
@@ -196,8 +364,11 @@ class Vec {
      * @return Vec<T>&  Reference of this object
      */
     Vec<T> &operator+=(const Vec<T> &_vec) {
+        PANSFE_PROFILE_SCOPE("Vec::operator+=", this->size,
+                             3 * sizeof(T) * this->size);
         assert(this->size == _vec.size);
-        for (int i = 0; i < this->size; i++) {
+        this->Detach();
+        for (Index i = 0; i < this->size; i++) {
             this->values[i] += _vec.values[i];
         }
         return *this;
@@ -210,8 +381,11 @@ class Vec {
      * @return Vec<T>&  Reference of this object
      */
     Vec<T> &operator-=(const Vec<T> &_vec) {
+        PANSFE_PROFILE_SCOPE("Vec::operator-=", this->size,
+                             3 * sizeof(T) * this->size);
         assert(this->size == _vec.size);
-        for (int i = 0; i < this->size; i++) {
+        this->Detach();
+        for (Index i = 0; i < this->size; i++) {
             this->values[i] -= _vec.values[i];
         }
         return *this;
@@ -224,7 +398,10 @@ class Vec {
      * @return Vec<T>&  Reference of this object
      */
     Vec<T> &operator*=(T _a) {
-        for (int i = 0; i < this->size; i++) {
+        PANSFE_PROFILE_SCOPE("Vec::operator*=", this->size,
+                             2 * sizeof(T) * this->size);
+        this->Detach();
+        for (Index i = 0; i < this->size; i++) {
             this->values[i] *= _a;
         }
         return *this;
@@ -237,7 +414,10 @@ class Vec {
      * @return Vec<T>&  Reference of this object
      */
     Vec<T> &operator/=(T _a) {
-        for (int i = 0; i < this->size; i++) {
+        PANSFE_PROFILE_SCOPE("Vec::operator/=", this->size,
+                             2 * sizeof(T) * this->size);
+        this->Detach();
+        for (Index i = 0; i < this->size; i++) {
             this->values[i] /= _a;
         }
         return *this;
@@ -250,8 +430,13 @@ class Vec {
      * @return const Vec<T> Added vector
      */
     const Vec<T> operator+(const Vec<T> &_vec) const {
-        Vec<T> retvec = *this;
-        retvec += _vec;
+        PANSFE_PROFILE_SCOPE("Vec::operator+", this->size,
+                             3 * sizeof(T) * this->size);
+        assert(this->size == _vec.size);
+        Vec<T> retvec(this->size, Uninitialized());
+        for (Index i = 0; i < this->size; i++) {
+            retvec.values[i] = this->values[i] + _vec.values[i];
+        }
         return retvec;
     }
 
@@ -262,8 +447,13 @@ class Vec {
      * @return const Vec<T> Subtracted vector
      */
     const Vec<T> operator-(const Vec<T> &_vec) const {
-        Vec<T> retvec = *this;
-        retvec -= _vec;
+        PANSFE_PROFILE_SCOPE("Vec::operator-(Vec)", this->size,
+                             3 * sizeof(T) * this->size);
+        assert(this->size == _vec.size);
+        Vec<T> retvec(this->size, Uninitialized());
+        for (Index i = 0; i < this->size; i++) {
+            retvec.values[i] = this->values[i] - _vec.values[i];
+        }
         return retvec;
     }
 
@@ -272,7 +462,15 @@ class Vec {
      *
      * @return const Vec<T> Reverse vector
      */
-    const Vec<T> operator-() const { return Vec<T>(this->size) - *this; }
+    const Vec<T> operator-() const {
+        PANSFE_PROFILE_SCOPE("Vec::operator-()", this->size,
+                             2 * sizeof(T) * this->size);
+        Vec<T> retvec(this->size, Uninitialized());
+        for (Index i = 0; i < this->size; i++) {
+            retvec.values[i] = -this->values[i];
+        }
+        return retvec;
+    }
 
     /**
      * @brief Get multipled vector
@@ -281,8 +479,12 @@ class Vec {
      * @return const Vec<T> Multipled vector
      */
     const Vec<T> operator*(T _a) const {
-        Vec<T> retvec = *this;
-        retvec *= _a;
+        PANSFE_PROFILE_SCOPE("Vec::operator*(T)", this->size,
+                             2 * sizeof(T) * this->size);
+        Vec<T> retvec(this->size, Uninitialized());
+        for (Index i = 0; i < this->size; i++) {
+            retvec.values[i] = this->values[i] * _a;
+        }
         return retvec;
     }
 
@@ -293,10 +495,14 @@ class Vec {
      * @return Mat<T>   Matrix from vector matrix product
      */
     Mat<T> operator*(const Mat<T> &_mat) {
+        PANSFE_PROFILE_SCOPE(
+            "Vec::operator*(Mat)", double(this->size) * _mat.col,
+            sizeof(T) *
+                (this->size + _mat.col + double(this->size) * _mat.col));
         assert(_mat.row == 1);
-        Mat<T> retmat(this->size, _mat.col);
-        for (int i = 0; i < retmat.row; ++i) {
-            for (int j = 0; j < retmat.col; ++j) {
+        Mat<T> retmat(this->size, _mat.col, Uninitialized());
+        for (Index i = 0; i < retmat.row; ++i) {
+            for (Index j = 0; j < retmat.col; ++j) {
                 retmat.values[retmat.col * i + j] =
                     this->values[i] * _mat.values[j];
             }
@@ -311,8 +517,12 @@ class Vec {
      * @return const Vec<T> Devided vector
      */
     const Vec<T> operator/(T _a) {
-        Vec<T> retvec = *this;
-        retvec /= _a;
+        PANSFE_PROFILE_SCOPE("Vec::operator/", this->size,
+                             2 * sizeof(T) * this->size);
+        Vec<T> retvec(this->size, Uninitialized());
+        for (Index i = 0; i < this->size; i++) {
+            retvec.values[i] = this->values[i] / _a;
+        }
         return retvec;
     }
 
@@ -322,8 +532,10 @@ class Vec {
      * @return Mat<T>   Mat object converted from this object
      */
     operator Mat<T>() const {
-        Mat<T> retmat(this->size, 1);
-        for (int i = 0; i < retmat.row * retmat.col; i++) {
+        PANSFE_PROFILE_SCOPE("Vec::operator Mat", 0,
+                             2 * sizeof(T) * this->size);
+        Mat<T> retmat(this->size, 1, Uninitialized());
+        for (Index i = 0; i < retmat.row * retmat.col; i++) {
             retmat.values[i] = this->values[i];
         }
         return retmat;
@@ -342,9 +554,15 @@ class Vec {
     /**
      * @brief Get norm of this vector
      *
+     * The sum of squares is a deterministic parallel pairwise reduction, so
+     * the result does not depend on the number of threads.
+     *
      * @return T    Norm of this vector
      */
-    T Norm() const { return sqrt((*this).Dot(*this)); }
+    T Norm() const {
+        PANSFE_PROFILE_SCOPE("Vec::Norm", 1, 0);
+        return sqrt((*this).Dot(*this));
+    }
 
     /**
      * @brief Normalize vector
@@ -352,6 +570,7 @@ class Vec {
      * @return const Vec<T> Normalized vector
      */
     const Vec<T> Normal() const {
+        PANSFE_PROFILE_SCOPE("Vec::Normal", 0, 0);
         Vec<T> retvec = *this;
         return retvec / retvec.Norm();
     }
@@ -359,16 +578,32 @@ class Vec {
     /**
      * @brief Get scalar product
      *
+     * Products are summed by a deterministic parallel pairwise reduction, so
+     * the result does not depend on the number of threads.
+     *
      * @param _vec  Vector used scalar product
      * @return T    Scalar product
      */
     T Dot(const Vec<T> &_vec) const {
+        PANSFE_PROFILE_SCOPE("Vec::Dot", 2 * this->size,
+                             2 * sizeof(T) * this->size);
         assert(this->size == _vec.size);
-        T retvalue = T();
-        for (int i = 0; i < this->size; i++) {
-            retvalue += this->values[i] * _vec.values[i];
-        }
-        return retvalue;
+        const T *a = this->values, *b = _vec.values;
+        return Reduce<T>(this->size, [=](Index _i) { return a[_i] * b[_i]; });
+    }
+
+    /**
+     * @brief Get sum of elements
+     *
+     * Elements are summed by a deterministic parallel pairwise reduction, so
+     * the result does not depend on the number of threads.
+     *
+     * @return T    Sum of elements
+     */
+    T Sum() const {
+        PANSFE_PROFILE_SCOPE("Vec::Sum", this->size, sizeof(T) * this->size);
+        const T *a = this->values;
+        return Reduce<T>(this->size, [=](Index _i) { return a[_i]; });
     }
 
     /**
@@ -378,8 +613,9 @@ class Vec {
      * @return const Vec<T> Vector product
      */
     const Vec<T> Cross(const Vec<T> &_vec) const {
+        PANSFE_PROFILE_SCOPE("Vec::Cross", 9, 9 * sizeof(T));
         assert(this->size == 3 && _vec.size == 3);
-        Vec<T> retvec(3);
+        Vec<T> retvec(3, Uninitialized());
         retvec[0] =
             this->values[1] * _vec.values[2] - this->values[2] * _vec.values[1];
         retvec[1] =
@@ -396,11 +632,13 @@ class Vec {
      * @return const Vec<T> Stacked vector
      */
     const Vec<T> Vstack(const Vec<T> &_vec) const {
-        Vec<T> retvec(this->size + _vec.size);
-        for (int i = 0; i < this->size; i++) {
+        PANSFE_PROFILE_SCOPE("Vec::Vstack", 0,
+                             2 * sizeof(T) * (this->size + _vec.size));
+        Vec<T> retvec(this->size + _vec.size, Uninitialized());
+        for (Index i = 0; i < this->size; i++) {
             retvec.values[i] = this->values[i];
         }
-        for (int i = 0; i < _vec.size; i++) {
+        for (Index i = 0; i < _vec.size; i++) {
             retvec.values[i + this->size] = _vec.values[i];
         }
         return retvec;
@@ -413,11 +651,14 @@ class Vec {
      * @return const Mat<T> Stacked matrix
      */
     const Mat<T> Hstack(const Mat<T> &_mat) const {
+        PANSFE_PROFILE_SCOPE(
+            "Vec::Hstack", 0,
+            2 * sizeof(T) * (this->size + double(_mat.row) * _mat.col));
         assert(this->size == _mat.row);
-        Mat<T> retmat(this->size, _mat.col + 1);
-        for (int i = 0; i < retmat.row; i++) {
+        Mat<T> retmat(this->size, _mat.col + 1, Uninitialized());
+        for (Index i = 0; i < retmat.row; i++) {
             retmat.values[retmat.col * i] = this->values[i];
-            for (int j = 1; j < retmat.col; j++) {
+            for (Index j = 1; j < retmat.col; j++) {
                 retmat.values[retmat.col * i + j] =
                     _mat.values[_mat.col * i + j - 1];
             }
@@ -432,10 +673,11 @@ class Vec {
      * @param _length       Length of subvector
      * @return const Vec<T> Subvector
      */
-    const Vec<T> Block(int _head, int _length) const {
+    const Vec<T> Block(Index _head, Index _length) const {
+        PANSFE_PROFILE_SCOPE("Vec::Block", 0, 2 * sizeof(T) * _length);
         assert(0 <= _head && 0 <= _length && _head + _length < this->size);
-        Vec<T> retvec(_length);
-        for (int i = 0; i < retvec.size; i++) {
+        Vec<T> retvec(_length, Uninitialized());
+        for (Index i = 0; i < retvec.size; i++) {
             retvec.values[i] = this->values[_head + i];
         }
         return retvec;
@@ -447,8 +689,9 @@ class Vec {
      * @return const Mat<T> Transposed matrix
      */
     const Mat<T> Transpose() const {
-        Mat<T> retmat(1, this->size);
-        for (int i = 0; i < retmat.row * retmat.col; i++) {
+        PANSFE_PROFILE_SCOPE("Vec::Transpose", 0, 2 * sizeof(T) * this->size);
+        Mat<T> retmat(1, this->size, Uninitialized());
+        for (Index i = 0; i < retmat.row * retmat.col; i++) {
             retmat.values[i] = this->values[i];
         }
         return retmat;
@@ -460,16 +703,68 @@ class Vec {
      * @return const Mat<T> Diagonal matrix
      */
     const Mat<T> Diagonal() const {
+        PANSFE_PROFILE_SCOPE("Vec::Diagonal", 0,
+                             sizeof(T) * (this->size + double(this->size) *
+                                                          this->size));
         Mat<T> retmat(this->size, this->size);
-        for (int i = 0; i < this->size; i++) {
+        for (Index i = 0; i < this->size; i++) {
             retmat.values[retmat.col * i + i] = this->values[i];
         }
         return retmat;
     }
 
    private:
-    int size;
+    static const Index InlineCapacity = PANSFE_VEC_INLINE_CAPACITY;
+
+    Index size, capacity;
     T *values;
+    T buffer[InlineCapacity > 0 ? InlineCapacity : 1];
+    std::shared_ptr<T> shared;
+    bool cow;
+
+    void Allocate(Index _capacity) {
+        if (_capacity <= 0) {
+            this->values = nullptr;
+            this->capacity = 0;
+        } else if (_capacity <= InlineCapacity) {
+            this->values = this->buffer;
+            this->capacity = InlineCapacity;
+        } else {
+            this->values = new T[_capacity];
+            PANSFE_PROFILE_ALLOC(sizeof(T) * _capacity);
+            this->capacity = _capacity;
+        }
+        if (this->cow && this->values && this->values != this->buffer) {
+            this->shared.reset(this->values, std::default_delete<T[]>());
+        } else {
+            this->shared.reset();
+        }
+    }
+
+    void Release() {
+        if (this->shared) {
+            this->shared.reset();
+        } else if (this->values && this->values != this->buffer) {
+            delete[] this->values;
+        }
+    }
+
+    void Share(const Vec<T> &_vec) {
+        this->shared = _vec.shared;
+        this->values = this->shared.get();
+        this->capacity = _vec.capacity;
+    }
+
+    void Detach() {
+        if (this->shared && this->shared.use_count() > 1) {
+            PANSFE_PROFILE_SCOPE("Vec::Detach", 0, 2 * sizeof(T) * this->size);
+            std::shared_ptr<T> shared = this->shared;
+            this->Allocate(this->capacity);
+            for (Index i = 0; i < this->size; i++) {
+                this->values[i] = shared.get()[i];
+            }
+        }
+    }
 };
 
 /**
@@ -482,8 +777,8 @@ class Vec {
  */
 template <class U>
 inline std::ostream &operator<<(std::ostream &_out, const Vec<U> &_vec) {
-    for (int i = 0; i < _vec.size; i++) {
-        _out << _vec.values[i] << std::endl;
+    for (Index i = 0; i < _vec.size; i++) {
+        _out << _vec.values[i] << '\n';
     }
     return _out;
 }
@@ -0,0 +1,138 @@
+/**
+ * @file woodbury.h
+ * @author PANFACTORY (github/PANFACTORY)
+ * @brief Definition and implementation of Sherman-Morrison-Woodbury solver
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#pragma once
+#include <cassert>
+#include <functional>
+
+#include "lu.h"
+#include "mat.h"
+#include "profiler.h"
+#include "vec.h"
+
+namespace PANSFE {
+/**
+ * @brief Solver of (A + U V^T) x = b reusing a factorization of A
+ *
+ * (A + U V^T)^-1 = A^-1 - A^-1 U (I + V^T A^-1 U)^-1 V^T A^-1, so setup costs
+ * k solves with A and each solve costs one solve with A plus O(n k). The
+ * factorization of A is referred by pointer and must outlive the solver, so
+ * a temporary factorization is rejected at compile time.
+ *
+ * @tparam T Type of element
+ */
+template <class T>
+class Woodbury {
+   public:
+    /**
+     * @brief Construct a new Woodbury object
+     *
+     * @tparam F        Type providing SolveInPlace(Vec<T>&), such as LU or
+     * Cholesky
+     * @param _factor   Factorization of A
+     * @param _u        n x k matrix U
+     * @param _v        n x k matrix V
+     */
+    template <class F>
+    Woodbury(const F &_factor, const Mat<T> &_u, const Mat<T> &_v)
+        : v(_v), z(_u.Row(), _u.Col()) {
+        PANSFE_PROFILE_SCOPE("Woodbury::Woodbury", 0, 0);
+        assert(_u.Row() == _v.Row() && _u.Col() == _v.Col());
+        const F *factor = &_factor;
+        this->solve = [factor](Vec<T> &_x) { factor->SolveInPlace(_x); };
+        Index n = _u.Row(), k = _u.Col();
+        Vec<T> column(n);
+        for (Index j = 0; j < k; j++) {
+            for (Index i = 0; i < n; i++) {
+                column[i] = _u[i][j];
+            }
+            this->solve(column);
+            for (Index i = 0; i < n; i++) {
+                this->z[i][j] = column[i];
+            }
+        }
+        Mat<T> capacitance = Mat<T>::Identity(k);
+        const Mat<T> &z = this->z;
+        for (Index p = 0; p < k; p++) {
+            for (Index q = 0; q < k; q++) {
+                T sum = T();
+                for (Index i = 0; i < n; i++) {
+                    sum += _v[i][p] * z[i][q];
+                }
+                capacitance[p][q] += sum;
+            }
+        }
+        this->capacitance = LU<T>(capacitance);
+    }
+
+    /**
+     * @brief Refuse a temporary factorization, which would dangle once the
+     * expression ends
+     *
+     * @tparam F    Type providing SolveInPlace(Vec<T>&)
+     */
+    template <class F>
+    Woodbury(const F &&, const Mat<T> &, const Mat<T> &) = delete;
+
+    /**
+     * @brief Check whether A + U V^T is singular
+     *
+     * @return true     Capacitance matrix I + V^T A^-1 U is singular
+     * @return false    Capacitance matrix is not singular
+     */
+    bool IsSingular() const { return this->capacitance.IsSingular(); }
+
+    /**
+     * @brief Solve (A + U V^T) x = _b in place
+     *
+     * @param _x    Right hand side on input and solution on output
+     */
+    void SolveInPlace(Vec<T> &_x) const {
+        PANSFE_PROFILE_SCOPE("Woodbury::Solve", 0, 0);
+        const Mat<T> &v = this->v, &z = this->z;
+        Index n = v.Row(), k = v.Col();
+        assert(_x.Size() == n);
+        this->solve(_x);
+        T *x = _x.Values();
+        Vec<T> t(k);
+        for (Index i = 0; i < n; i++) {
+            for (Index p = 0; p < k; p++) {
+                t[p] += v[i][p] * x[i];
+            }
+        }
+        this->capacitance.SolveInPlace(t);
+        for (Index i = 0; i < n; i++) {
+            T sum = T();
+            for (Index p = 0; p < k; p++) {
+                sum += z[i][p] * t[p];
+            }
+            x[i] -= sum;
+        }
+    }
+
+    /**
+     * @brief Solve (A + U V^T) x = _b
+     *
+     * @param _b            Right hand side
+     * @return const Vec<T> Solution
+     */
+    const Vec<T> Solve(const Vec<T> &_b) const {
+        Vec<T> retvec = _b;
+        this->SolveInPlace(retvec);
+        return retvec;
+    }
+
+   private:
+    Mat<T> v, z;
+    LU<T> capacitance;
+    std::function<void(Vec<T> &)> solve;
+};
+}  // namespace PANSFE
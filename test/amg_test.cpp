@@ -0,0 +1,71 @@
+#include "../src/amg.h"
+
+#include <gtest/gtest.h>
+
+#include "../src/iterative.h"
+#include "laplacian.h"
+
+TEST(AMGTest, AMGHierarchyTest1) {
+    PANSFE::SparseMat<double> a = Laplacian(64);
+    PANSFE::AMG<double> amg(a);
+    ASSERT_GE(amg.Levels(), 3);
+    ASSERT_LE(amg.LevelMatrix(amg.Levels() - 1).Row(), 64);
+    for (int l = 1; l < amg.Levels(); l++) {
+        ASSERT_LT(4 * amg.LevelMatrix(l).Row(), amg.LevelMatrix(l - 1).Row());
+    }
+    ASSERT_LT(amg.OperatorComplexity(), 2.0);
+    PANSFE::SetNumThreads(4);
+    PANSFE::AMG<double> parallel(a);
+    PANSFE::SetNumThreads(0);
+    ASSERT_EQ(parallel.Levels(), amg.Levels());
+    for (int l = 0; l < amg.Levels(); l++) {
+        ASSERT_EQ(parallel.LevelMatrix(l).ColInd(),
+                  amg.LevelMatrix(l).ColInd());
+    }
+}
+
+TEST(AMGTest, AMGSolveTest1) {
+    PANSFE::SparseMat<double> a = Laplacian(64);
+    PANSFE::Vec<double> b(a.Row(), 1.0);
+    PANSFE::AMG<double> amg(a);
+    amg.SetTolerance(1e-8, 100);
+    PANSFE::AMGSmoother smoothers[] = {PANSFE::AMGSmoother::Jacobi,
+                                       PANSFE::AMGSmoother::GaussSeidel,
+                                       PANSFE::AMGSmoother::Chebyshev};
+    for (PANSFE::AMGSmoother smoother : smoothers) {
+        for (PANSFE::AMGCycle cycle :
+             {PANSFE::AMGCycle::V, PANSFE::AMGCycle::W}) {
+            amg.SetSmoother(smoother,
+                            smoother == PANSFE::AMGSmoother::Chebyshev ? 3 : 2);
+            amg.SetCycle(cycle);
+            PANSFE::Vec<double> x = amg.Solve(b);
+            ASSERT_TRUE(amg.IsConverged());
+            ASSERT_LE(amg.Iteration(), 60);
+            ASSERT_LE((b - a * x).Norm(), 1e-8 * b.Norm());
+        }
+    }
+}
+
+TEST(AMGTest, AMGPreconditionerTest1) {
+    PANSFE::SparseMat<double> a = Laplacian(64);
+    PANSFE::Vec<double> b(a.Row(), 1.0);
+    PANSFE::ConjugateGradient<double> solver(a, 1e-8);
+    solver.Solve(b);
+    int plain = solver.Iteration();
+    PANSFE::AMG<double> amg(a);
+    solver.SetPreconditioner(amg.Operator());
+    PANSFE::Vec<double> x = solver.Solve(b);
+    ASSERT_TRUE(solver.IsConverged());
+    ASSERT_LT(solver.Iteration(), plain / 4);
+    ASSERT_LE((b - a * x).Norm(), 1e-7 * b.Norm());
+
+    PANSFE::SparseMat<double> c = Laplacian(64, 2.0);
+    amg.Update(c);
+    PANSFE::ConjugateGradient<double> scaled(c, 1e-8);
+    scaled.SetPreconditioner(amg.Operator());
+    PANSFE::Vec<double> y = scaled.Solve(b);
+    ASSERT_TRUE(scaled.IsConverged());
+    for (int i = 0; i < a.Row(); i++) {
+        ASSERT_NEAR(2.0 * y[i], x[i], 1e-6);
+    }
+}
@@ -0,0 +1,89 @@
+#include "../src/bandmat.h"
+
+#include <gtest/gtest.h>
+
+TEST(BandMatTest, BandMatConstructorTest1) {
+    PANSFE::Mat<int> a = {
+        {1, 2, 0, 0}, {3, 4, 5, 0}, {0, 6, 7, 8}, {0, 0, 9, 1}};
+    const PANSFE::BandMat<int> b(a, 1, 1);
+    ASSERT_EQ(b.Size(), 4);
+    ASSERT_EQ(b(2, 1), 6);
+    ASSERT_EQ(b(0, 3), 0);
+    ASSERT_EQ(PANSFE::Mat<int>(b), a);
+}
+
+TEST(BandMatTest, BandMatOperatorTest1) {
+    PANSFE::Mat<int> a = {
+        {1, 2, 0, 0}, {3, 4, 5, 0}, {0, 6, 7, 8}, {0, 0, 9, 1}};
+    PANSFE::Vec<int> x = {1, -1, 2, 3};
+    ASSERT_EQ(PANSFE::BandMat<int>(a, 1, 1) * x, a * x);
+}
+
+TEST(BandMatTest, BandMatSolveTest1) {
+    int n = 40;
+    PANSFE::Mat<double> a(n, n);
+    for (int i = 0; i < n; i++) {
+        for (int j = std::max(0, i - 2); j <= std::min(n - 1, i + 1); j++) {
+            a(i, j) = std::sin(1.0 + i * n + j);
+        }
+    }
+    PANSFE::Vec<double> x(n), b;
+    for (int i = 0; i < n; i++) {
+        x(i) = i % 5 - 2.0;
+    }
+    b = a * x;
+    PANSFE::BandMat<double> band(a, 2, 1);
+    ASSERT_TRUE(band.Factorize());
+    PANSFE::Vec<double> y = band.Solve(b);
+    for (int i = 0; i < n; i++) {
+        ASSERT_NEAR(y[i], x[i], 1e-9);
+    }
+}
+
+TEST(BandMatTest, BandMatSolveTest2) {
+    PANSFE::Mat<double> a = {{1, 2, 0}, {2, 4, 0}, {0, 1, 3}};
+    PANSFE::BandMat<double> band(a, 1, 1);
+    ASSERT_FALSE(band.Factorize());
+    EXPECT_DEBUG_DEATH(band.Solve(PANSFE::Vec<double>({1, 2, 3})), "");
+    ASSERT_EQ(PANSFE::Mat<double>(band), a);
+    band(1, 1) = 5;
+    ASSERT_TRUE(band.Factorize());
+    PANSFE::Vec<double> x = band.Solve(PANSFE::Vec<double>({3, 7, 4}));
+    for (int i = 0; i < 3; i++) {
+        ASSERT_NEAR(x[i], 1, 1e-12);
+    }
+}
+
+TEST(BandMatTest, BandMatTridiagonalTest1) {
+    int n = 1001;
+    PANSFE::Vec<double> a(n, -1), b(n, 4), c(n, -1), x(n), d(n);
+    for (int i = 0; i < n; i++) {
+        x[i] = std::cos(0.01 * i);
+    }
+    for (int i = 0; i < n; i++) {
+        d[i] = b[i] * x[i] + (i > 0 ? a[i] * x[i - 1] : 0) +
+               (i < n - 1 ? c[i] * x[i + 1] : 0);
+    }
+    PANSFE::Vec<double> y = PANSFE::SolveTridiagonal(a, b, c, d),
+                        z = PANSFE::SolveTridiagonalCyclicReduction(a, b, c, d);
+    for (int i = 0; i < n; i++) {
+        ASSERT_NEAR(y[i], x[i], 1e-12);
+        ASSERT_NEAR(z[i], x[i], 1e-12);
+    }
+}
+
+TEST(BandMatTest, BandMatBatchedTest1) {
+    int lines = 8, n = 5;
+    PANSFE::Vec<double> a(lines * n, 1), b(lines * n), c(lines * n, 1),
+        d(lines * n);
+    for (int l = 0; l < lines; l++) {
+        for (int i = 0; i < n; i++) {
+            b[n * l + i] = 3 + l;
+            d[n * l + i] = (i == 0 || i == n - 1 ? 4 + l : 5 + l) * (l + 1.0);
+        }
+    }
+    PANSFE::SolveTridiagonalBatched(lines, a, b, c, d);
+    for (int i = 0; i < lines * n; i++) {
+        ASSERT_NEAR(d[i], i / n + 1.0, 1e-12);
+    }
+}
@@ -0,0 +1,52 @@
+#include "../src/blockmat.h"
+
+#include <gtest/gtest.h>
+
+#include "../src/linearoperator.h"
+
+TEST(BlockMatTest, BlockMatConversionTest1) {
+    PANSFE::Mat<int> a = {{1, 2}, {3, 4}}, b = {{5, 6, 7}, {8, 9, 10}};
+    PANSFE::Vec<int> c = {11, 12};
+    PANSFE::BlockMat<int> k = {
+        {a, b, c},
+        {b.Transpose(), PANSFE::MatBlock<int>::Identity(-1, 2), {}}};
+    ASSERT_EQ(k.Row(), 5);
+    ASSERT_EQ(k.Col(), 6);
+    ASSERT_EQ(k.ColOffset(), std::vector<PANSFE::Index>({0, 2, 5, 6}));
+    PANSFE::Mat<int> expected = a.Hstack(b).Hstack(c).Vstack(
+        b.Transpose().Hstack(PANSFE::Mat<int>::Identity(3) * 2).Hstack(
+            PANSFE::Mat<int>(3, 1)));
+    PANSFE::SetNumThreads(3);
+    PANSFE::Mat<int> dense = k;
+    PANSFE::SetNumThreads(0);
+    ASSERT_EQ(dense, expected);
+    ASSERT_EQ(k.Diagonal(), expected.Diagonal());
+
+    PANSFE::BlockMat<int> stacked = {{c}, {PANSFE::MatBlock<int>::Zero(3)},
+                                     {c}};
+    ASSERT_EQ(PANSFE::Vec<int>(PANSFE::Mat<int>(stacked)),
+              PANSFE::Vec<int>({11, 12, 0, 0, 0, 11, 12}));
+
+    PANSFE::BlockMat<int> kept = {
+        {PANSFE::Mat<int>(2, 2, 7), PANSFE::Vec<int>(2, 8)}};
+    ASSERT_EQ(PANSFE::Mat<int>(kept), PANSFE::Mat<int>({{7, 7, 8}, {7, 7, 8}}));
+}
+
+TEST(BlockMatTest, BlockMatOperatorTest1) {
+    PANSFE::Mat<double> a = {{4, 1, 0}, {1, 4, 1}, {0, 1, 4}},
+                        b = {{1, 0, 2}, {0, 3, 1}};
+    a.SetCopyOnWrite(true);
+    PANSFE::BlockMat<double> k = {{a, b.Transpose()},
+                                  {b, PANSFE::MatBlock<double>::Zero()}};
+    PANSFE::Mat<double> dense = k;
+    PANSFE::Vec<double> x = {1, -2, 3, 0.5, -1}, y(5);
+    PANSFE::SetNumThreads(2);
+    k.ApplyTranspose(x, y);
+    PANSFE::SetNumThreads(0);
+    ASSERT_EQ(k * x, dense * x);
+    ASSERT_EQ(y, dense.Transpose() * x);
+    PANSFE::LinearOperator<double> op = k;
+    PANSFE::Vec<double> z(5);
+    op.Apply(x, z);
+    ASSERT_EQ(z, dense * x);
+}
@@ -0,0 +1,45 @@
+#include "../src/fixedmat.h"
+
+#include <gtest/gtest.h>
+
+constexpr PANSFE::FixedMat<double, 3, 3> a = {
+    {1, 1, -1}, {-2, 0, 1}, {0, 2, 1}};
+constexpr PANSFE::FixedMat<double, 3, 3> ainv = a.Inverse();
+constexpr PANSFE::FixedMat<int, 4, 4> b = {
+    {1, 2, 3, 4}, {5, 7, 11, 8}, {9, 10, 6, 12}, {13, 14, 15, 16}};
+
+static_assert(ainv(0, 0) == -0.5 && ainv(0, 1) == -0.75 && ainv(2, 2) == 0.5,
+              "Inverse must be evaluated at compile time");
+static_assert(b.Determinant() == 180,
+              "Determinant must be evaluated at compile time");
+
+TEST(FixedMatTest, FixedMatConstexprTest1) {
+    constexpr PANSFE::FixedMat<double, 3, 3> c = a * ainv;
+    ASSERT_EQ(c, (PANSFE::FixedMat<double, 3, 3>::Identity()));
+    ASSERT_EQ(a.Determinant(), 4);
+}
+
+TEST(FixedMatTest, FixedMatOperatorTest1) {
+    constexpr PANSFE::FixedMat<int, 2, 3> c = {{1, 2, 3}, {4, 5, 6}};
+    constexpr PANSFE::FixedMat<int, 3, 2> d = c.Transpose();
+    constexpr PANSFE::FixedMat<int, 2, 2> e = c * d, f = {{14, 32}, {32, 77}};
+    constexpr PANSFE::FixedVec<int, 3> g = {1, 0, -1};
+    constexpr PANSFE::FixedVec<int, 2> h = c * g, i = {-2, -2};
+    static_assert(e == f && h == i, "Product must be constexpr");
+    static_assert(2 * f - f == f && (f + f) / 2 == f, "Arithmetic");
+    ASSERT_EQ(e, f);
+}
+
+TEST(FixedMatTest, FixedMatVecTest1) {
+    constexpr PANSFE::FixedVec<int, 3> a = {1, 2, 5}, b = {3, 4, 6},
+                                       c = {-8, 9, -2};
+    static_assert(a.Cross(b) == c && a.Dot(b) == 41, "Vector products");
+    ASSERT_EQ(PANSFE::Vec<int>(a), PANSFE::Vec<int>({1, 2, 5}));
+}
+
+TEST(FixedMatTest, FixedMatConversionTest1) {
+    PANSFE::Mat<int> c = {{1, 2}, {3, 4}};
+    PANSFE::FixedMat<int, 2, 2> d(c);
+    ASSERT_EQ(d(1, 0), 3);
+    ASSERT_EQ(PANSFE::Mat<int>(d), c);
+}
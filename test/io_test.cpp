@@ -0,0 +1,110 @@
+#include "../src/io.h"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <sstream>
+
+TEST(IOTest, IOWriteTest1) {
+    PANSFE::Mat<double> a = {{0.1, -2.5, 1e-300}, {3, 1.0 / 3.0, -0.0}};
+    std::stringstream ss;
+    PANSFE::Write(ss, a, PANSFE::CSVFormat());
+    ASSERT_EQ(ss.str(), "0.1,-2.5,1e-300\n3,0.3333333333333333,-0\n");
+    std::stringstream tt;
+    PANSFE::Write(tt, PANSFE::Vec<float>({0.1f, 2.0f}), PANSFE::TextFormat());
+    ASSERT_EQ(tt.str(), "0.1\n2\n");
+    std::stringstream uu;
+    PANSFE::Write(uu, PANSFE::Vec<double>({1.0 / 3.0}),
+                  PANSFE::TextFormat('\t', 4));
+    ASSERT_EQ(uu.str(), "0.3333\n");
+}
+
+TEST(IOTest, IORoundTripTest1) {
+    std::mt19937 engine(1);
+    std::uniform_real_distribution<double> uniform(-1.0, 1.0);
+    PANSFE::Mat<double> a(50, 7);
+    for (int i = 0; i < a.Row(); i++) {
+        for (int j = 0; j < a.Col(); j++) {
+            a(i, j) = std::ldexp(uniform(engine), i - 25);
+        }
+    }
+    std::stringstream ss;
+    PANSFE::Write(ss, a);
+    ASSERT_EQ(PANSFE::ReadMat<double>(ss), a);
+
+    PANSFE::Vec<float> b(100);
+    for (int i = 0; i < b.Size(); i++) {
+        b[i] = float(uniform(engine)) * float(i);
+    }
+    std::stringstream tt;
+    PANSFE::Write(tt, b);
+    ASSERT_EQ(PANSFE::ReadVec<float>(tt), b);
+}
+
+TEST(IOTest, IOReadTest1) {
+    std::stringstream ss("1, 2.5e1 ,-3\r\n\r\n4,5E-1,+6.\r\n");
+    PANSFE::Mat<double> a = PANSFE::ReadMat<double>(ss, PANSFE::CSVFormat()),
+                        b = {{1, 25, -3}, {4, 0.5, 6}};
+    ASSERT_EQ(a, b);
+    std::stringstream tt("7\n-8\n 9 10\n");
+    ASSERT_EQ(PANSFE::ReadVec<int>(tt), PANSFE::Vec<int>({7, -8, 9, 10}));
+    std::stringstream uu("0.1 123456789012345678901234567890 1e400 inf\n");
+    PANSFE::Vec<double> c = PANSFE::ReadVec<double>(uu);
+    ASSERT_EQ(c[0], 0.1);
+    ASSERT_EQ(c[1], 123456789012345678901234567890.0);
+    ASSERT_EQ(c[2], std::numeric_limits<double>::infinity());
+    ASSERT_EQ(c[3], std::numeric_limits<double>::infinity());
+}
+
+TEST(IOTest, IORoundTripTest2) {
+    std::mt19937_64 engine(2);
+    char buffer[48];
+    for (int i = 0; i < 100000; i++) {
+        std::uint64_t bits = engine();
+        double value;
+        std::memcpy(&value, &bits, sizeof(value));
+        if (!std::isfinite(value)) {
+            continue;
+        }
+        buffer[PANSFE::FormatNumber(buffer, value, 0)] = '\0';
+        ASSERT_EQ(std::strtod(buffer, nullptr), value) << buffer;
+        std::uint32_t half = std::uint32_t(bits);
+        float single;
+        std::memcpy(&single, &half, sizeof(single));
+        if (!std::isfinite(single)) {
+            continue;
+        }
+        buffer[PANSFE::FormatNumber(buffer, single, 0)] = '\0';
+        ASSERT_EQ(std::strtof(buffer, nullptr), single) << buffer;
+    }
+    double values[] = {5e-324, 1.7976931348623157e308, 1e15, 1e-5, 123.25};
+    const char *texts[] = {"5e-324", "1.7976931348623157e+308", "1e+15",
+                           "1e-05", "123.25"};
+    for (int i = 0; i < 5; i++) {
+        buffer[PANSFE::FormatNumber(buffer, values[i], 0)] = '\0';
+        ASSERT_STREQ(buffer, texts[i]);
+    }
+}
+
+TEST(IOTest, IOReadTest2) {
+    std::stringstream ss("1 2 3\n4 5\n6 7 8\n");
+    PANSFE::Mat<double> a = PANSFE::ReadMat<double>(ss);
+    ASSERT_TRUE(ss.fail());
+    ASSERT_EQ(a.Row(), 0);
+    std::stringstream tt("1 2\n3 x\n");
+    PANSFE::Mat<int> b = PANSFE::ReadMat<int>(tt);
+    ASSERT_TRUE(tt.fail());
+    ASSERT_EQ(b.Row(), 0);
+    std::stringstream uu("1.5 abc 2\n");
+    PANSFE::Vec<double> c = PANSFE::ReadVec<double>(uu);
+    ASSERT_TRUE(uu.fail());
+    ASSERT_EQ(c.Size(), 0);
+    std::stringstream vv("1 2\n3 4\n");
+    PANSFE::Mat<int> d = PANSFE::ReadMat<int>(vv);
+    ASSERT_FALSE(vv.fail());
+    ASSERT_EQ(d, PANSFE::Mat<int>({{1, 2}, {3, 4}}));
+}
@@ -0,0 +1,60 @@
+#include "../src/iterative.h"
+
+#include <gtest/gtest.h>
+
+#include "../src/mat.h"
+#include "../src/sparsemat.h"
+
+TEST(IterativeTest, ConjugateGradientTest1) {
+    PANSFE::Mat<double> a = {
+        {4, 1, 0, 0}, {1, 4, 1, 0}, {0, 1, 4, 1}, {0, 0, 1, 4}};
+    PANSFE::Vec<double> b = {1, 2, 3, 4};
+    PANSFE::ConjugateGradient<double> solver(a, 1e-12);
+    PANSFE::Vec<double> x = solver.Solve(b);
+    ASSERT_TRUE(solver.IsConverged());
+    ASSERT_LE(solver.Iteration(), 4);
+    PANSFE::Vec<double> r = a * x - b;
+    ASSERT_NEAR(r.Norm(), 0.0, 1e-10);
+}
+
+TEST(IterativeTest, ConjugateGradientTest2) {
+    int n = 200;
+    auto laplacian = [n](const PANSFE::Vec<double> &_x,
+                         PANSFE::Vec<double> &_y) {
+        for (int i = 0; i < n; i++) {
+            _y[i] = (2 + i % 3) * _x[i] - (i > 0 ? _x[i - 1] : 0) -
+                    (i < n - 1 ? _x[i + 1] : 0);
+        }
+    };
+    PANSFE::Vec<double> diagonal(n);
+    for (int i = 0; i < n; i++) {
+        diagonal[i] = 2 + i % 3;
+    }
+    PANSFE::LinearOperator<double> a(n, n, laplacian, laplacian, diagonal);
+    PANSFE::LinearOperator<double> jacobi(
+        n, n,
+        [diagonal](const PANSFE::Vec<double> &_x, PANSFE::Vec<double> &_y) {
+            for (int i = 0; i < _x.Size(); i++) {
+                _y[i] = _x[i] / diagonal[i];
+            }
+        });
+    PANSFE::Vec<double> b(n, 1.0);
+    PANSFE::ConjugateGradient<double> solver(a, 1e-10);
+    solver.SetPreconditioner(jacobi);
+    PANSFE::Vec<double> x = solver.Solve(b);
+    ASSERT_TRUE(solver.IsConverged());
+    PANSFE::Vec<double> r = a * x - b;
+    ASSERT_NEAR(r.Norm(), 0.0, 1e-8);
+}
+
+TEST(IterativeTest, PowerIterationTest1) {
+    PANSFE::Mat<double> a = {{2, 0, 0}, {0, -5, 1}, {0, 1, 1}};
+    PANSFE::SparseMat<double> s(a);
+    PANSFE::PowerIteration<double> power(s, 1e-10);
+    ASSERT_TRUE(power.IsConverged());
+    double lambda = -2 - std::sqrt(10.0);
+    ASSERT_NEAR(power.Eigenvalue(), lambda, 1e-8);
+    PANSFE::Vec<double> r =
+        a * power.Eigenvector() - lambda * power.Eigenvector();
+    ASSERT_NEAR(r.Norm(), 0.0, 1e-6);
+}
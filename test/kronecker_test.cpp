@@ -0,0 +1,75 @@
+#include "../src/kronecker.h"
+
+#include <gtest/gtest.h>
+
+#include "../src/iterative.h"
+#include "../src/linearoperator.h"
+
+namespace {
+PANSFE::Mat<double> Factor(int _row, int _col, int _seed) {
+    PANSFE::Mat<double> retmat(_row, _col);
+    for (int i = 0; i < _row; i++) {
+        for (int j = 0; j < _col; j++) {
+            retmat(i, j) = ((i * 7 + j * 3 + _seed) % 11) - 5.0;
+        }
+    }
+    return retmat;
+}
+}  // namespace
+
+TEST(KroneckerTest, KroneckerApplyTest1) {
+    PANSFE::Mat<double> a = {{1, 2}, {3, 4}}, b = {{0, 5, 1}, {6, 7, 2}};
+    PANSFE::Kronecker<double> ab(a, b);
+    ASSERT_EQ(ab.Row(), 4);
+    ASSERT_EQ(ab.Col(), 6);
+    PANSFE::Mat<double> dense = {{0, 5, 1, 0, 10, 2},
+                                 {6, 7, 2, 12, 14, 4},
+                                 {0, 15, 3, 0, 20, 4},
+                                 {18, 21, 6, 24, 28, 8}};
+    ASSERT_EQ(PANSFE::Mat<double>(ab), dense);
+    ASSERT_EQ(ab(3, 4), 28);
+
+    PANSFE::Kronecker<double> abc(
+        {Factor(3, 4, 1), Factor(5, 2, 2), Factor(4, 3, 3)});
+    PANSFE::Mat<double> full(abc);
+    PANSFE::Vec<double> x(abc.Col()), z(abc.Row());
+    for (int i = 0; i < abc.Col(); i++) {
+        x[i] = (i % 5) - 2.0;
+    }
+    for (int i = 0; i < abc.Row(); i++) {
+        z[i] = (i % 3) + 1.0;
+    }
+    ASSERT_EQ(abc * x, full * x);
+    PANSFE::Vec<double> y(abc.Col());
+    PANSFE::SetNumThreads(3);
+    abc.ApplyTranspose(z, y);
+    PANSFE::SetNumThreads(0);
+    ASSERT_EQ(y, full.Transpose() * z);
+    ASSERT_EQ(PANSFE::Mat<double>(abc.Transpose()), full.Transpose());
+    ASSERT_EQ(abc.Diagonal(), full.Diagonal());
+}
+
+TEST(KroneckerTest, KroneckerAlgebraTest1) {
+    PANSFE::Mat<double> a = {{4, 1}, {1, 3}}, b = {{2, -1, 0}, {-1, 2, -1},
+                                                   {0, -1, 2}};
+    PANSFE::Kronecker<double> ab(a, b), ba(b, a);
+    PANSFE::Kronecker<double> product = ab * ab;
+    ASSERT_EQ(PANSFE::Mat<double>(product),
+              PANSFE::Mat<double>(ab) * PANSFE::Mat<double>(ab));
+
+    PANSFE::Vec<double> f = {1, 2, 3, 4, 5, 6};
+    PANSFE::Vec<double> x = ab.Solve(f);
+    PANSFE::Vec<double> r = ab * x - f;
+    ASSERT_LE(r.Norm(), 1e-12);
+    PANSFE::Mat<double> identity = PANSFE::Mat<double>(ab.Inverse() * ab);
+    for (int i = 0; i < identity.Row(); i++) {
+        for (int j = 0; j < identity.Col(); j++) {
+            ASSERT_NEAR(identity(i, j), i == j ? 1.0 : 0.0, 1e-12);
+        }
+    }
+
+    PANSFE::ConjugateGradient<double> solver(ba, 1e-12);
+    PANSFE::Vec<double> y = solver.Solve(f);
+    ASSERT_TRUE(solver.IsConverged());
+    ASSERT_LE((ba * y - f).Norm(), 1e-10);
+}
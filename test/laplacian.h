@@ -0,0 +1,45 @@
+#pragma once
+#include <vector>
+
+#include "../src/sparsemat.h"
+#include "../src/tripletbuilder.h"
+
+inline PANSFE::SparseMat<double> LabeledLaplacian(
+    int _m, const std::vector<int> &_label, double _scale, double _jitter) {
+    int n = _m * _m;
+    PANSFE::TripletBuilder<double> builder(n, n);
+    for (int x = 0; x < _m; x++) {
+        for (int y = 0; y < _m; y++) {
+            int v = _label[x * _m + y];
+            builder.Add(v, v, 4.0 * _scale + _jitter * (v % 7));
+            if (x + 1 < _m) {
+                builder.Add(v, _label[(x + 1) * _m + y], -_scale);
+                builder.Add(_label[(x + 1) * _m + y], v, -_scale);
+            }
+            if (y + 1 < _m) {
+                builder.Add(v, _label[x * _m + y + 1], -_scale);
+                builder.Add(_label[x * _m + y + 1], v, -_scale);
+            }
+        }
+    }
+    return builder.Build();
+}
+
+inline PANSFE::SparseMat<double> Laplacian(int _m, double _scale = 1.0,
+                                           double _jitter = 0.0) {
+    std::vector<int> label(_m * _m);
+    for (int v = 0; v < _m * _m; v++) {
+        label[v] = v;
+    }
+    return LabeledLaplacian(_m, label, _scale, _jitter);
+}
+
+inline PANSFE::SparseMat<double> ScrambledLaplacian(int _m,
+                                                    double _scale = 1.0) {
+    int n = _m * _m;
+    std::vector<int> label(n);
+    for (int v = 0; v < n; v++) {
+        label[v] = int((v * 7919LL) % n);
+    }
+    return LabeledLaplacian(_m, label, _scale, 0.0);
+}
@@ -0,0 +1,66 @@
+#include "../src/linearoperator.h"
+
+#include <gtest/gtest.h>
+
+#include <type_traits>
+
+#include "../src/blocksparsemat.h"
+#include "../src/mat.h"
+#include "../src/sparsemat.h"
+#include "../src/symmat.h"
+
+TEST(LinearOperatorTest, LinearOperatorMatTest1) {
+    PANSFE::Mat<int> a = {{1, 2, 3}, {4, 5, 6}};
+    PANSFE::LinearOperator<int> op = a;
+    ASSERT_EQ(op.Row(), 2);
+    ASSERT_EQ(op.Col(), 3);
+    ASSERT_TRUE(op.HasTranspose());
+    PANSFE::Vec<int> x = {1, 2, 3}, y(2), z(3);
+    op.Apply(x, y);
+    ASSERT_EQ(y, a * x);
+    op.ApplyTranspose(y, z);
+    ASSERT_EQ(z, a.Transpose() * y);
+    ASSERT_EQ(op.Diagonal(), PANSFE::Vec<int>({1, 5}));
+    ASSERT_TRUE((std::is_convertible<const PANSFE::Mat<int> &,
+                                     PANSFE::LinearOperator<int> >::value));
+    ASSERT_FALSE((std::is_convertible<PANSFE::Mat<int>,
+                                      PANSFE::LinearOperator<int> >::value));
+    ASSERT_FALSE((std::is_convertible<const PANSFE::Mat<int>,
+                                      PANSFE::LinearOperator<int> >::value));
+}
+
+TEST(LinearOperatorTest, LinearOperatorSparseTest1) {
+    PANSFE::Mat<double> a = {
+        {4, 1, 0, 0}, {1, 4, 0, 2}, {0, 0, 3, 0}, {0, 2, 0, 5}};
+    PANSFE::Vec<double> x = {1, -2, 3, 0.5}, y(4);
+    PANSFE::SparseMat<double> s(a);
+    PANSFE::BlockSparseMat<double, 2> b(s);
+    PANSFE::SymMat<double> m(a);
+    for (const PANSFE::LinearOperator<double> &op :
+         {PANSFE::LinearOperator<double>(s),
+          PANSFE::LinearOperator<double>(b),
+          PANSFE::LinearOperator<double>(m)}) {
+        op.Apply(x, y);
+        ASSERT_EQ(y, a * x);
+        op.ApplyTranspose(x, y);
+        ASSERT_EQ(y, a.Transpose() * x);
+        ASSERT_EQ(op.Diagonal(), PANSFE::Vec<double>({4, 4, 3, 5}));
+    }
+}
+
+TEST(LinearOperatorTest, LinearOperatorCallableTest1) {
+    int n = 5;
+    PANSFE::LinearOperator<double> op(
+        n, n, [n](const PANSFE::Vec<double> &_x, PANSFE::Vec<double> &_y) {
+            for (int i = 0; i < n; i++) {
+                _y[i] = 2 * _x[i] - (i > 0 ? _x[i - 1] : 0) -
+                        (i < n - 1 ? _x[i + 1] : 0);
+            }
+        });
+    ASSERT_FALSE(op.HasTranspose());
+    ASSERT_FALSE(op.HasDiagonal());
+    PANSFE::Vec<double> x = {1, 1, 1, 1, 1};
+    ASSERT_EQ(op * x, PANSFE::Vec<double>({1, 0, 0, 0, 1}));
+    PANSFE::LinearOperator<double> copy = op;
+    ASSERT_EQ(copy * x, op * x);
+}
@@ -0,0 +1,72 @@
+#include "../src/lu.h"
+
+#include <gtest/gtest.h>
+
+TEST(LUTest, LUSolveTest1) {
+    PANSFE::Mat<double> a = {{2, 1, 1}, {4, -6, 0}, {-2, 7, 2}};
+    PANSFE::Vec<double> b = {5, -2, 9}, c = {1, 1, 2};
+    PANSFE::LU<double> lu(a);
+    PANSFE::Vec<double> x = lu.Solve(b);
+    ASSERT_FALSE(lu.IsSingular());
+    for (int i = 0; i < 3; i++) {
+        ASSERT_NEAR(x[i], c[i], 1e-12);
+    }
+}
+
+TEST(LUTest, LUDeterminantTest1) {
+    PANSFE::Mat<double> a = {
+        {1, 2, 3, 4}, {5, 7, 11, 8}, {9, 10, 6, 12}, {13, 14, 15, 16}};
+    ASSERT_NEAR(PANSFE::LU<double>(a).Determinant(), 180, 1e-10);
+}
+
+TEST(LUTest, LUInverseTest1) {
+    PANSFE::Mat<double> a = {{1, 1, -1}, {-2, 0, 1}, {0, 2, 1}},
+                        b = {{-0.5, -0.75, 0.25},
+                             {0.5, 0.25, 0.25},
+                             {-1, -0.5, 0.5}};
+    PANSFE::Mat<double> c = PANSFE::LU<double>(a).Inverse();
+    for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < 3; j++) {
+            ASSERT_NEAR(c(i, j), b(i, j), 1e-12);
+        }
+    }
+}
+
+TEST(LUTest, LUSingularTest1) {
+    PANSFE::Mat<double> a = {{1, 2}, {2, 4}};
+    ASSERT_TRUE(PANSFE::LU<double>(a).IsSingular());
+}
+
+TEST(LUTest, LUSolveTest2) {
+    PANSFE::Mat<double> a = {{2, 1, 1}, {4, -6, 0}, {-2, 7, 2}},
+                        b = {{5, 1}, {-2, 2}, {9, 3}};
+    PANSFE::Mat<double> x = PANSFE::LU<double>(a).Solve(b), c = a * x;
+    for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < 2; j++) {
+            ASSERT_NEAR(c(i, j), b(i, j), 1e-12);
+        }
+    }
+}
+
+TEST(LUTest, LUUpdateTest1) {
+    PANSFE::Mat<double> a = {
+        {2, 1, 1, 0}, {4, -6, 0, 1}, {-2, 7, 2, 3}, {1, 0, 5, 4}};
+    PANSFE::Mat<double> u = {{1, 0}, {-1, 2}, {0.5, 0}, {2, 1}},
+                        v = {{0, 1}, {3, 0}, {1, -1}, {-2, 0.5}};
+    PANSFE::Vec<double> b = {1, 2, 3, 4};
+    PANSFE::LU<double> lu(a);
+    lu.Update(u, v);
+    PANSFE::Vec<double> x = lu.Solve(b),
+                        y = PANSFE::LU<double>(a + u * v.Transpose()).Solve(b);
+    ASSERT_FALSE(lu.IsSingular());
+    for (int i = 0; i < 4; i++) {
+        ASSERT_NEAR(x[i], y[i], 1e-10);
+    }
+    PANSFE::Vec<double> c = {1, 1, 1, 1}, d = {0, 0, 0, 1};
+    lu.Update(c, d);
+    lu.Update(-1.0 * c, d);
+    x = lu.Solve(b);
+    for (int i = 0; i < 4; i++) {
+        ASSERT_NEAR(x[i], y[i], 1e-10);
+    }
+}
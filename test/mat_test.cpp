@@ -2,6 +2,9 @@
 
 #include <gtest/gtest.h>
 
+#include <cmath>
+#include <vector>
+
 TEST(MatrixTest, MatrixConstructorTest1) {
     PANSFE::Mat<int> a;
     ASSERT_EQ(a.Row(), 0);
@@ -210,6 +213,81 @@ TEST(MatrixTest, MatrixInverseTest3) {
     ASSERT_EQ(a.Inverse(), b);
 }
 
+TEST(MatrixTest, MatrixFactorizationCacheTest1) {
+    PANSFE::Mat<double> a = {
+        {1, 2, 3, 4}, {5, 7, 11, 8}, {9, 10, 6, 12}, {13, 14, 15, 16}};
+    a.SetFactorizationCache(true);
+    ASSERT_FALSE(a.HasFactorization());
+    ASSERT_NEAR(a.Determinant(), 180, 1e-10);
+    ASSERT_TRUE(a.HasFactorization());
+    PANSFE::Mat<double> b = a.Inverse() * a;
+    PANSFE::Vec<double> x = a.Solve(PANSFE::Vec<double>({10, 31, 37, 58}));
+    for (int i = 0; i < 4; i++) {
+        ASSERT_NEAR(x[i], 1, 1e-10);
+        for (int j = 0; j < 4; j++) {
+            ASSERT_NEAR(b(i, j), i == j ? 1 : 0, 1e-10);
+        }
+    }
+    ASSERT_EQ(a(0, 0), 1);
+    ASSERT_TRUE(a.HasFactorization());
+    a.BeginWrite();
+    ASSERT_FALSE(a.HasFactorization());
+    a(0, 0) = 2;
+    ASSERT_NEAR(a.Determinant(), 180 + 7 * 6 * 16 + 11 * 12 * 14 +
+                                     8 * 10 * 15 - 8 * 6 * 14 -
+                                     11 * 10 * 16 - 7 * 12 * 15,
+                1e-10);
+}
+
+TEST(MatrixTest, MatrixFactorizationCacheTest2) {
+    PANSFE::Mat<double> a = {{4, 1, 0}, {1, 3, 1}, {0, 1, 2}};
+    a.SetFactorizationCache(true);
+    PANSFE::Mat<double> x = a.Solve(PANSFE::Mat<double>::Identity(3));
+    ASSERT_TRUE(a.HasFactorization());
+    PANSFE::Mat<double> b = a * x;
+    for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < 3; j++) {
+            ASSERT_NEAR(b(i, j), i == j ? 1 : 0, 1e-12);
+        }
+    }
+    ASSERT_NEAR(a.Determinant(), 18, 1e-12);
+    a *= 2.0;
+    ASSERT_FALSE(a.HasFactorization());
+    ASSERT_NEAR(a.Determinant(), 144, 1e-10);
+}
+
+TEST(MatrixTest, MatrixFactorizationCacheTest3) {
+    int n = 40;
+    PANSFE::Mat<double> a(n, n);
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n; j++) {
+            a(i, j) = i == j ? 2.0 * n : std::sin(1.0 + i * n + j);
+        }
+    }
+    a.SetFactorizationCache(true);
+    const PANSFE::Mat<double> &c = a;
+    std::vector<double> conditions(16), errors(16);
+    PANSFE::ParallelFor(0, 16, [&](PANSFE::Index _t) {
+        PANSFE::Vec<double> b(n, double(_t + 1));
+        PANSFE::Vec<double> r = c * c.Solve(b) - b;
+        errors[_t] = r.Norm();
+        conditions[_t] = c.Condition();
+    });
+    ASSERT_TRUE(a.HasFactorization());
+    for (int t = 0; t < 16; t++) {
+        ASSERT_NEAR(errors[t], 0.0, 1e-10);
+        ASSERT_EQ(conditions[t], conditions[0]);
+    }
+}
+
+TEST(MatrixTest, MatrixConditionTest1) {
+    PANSFE::Mat<double> a = {{1, 2}, {3, 4}}, b = {{1, 0}, {0, 100}},
+                        c = {{1, 2}, {2, 4}};
+    ASSERT_NEAR(a.Condition(), 21, 1e-10);
+    ASSERT_NEAR(b.Condition(), 100, 1e-10);
+    ASSERT_EQ(c.Condition(), std::numeric_limits<double>::infinity());
+}
+
 TEST(MatrixTest, MatrixCofactorTest1) {
     PANSFE::Mat<int> a = {{1, 2, 3}, {4, 5, 6}, {7, 8, 9}},
                      b = {{1, 2}, {7, 8}};
@@ -256,3 +334,40 @@ TEST(MatrixTest, MatrixOStreamTest1) {
     ss << a << b;
     ASSERT_EQ(ss.str(), "1\t2\t3\t\n4\t5\t6\t\n7\t8\t\n9\t10\t\n");
 }
+
+TEST(MatrixTest, MatrixResizeTest1) {
+    PANSFE::Mat<int> a = {{1, 2, 3}, {4, 5, 6}};
+    a.Reserve(12);
+    const int *values = a.Values();
+    a.Resize(3, 4, 9);
+    ASSERT_EQ(a, PANSFE::Mat<int>({{1, 2, 3, 9}, {4, 5, 6, 9}, {9, 9, 9, 9}}));
+    a.Resize(2, 2);
+    ASSERT_EQ(a, PANSFE::Mat<int>({{1, 2}, {4, 5}}));
+    a = PANSFE::Mat<int>(2, 5, PANSFE::Uninitialized());
+    ASSERT_EQ(a.Values(), values);
+    ASSERT_EQ(a.Row(), 2);
+    ASSERT_EQ(a.Col(), 5);
+    a.Resize(4, 4);
+    ASSERT_NE(a.Values(), values);
+    ASSERT_EQ(a.Capacity(), 16);
+}
+
+TEST(MatrixTest, MatrixCopyOnWriteTest1) {
+    PANSFE::Mat<int> a = {{1, 2}, {3, 4}};
+    a.SetCopyOnWrite(true);
+    std::vector<PANSFE::Mat<int> > copies(8, a);
+    const PANSFE::Mat<int> &b = copies[3];
+    ASSERT_TRUE(a.IsShared());
+    ASSERT_EQ(b.Values(), static_cast<const PANSFE::Mat<int> &>(a).Values());
+    ASSERT_EQ(b[1][0], 3);
+    copies[3].BeginWrite();
+    copies[3](1, 0) = 5;
+    ASSERT_EQ(a(1, 0), 3);
+    ASSERT_EQ(b[1][0], 5);
+    copies[5] += a;
+    ASSERT_EQ(copies[5], PANSFE::Mat<int>({{2, 4}, {6, 8}}));
+    ASSERT_EQ(copies[6], PANSFE::Mat<int>({{1, 2}, {3, 4}}));
+
+    PANSFE::Mat<int> c = {{1, 2}}, d = c;
+    ASSERT_NE(c.Values(), d.Values());
+}
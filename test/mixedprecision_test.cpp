@@ -0,0 +1,40 @@
+#include "../src/mixedprecision.h"
+
+#include <gtest/gtest.h>
+
+TEST(MixedPrecisionTest, MixedPrecisionConversionTest1) {
+    PANSFE::Mat<double> a = {{1.5, 2}, {3, 4.25}};
+    PANSFE::Mat<float> b(a), c = {{1.5f, 2}, {3, 4.25f}};
+    ASSERT_EQ(b, c);
+    ASSERT_EQ(PANSFE::Mat<double>(b), a);
+}
+
+TEST(MixedPrecisionTest, MixedPrecisionSolveTest1) {
+    int n = 50;
+    PANSFE::Mat<double> a(n, n);
+    PANSFE::Vec<double> x(n), b;
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n; j++) {
+            a(i, j) = 1.0 / (1 + i + j) + (i == j ? 2.0 : 0.0);
+        }
+        x(i) = std::sin(0.1 * i);
+    }
+    b = a * x;
+    PANSFE::MixedPrecisionSolver<double> solver(a);
+    PANSFE::Vec<double> y = solver.Solve(b);
+    ASSERT_FALSE(solver.IsFallback());
+    ASSERT_GT(solver.Iteration(), 0);
+    for (int i = 0; i < n; i++) {
+        ASSERT_NEAR(y[i], x[i], 1e-14);
+    }
+}
+
+TEST(MixedPrecisionTest, MixedPrecisionFallbackTest1) {
+    PANSFE::Mat<double> a = {{1, 1}, {1, 1 + 1e-10}};
+    PANSFE::Vec<double> b = {2, 2 + 1e-10};
+    PANSFE::MixedPrecisionSolver<double> solver(a);
+    PANSFE::Vec<double> y = solver.Solve(b);
+    ASSERT_TRUE(solver.IsFallback());
+    ASSERT_NEAR(y[0], 1, 1e-5);
+    ASSERT_NEAR(y[1], 1, 1e-5);
+}
@@ -0,0 +1,97 @@
+#include "../src/preconditioner.h"
+
+#include <gtest/gtest.h>
+
+#include "../src/iterative.h"
+#include "laplacian.h"
+
+TEST(PreconditionerTest, PreconditionerExactTest1) {
+    PANSFE::Mat<double> a = {
+        {4, -1, 0, 0}, {-2, 5, 1, 0}, {0, -1, 6, 2}, {0, 0, 3, 7}};
+    PANSFE::SparseMat<double> b(a);
+    PANSFE::Vec<double> x = {1, 2, 3, 4}, y(4);
+    PANSFE::ILU<double> ilu(b);
+    ilu.Apply(b * x, y);
+    for (int i = 0; i < 4; i++) {
+        ASSERT_NEAR(y[i], x[i], 1e-12);
+    }
+    PANSFE::ILU<double> ilut(b, 0.0, 4);
+    ilut.Apply(b * x, y);
+    for (int i = 0; i < 4; i++) {
+        ASSERT_NEAR(y[i], x[i], 1e-12);
+    }
+    PANSFE::BlockJacobi<double> blockjacobi(b, 4);
+    blockjacobi.Apply(b * x, y);
+    for (int i = 0; i < 4; i++) {
+        ASSERT_NEAR(y[i], x[i], 1e-12);
+    }
+    PANSFE::Mat<double> c = {{4, 2, 0}, {2, 5, 1}, {0, 1, 3}};
+    PANSFE::SparseMat<double> d(c);
+    PANSFE::IC<double> ic(d);
+    ASSERT_TRUE(ic.IsPositiveDefinite());
+    PANSFE::Vec<double> z = {1, -1, 2}, w(3);
+    ic.Apply(d * z, w);
+    for (int i = 0; i < 3; i++) {
+        ASSERT_NEAR(w[i], z[i], 1e-12);
+    }
+}
+
+TEST(PreconditionerTest, PreconditionerConjugateGradientTest1) {
+    PANSFE::SparseMat<double> a = Laplacian(32, 1.0, 1e-3);
+    PANSFE::Vec<double> b(a.Row(), 1.0);
+    PANSFE::ConjugateGradient<double> solver(a, 1e-8);
+    PANSFE::Vec<double> x = solver.Solve(b);
+    int plain = solver.Iteration();
+    ASSERT_TRUE(solver.IsConverged());
+
+    PANSFE::Jacobi<double> jacobi(a);
+    PANSFE::BlockJacobi<double> blockjacobi(a, 32);
+    PANSFE::ILU<double> ilu(a);
+    PANSFE::ILU<double> ilut(a, 1e-3, 8);
+    PANSFE::IC<double> ic(a);
+    ASSERT_TRUE(ic.IsPositiveDefinite());
+    ASSERT_GT(ic.Operator().Row(), 0);
+    PANSFE::LinearOperator<double> preconditioners[] = {
+        jacobi.Operator(), blockjacobi.Operator(), ilu.Operator(),
+        ilut.Operator(), ic.Operator()};
+    int iterations[5];
+    for (int p = 0; p < 5; p++) {
+        solver.SetPreconditioner(preconditioners[p]);
+        PANSFE::Vec<double> y = solver.Solve(b);
+        ASSERT_TRUE(solver.IsConverged());
+        iterations[p] = solver.Iteration();
+        for (int i = 0; i < a.Row(); i++) {
+            ASSERT_NEAR(y[i], x[i], 1e-5);
+        }
+    }
+    ASSERT_LE(iterations[0], plain);
+    ASSERT_LT(iterations[1], plain);
+    ASSERT_LT(iterations[2], plain / 2);
+    ASSERT_LT(iterations[3], iterations[2]);
+    ASSERT_LT(iterations[4], plain / 2);
+}
+
+TEST(PreconditionerTest, PreconditionerLevelScheduleTest1) {
+    PANSFE::SparseMat<double> a = Laplacian(200, 1.0, 1e-3);
+    PANSFE::IC<double> ic(a);
+    PANSFE::ILU<double> ilu(a);
+    ASSERT_EQ(ilu.L().Levels(), 2 * 200 - 1);
+    ASSERT_EQ(ilu.U().Levels(), 2 * 200 - 1);
+    PANSFE::Vec<double> b(a.Row()), serial(a.Row()), parallel(a.Row());
+    for (int i = 0; i < a.Row(); i++) {
+        b[i] = (i % 11) - 5.0;
+    }
+    PANSFE::SetNumThreads(1);
+    ASSERT_EQ(ilu.L().Threads(), 1);
+    ic.Apply(b, serial);
+    PANSFE::SetNumThreads(4);
+    ASSERT_EQ(ilu.L().Threads(), 4);
+    ASSERT_EQ(ilu.U().Threads(), 4);
+    ic.Apply(b, parallel);
+    ASSERT_EQ(serial, parallel);
+    ilu.Apply(b, parallel);
+    PANSFE::SetNumThreads(1);
+    ilu.Apply(b, serial);
+    PANSFE::SetNumThreads(0);
+    ASSERT_EQ(serial, parallel);
+}
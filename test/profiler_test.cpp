@@ -0,0 +1,107 @@
+#include "../src/profiler.h"
+
+#include <gtest/gtest.h>
+
+#include <sstream>
+
+#include "../src/blockmat.h"
+#include "../src/mat.h"
+#include "../src/sparsemat.h"
+#include "../src/vec.h"
+
+TEST(ProfilerTest, ProfilerRecordTest1) {
+    PANSFE::Profiler::Instance().Reset();
+    PANSFE::Mat<double> a = {{1, 2}, {3, 4}}, b = {{5, 6}, {7, 8}};
+    PANSFE::Mat<double> c = a * b;
+    auto records = PANSFE::Profiler::Instance().Records();
+    ASSERT_EQ(records["Mat::operator*(Mat)"].calls, 1);
+    ASSERT_EQ(records["Mat::operator*(Mat)"].flops, 16);
+    ASSERT_EQ(records["Mat::operator*(Mat)"].allocations, 1);
+    ASSERT_EQ(records.count("Mat::operator*="), 0u);
+}
+
+TEST(ProfilerTest, ProfilerRecordTest2) {
+    PANSFE::Mat<double> a = {{1, 2}, {3, 4}}, b = {{5, 6}, {7, 8}};
+    PANSFE::Vec<double> x = {1, 2}, y = {3, 4};
+    PANSFE::Profiler::Instance().Reset();
+    PANSFE::Mat<double> c = a * b + a - b;
+    c *= a;
+    PANSFE::Mat<double> d = -c;
+    PANSFE::Vec<double> z = -(x - y) * 2.0;
+    auto records = PANSFE::Profiler::Instance().Records();
+    double flops = 0;
+    for (auto &record : records) {
+        flops += record.second.flops;
+    }
+    ASSERT_EQ(flops, 16 + 4 + 4 + 16 + 4 + 2 + 2 + 2);
+    ASSERT_EQ(records["Mat::operator-(Mat)"].calls, 1);
+    ASSERT_EQ(records["Mat::operator-()"].calls, 1);
+    ASSERT_EQ(records["Mat::operator*=(Mat)"].flops, 0);
+    ASSERT_EQ(records["Mat::operator*(Mat)"].calls, 2);
+    ASSERT_EQ(records["Vec::operator-(Vec)"].calls, 1);
+    ASSERT_EQ(records["Vec::operator-()"].calls, 1);
+    ASSERT_EQ(records["Vec::operator*(T)"].calls, 1);
+}
+
+TEST(ProfilerTest, ProfilerRecordTest3) {
+    PANSFE::Mat<double> a = {
+        {4, 1, 0, 0}, {1, 4, 1, 0}, {0, 1, 4, 1}, {0, 0, 1, 4}};
+    a.SetFactorizationCache(true);
+    PANSFE::Profiler::Instance().Reset();
+    a.Determinant();
+    auto records = PANSFE::Profiler::Instance().Records();
+    ASSERT_EQ(records["Mat::Determinant"].flops, 4);
+    ASSERT_EQ(records["Cholesky::Factorize"].calls, 1);
+    ASSERT_GT(records["Cholesky::Factorize"].flops, 16);
+}
+
+TEST(ProfilerTest, ProfilerRecordTest4) {
+    PANSFE::SparseMat<double> a(3, 3, {0, 1, 3, 4}, {0, 0, 2, 1},
+                                {1, 2, 3, 4});
+    PANSFE::Profiler::Instance().Reset();
+    PANSFE::SparseMat<double> c = a * a;
+    auto records = PANSFE::Profiler::Instance().Records();
+    ASSERT_EQ(records.count("SparseMat::Multiply"), 0u);
+    ASSERT_EQ(records["SparseMat::operator*(SparseMat)"].calls, 1);
+    ASSERT_EQ(records["SparseMat::operator*(SparseMat)"].flops, 2 * 5);
+}
+
+TEST(ProfilerTest, ProfilerAllocationTest1) {
+    PANSFE::Profiler::Instance().Reset();
+    PANSFE::Mat<double> a = {
+        {1, 2, 3, 4}, {5, 7, 11, 8}, {9, 10, 6, 12}, {13, 14, 15, 16}};
+    a.Cofactor(0, 0);
+    auto records = PANSFE::Profiler::Instance().Records();
+    ASSERT_EQ(records["Mat::Cofactor"].calls, 1);
+    ASSERT_EQ(records["Mat::Cofactor"].allocations, 1);
+    ASSERT_EQ(records["Mat::Cofactor"].allocated_bytes, 9 * sizeof(double));
+}
+
+TEST(ProfilerTest, ProfilerAllocationTest2) {
+    PANSFE::Mat<double> a(300, 200, 1.0), b(300, 100, 2.0);
+    PANSFE::Vec<double> c(300, 3.0);
+    PANSFE::Profiler::Instance().Reset();
+    long long allocations = PANSFE::Profiler::ThreadAllocations();
+    PANSFE::BlockMat<double> k = {{a, b, c}};
+    ASSERT_EQ(PANSFE::Profiler::ThreadAllocations(), allocations);
+    PANSFE::Mat<double> dense = k;
+    auto records = PANSFE::Profiler::Instance().Records();
+    ASSERT_EQ(records["BlockMat::operator Mat"].allocations, 1);
+    ASSERT_EQ(records["BlockMat::operator Mat"].allocated_bytes,
+              300 * 301 * sizeof(double));
+    ASSERT_EQ(records.count("Mat::Mat"), 0u);
+    ASSERT_EQ(dense(299, 250), 2.0);
+    ASSERT_EQ(dense(0, 300), 3.0);
+}
+
+TEST(ProfilerTest, ProfilerReportTest1) {
+    PANSFE::Profiler::Instance().Reset();
+    PANSFE::Vec<double> a = {1, 2}, b = {3, 4};
+    a.Dot(b);
+    std::stringstream table, json;
+    PANSFE::Profiler::Instance().Report(table);
+    PANSFE::Profiler::Instance().ReportJSON(json);
+    ASSERT_NE(table.str().find("Vec::Dot"), std::string::npos);
+    ASSERT_NE(json.str().find("\"Vec::Dot\": {\"calls\": 1"),
+              std::string::npos);
+}
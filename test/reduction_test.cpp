@@ -0,0 +1,36 @@
+#include "../src/reduction.h"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+#include "../src/vec.h"
+
+TEST(ReductionTest, ReductionSumTest1) {
+    PANSFE::Vec<int> a = {1, 2, 3, 4, 5};
+    ASSERT_EQ(a.Sum(), 15);
+}
+
+TEST(ReductionTest, ReductionDeterminismTest1) {
+    int n = 1000003;
+    PANSFE::Vec<double> a(n), b(n);
+    for (int i = 0; i < n; i++) {
+        a[i] = std::sin(0.37 * i);
+        b[i] = std::cos(1.3 * i) * 1e3;
+    }
+    PANSFE::SetNumThreads(1);
+    double dot1 = a.Dot(b), norm1 = b.Norm(), sum1 = a.Sum();
+    for (int numthreads : {2, 3, 7, 16}) {
+        PANSFE::SetNumThreads(numthreads);
+        ASSERT_EQ(a.Dot(b), dot1);
+        ASSERT_EQ(b.Norm(), norm1);
+        ASSERT_EQ(a.Sum(), sum1);
+    }
+    PANSFE::SetNumThreads(0);
+}
+
+TEST(ReductionTest, ReductionAccuracyTest1) {
+    int n = 10000000;
+    PANSFE::Vec<float> a(n, 0.1f);
+    ASSERT_NEAR(a.Sum(), 1e6f, 1.0f);
+}
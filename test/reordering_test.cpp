@@ -0,0 +1,88 @@
+#include "../src/reordering.h"
+
+#include <gtest/gtest.h>
+
+#include <set>
+#include <vector>
+
+#include "laplacian.h"
+
+namespace {
+long long CholeskyFill(const PANSFE::SparseMat<double> &_mat) {
+    int n = _mat.Row();
+    std::vector<std::set<int> > pattern(n);
+    for (int i = 0; i < n; i++) {
+        for (int k = _mat.RowPtr()[i]; k < _mat.RowPtr()[i + 1]; k++) {
+            if (_mat.ColInd()[k] > i) {
+                pattern[i].insert(_mat.ColInd()[k]);
+            }
+        }
+    }
+    long long fill = 0;
+    for (int k = 0; k < n; k++) {
+        fill += pattern[k].size();
+        if (!pattern[k].empty()) {
+            int parent = *pattern[k].begin();
+            for (int j : pattern[k]) {
+                if (j != parent) {
+                    pattern[parent].insert(j);
+                }
+            }
+        }
+    }
+    return fill;
+}
+}  // namespace
+
+TEST(ReorderingTest, ReorderingPermuteTest1) {
+    PANSFE::Mat<int> a = {{1, 0, 2}, {0, 3, 4}, {5, 0, 6}};
+    PANSFE::SparseMat<int> b(a);
+    std::vector<int> perm = {2, 0, 1};
+    ASSERT_EQ(PANSFE::InversePermutation(perm), std::vector<int>({1, 2, 0}));
+    PANSFE::SparseMat<int> c = PANSFE::Permute(b, perm);
+    PANSFE::Mat<int> d = {{6, 5, 0}, {2, 1, 0}, {4, 0, 3}};
+    ASSERT_EQ(PANSFE::Mat<int>(c), d);
+    ASSERT_EQ(c.ColInd(), std::vector<int>({0, 1, 0, 1, 0, 2}));
+    PANSFE::Vec<int> x = {1, 2, 3};
+    ASSERT_EQ(PANSFE::Permute(x, perm), PANSFE::Vec<int>({3, 1, 2}));
+    ASSERT_EQ(PANSFE::InversePermute(PANSFE::Permute(x, perm), perm), x);
+    ASSERT_EQ(c * PANSFE::Permute(x, perm), PANSFE::Permute(b * x, perm));
+}
+
+TEST(ReorderingTest, ReorderingReverseCuthillMcKeeTest1) {
+    PANSFE::SparseMat<double> a = ScrambledLaplacian(20);
+    std::vector<int> perm = PANSFE::ReverseCuthillMcKee(a);
+    ASSERT_TRUE(PANSFE::IsPermutation(perm));
+    PANSFE::SparseMat<double> b = PANSFE::Permute(a, perm);
+    ASSERT_GT(PANSFE::Bandwidth(a), 200);
+    ASSERT_LE(PANSFE::Bandwidth(b), 21);
+}
+
+TEST(ReorderingTest, ReorderingFillTest1) {
+    PANSFE::SparseMat<double> a = ScrambledLaplacian(20);
+    long long scrambled = CholeskyFill(a);
+    long long rcm = CholeskyFill(
+        PANSFE::Permute(a, PANSFE::ReverseCuthillMcKee(a)));
+    std::vector<int> amd = PANSFE::ApproximateMinimumDegree(a);
+    std::vector<int> nd = PANSFE::NestedDissection(a, 16);
+    ASSERT_TRUE(PANSFE::IsPermutation(amd));
+    ASSERT_TRUE(PANSFE::IsPermutation(nd));
+    long long amdfill = CholeskyFill(PANSFE::Permute(a, amd));
+    long long ndfill = CholeskyFill(PANSFE::Permute(a, nd));
+    ASSERT_LT(rcm, scrambled);
+    ASSERT_LT(amdfill, rcm);
+    ASSERT_LT(ndfill, rcm);
+}
+
+TEST(ReorderingTest, ReorderingDisconnectedTest1) {
+    PANSFE::Mat<double> a = {{2, 0, 0, 1, 0},
+                             {0, 2, 0, 0, 0},
+                             {0, 0, 2, 0, 1},
+                             {1, 0, 0, 2, 0},
+                             {0, 0, 1, 0, 2}};
+    PANSFE::SparseMat<double> b(a);
+    ASSERT_TRUE(PANSFE::IsPermutation(PANSFE::ReverseCuthillMcKee(b)));
+    ASSERT_TRUE(PANSFE::IsPermutation(PANSFE::ApproximateMinimumDegree(b)));
+    ASSERT_TRUE(PANSFE::IsPermutation(PANSFE::NestedDissection(b, 1)));
+    ASSERT_TRUE(PANSFE::IsPermutation(PANSFE::NestedDissection(b)));
+}
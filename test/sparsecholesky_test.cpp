@@ -0,0 +1,89 @@
+#include "../src/sparsecholesky.h"
+
+#include <gtest/gtest.h>
+
+#include "laplacian.h"
+
+TEST(SparseCholeskyTest, SparseCholeskyDenseTest1) {
+    PANSFE::Mat<double> a = {{4, 1, 0, 2, 0},
+                             {1, 5, 1, 0, 0},
+                             {0, 1, 6, 0, 1},
+                             {2, 0, 0, 7, 1},
+                             {0, 0, 1, 1, 8}};
+    PANSFE::SparseCholesky<double> cholesky{PANSFE::SparseMat<double>(a)};
+    ASSERT_TRUE(cholesky.IsPositiveDefinite());
+    PANSFE::Vec<double> b = {1, 2, 3, 4, 5};
+    PANSFE::Vec<double> x = cholesky.Solve(b);
+    PANSFE::Vec<double> y = PANSFE::Cholesky<double>(a).Solve(b);
+    for (int i = 0; i < 5; i++) {
+        ASSERT_NEAR(x[i], y[i], 1e-12);
+    }
+    PANSFE::Mat<double> c = {
+        {2, 0, 1}, {0, 1, 0}, {1, 0, -1}};
+    PANSFE::SparseCholesky<double> indefinite{PANSFE::SparseMat<double>(c)};
+    ASSERT_FALSE(indefinite.IsPositiveDefinite());
+}
+
+TEST(SparseCholeskyTest, SparseCholeskyDenseTest2) {
+    int n = 150;
+    PANSFE::Mat<double> a(n, n);
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n; j++) {
+            a[i][j] = i == j ? n : 1.0 / (1 + (i * 7 + j * 7) % 13);
+        }
+    }
+    PANSFE::SparseCholesky<double> cholesky{PANSFE::SparseMat<double>(a)};
+    ASSERT_TRUE(cholesky.IsPositiveDefinite());
+    PANSFE::Vec<double> b(n);
+    for (int i = 0; i < n; i++) {
+        b[i] = i % 5 - 2.0;
+    }
+    PANSFE::Vec<double> x = cholesky.Solve(b);
+    PANSFE::Vec<double> y = PANSFE::Cholesky<double>(a).Solve(b);
+    for (int i = 0; i < n; i++) {
+        ASSERT_NEAR(x[i], y[i], 1e-12);
+    }
+}
+
+TEST(SparseCholeskyTest, SparseCholeskySolveTest1) {
+    PANSFE::SparseMat<double> a = ScrambledLaplacian(40);
+    PANSFE::SparseCholesky<double> cholesky(a);
+    ASSERT_TRUE(cholesky.IsPositiveDefinite());
+    ASSERT_LT(cholesky.Supernodes(), a.Row() / 2);
+    ASSERT_LT(cholesky.NonZeros(), 20LL * a.Row());
+    PANSFE::Vec<double> b(a.Row());
+    for (int i = 0; i < a.Row(); i++) {
+        b[i] = (i % 13) - 6.0;
+    }
+    PANSFE::Vec<double> x = cholesky.Solve(b);
+    ASSERT_LE((b - a * x).Norm(), 1e-10 * b.Norm());
+
+    PANSFE::Mat<double> rhs(a.Row(), 3);
+    for (int i = 0; i < a.Row(); i++) {
+        for (int j = 0; j < 3; j++) {
+            rhs[i][j] = b[i] * (j + 1);
+        }
+    }
+    PANSFE::SetNumThreads(3);
+    PANSFE::Mat<double> solutions = cholesky.Solve(rhs);
+    PANSFE::SetNumThreads(0);
+    for (int i = 0; i < a.Row(); i++) {
+        for (int j = 0; j < 3; j++) {
+            ASSERT_NEAR(solutions[i][j], x[i] * (j + 1), 1e-10);
+        }
+    }
+}
+
+TEST(SparseCholeskyTest, SparseCholeskyRefactorizeTest1) {
+    PANSFE::SparseMat<double> a = ScrambledLaplacian(30);
+    PANSFE::SparseCholesky<double> cholesky(a, PANSFE::NestedDissection(a));
+    PANSFE::Vec<double> b(a.Row(), 1.0);
+    PANSFE::Vec<double> x = cholesky.Solve(b);
+    PANSFE::SetNumThreads(4);
+    ASSERT_TRUE(cholesky.Factorize(ScrambledLaplacian(30, 2.0)));
+    PANSFE::SetNumThreads(0);
+    PANSFE::Vec<double> y = cholesky.Solve(b);
+    for (int i = 0; i < a.Row(); i++) {
+        ASSERT_NEAR(2.0 * y[i], x[i], 1e-10);
+    }
+}
@@ -0,0 +1,75 @@
+#include "../src/sparsemat.h"
+
+#include <gtest/gtest.h>
+
+#include "../src/blocksparsemat.h"
+
+TEST(SparseMatTest, SparseMatConstructorTest1) {
+    PANSFE::Mat<int> a = {{1, 0, 2}, {0, 0, 3}, {4, 5, 0}};
+    PANSFE::SparseMat<int> b(a);
+    ASSERT_EQ(b.Row(), 3);
+    ASSERT_EQ(b.Col(), 3);
+    ASSERT_EQ(b.NonZeros(), 5);
+    ASSERT_EQ(b.RowPtr(), std::vector<int>({0, 2, 3, 5}));
+    ASSERT_EQ(b.ColInd(), std::vector<int>({0, 2, 2, 0, 1}));
+    ASSERT_EQ(b(2, 1), 5);
+    ASSERT_EQ(b(1, 1), 0);
+    ASSERT_EQ(PANSFE::Mat<int>(b), a);
+}
+
+TEST(SparseMatTest, SparseMatOperatorTest1) {
+    PANSFE::Mat<int> a = {{1, 0, 2}, {0, 0, 3}, {4, 5, 0}, {0, 6, 0}};
+    PANSFE::Vec<int> x = {1, 2, 3};
+    PANSFE::SparseMat<int> b(a);
+    ASSERT_EQ(b * x, a * x);
+    ASSERT_EQ(PANSFE::Mat<int>(b.Transpose()), a.Transpose());
+}
+
+TEST(SparseMatTest, SparseMatMultiplyTest1) {
+    PANSFE::Mat<int> a = {{1, 0, 2}, {0, 0, 3}, {4, 5, 0}, {0, 6, 0}};
+    PANSFE::Mat<int> b = {{0, 1}, {2, 0}, {0, -3}};
+    PANSFE::SparseMat<int> c = PANSFE::SparseMat<int>(a) *
+                               PANSFE::SparseMat<int>(b);
+    ASSERT_EQ(c.RowPtr(), std::vector<int>({0, 1, 2, 4, 5}));
+    ASSERT_EQ(c.ColInd(), std::vector<int>({1, 1, 0, 1, 0}));
+    ASSERT_EQ(PANSFE::Mat<int>(c), a * b);
+}
+
+TEST(SparseMatTest, BlockSparseMatAssembleTest1) {
+    std::vector<std::vector<int> > elements = {{0, 1}, {1, 2}};
+    PANSFE::BlockSparseMat<double, 2> a(3, elements);
+    ASSERT_EQ(a.NonZeroBlocks(), 7);
+    PANSFE::Mat<double> element = {
+        {2, 0, -1, 0}, {0, 2, 0, -1}, {-1, 0, 2, 0}, {0, -1, 0, 2}};
+    for (auto &nodes : elements) {
+        a.Assemble(nodes, element);
+    }
+    PANSFE::Mat<double> dense =
+        PANSFE::Mat<double>(PANSFE::SparseMat<double>(a));
+    ASSERT_EQ(dense(2, 2), 4);
+    ASSERT_EQ(dense(1, 3), -1);
+    ASSERT_EQ(dense(0, 3), 0);
+    ASSERT_EQ(dense(1, 5), 0);
+    ASSERT_EQ(dense(5, 3), -1);
+    a.AddBlock(0, 0, PANSFE::FixedMat<double, 2, 2>::Identity());
+    ASSERT_EQ(a.Block(0, 0)[0], 3);
+    ASSERT_EQ(a.Block(0, 2), nullptr);
+}
+
+TEST(SparseMatTest, BlockSparseMatOperatorTest1) {
+    PANSFE::Mat<double> a(9, 9);
+    PANSFE::Vec<double> x(9);
+    for (int i = 0; i < 9; i++) {
+        for (int j = 0; j < 9; j++) {
+            if (std::abs(i / 3 - j / 3) <= 1 && (i + j) % 4 != 0) {
+                a(i, j) = i - 2 * j;
+            }
+        }
+        x(i) = i + 1;
+    }
+    PANSFE::SparseMat<double> scalar(a);
+    PANSFE::BlockSparseMat<double, 3> block(scalar);
+    ASSERT_EQ(block.NonZeroBlocks(), 7);
+    ASSERT_EQ(block * x, a * x);
+    ASSERT_EQ(PANSFE::Mat<double>(PANSFE::SparseMat<double>(block)), a);
+}
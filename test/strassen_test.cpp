@@ -0,0 +1,87 @@
+#include "../src/strassen.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+TEST(StrassenTest, StrassenExactTest1) {
+    PANSFE::Mat<long long> a(67, 45), b(45, 51);
+    for (int i = 0; i < a.Row(); i++) {
+        for (int j = 0; j < a.Col(); j++) {
+            a(i, j) = (i * 7 + j * 3) % 11 - 5;
+        }
+    }
+    for (int i = 0; i < b.Row(); i++) {
+        for (int j = 0; j < b.Col(); j++) {
+            b(i, j) = (i * 5 + j * 2) % 13 - 6;
+        }
+    }
+    ASSERT_EQ(PANSFE::StrassenMultiply(a, b, 4), a * b);
+}
+
+TEST(StrassenTest, StrassenKernelTest1) {
+    int m = 7, n = 300, k = 150;
+    std::vector<double> a(m * k), b(k * n), c(m * n), d(m * n, 0.0);
+    for (int i = 0; i < m * k; i++) {
+        a[i] = std::sin(1.0 + i);
+    }
+    for (int i = 0; i < k * n; i++) {
+        b[i] = std::cos(2.0 + i);
+    }
+    PANSFE::GemmKernel(m, n, k, a.data(), k, b.data(), n, c.data(), n);
+    for (int i = 0; i < m; i++) {
+        for (int p = 0; p < k; p++) {
+            for (int j = 0; j < n; j++) {
+                d[n * i + j] += a[k * i + p] * b[n * p + j];
+            }
+        }
+    }
+    ASSERT_EQ(c, d);
+}
+
+TEST(StrassenTest, StrassenOperatorTest1) {
+    PANSFE::Mat<int> a(33, 33), b(33, 33);
+    for (int i = 0; i < 33; i++) {
+        for (int j = 0; j < 33; j++) {
+            a(i, j) = i - j;
+            b(i, j) = i * j % 7;
+        }
+    }
+    PANSFE::Mat<int> c = a * b;
+    PANSFE::SetStrassenCutoff(8);
+    PANSFE::Mat<int> d = a * b;
+    PANSFE::SetStrassenCutoff(0);
+    ASSERT_EQ(c, d);
+}
+
+TEST(StrassenTest, StrassenAccuracyTest1) {
+    int n = 256;
+    PANSFE::Mat<double> a(n, n), b(n, n);
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n; j++) {
+            a(i, j) = std::sin(1.0 + i * n + j);
+            b(i, j) = std::cos(2.0 + i * n + j);
+        }
+    }
+    PANSFE::Mat<double> c = a * b;
+    double maxerror = 0, maxvalue = 0;
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n; j++) {
+            maxvalue = std::max(maxvalue, std::abs(c(i, j)));
+        }
+    }
+    for (int cutoff : {128, 32, 8}) {
+        PANSFE::Mat<double> d = PANSFE::StrassenMultiply(a, b, cutoff);
+        double error = 0;
+        for (int i = 0; i < n; i++) {
+            for (int j = 0; j < n; j++) {
+                error = std::max(error, std::abs(c(i, j) - d(i, j)));
+            }
+        }
+        ASSERT_LT(error / maxvalue, 1e-12) << "cutoff " << cutoff;
+        ASSERT_GE(error, maxerror);
+        maxerror = error;
+    }
+}
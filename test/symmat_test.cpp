@@ -0,0 +1,84 @@
+#include "../src/symmat.h"
+
+#include <gtest/gtest.h>
+
+#include "../src/cholesky.h"
+
+TEST(SymMatTest, SymMatConstructorTest1) {
+    PANSFE::Mat<int> a = {{1, 2, 4}, {2, 3, 5}, {4, 5, 6}};
+    PANSFE::SymMat<int> b(a);
+    ASSERT_EQ(b.Size(), 3);
+    ASSERT_EQ(b(0, 2), 4);
+    ASSERT_EQ(b(2, 0), 4);
+    ASSERT_EQ(*(b.Values() + 4), 5);
+    ASSERT_EQ(PANSFE::Mat<int>(b), a);
+}
+
+TEST(SymMatTest, SymMatOperatorTest1) {
+    int n = 600;
+    PANSFE::Mat<double> a(n, n);
+    PANSFE::Vec<double> x(n);
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j <= i; j++) {
+            a(i, j) = a(j, i) = (i * 7 + j * 3) % 11 - 5;
+        }
+        x(i) = i % 3 - 1;
+    }
+    PANSFE::SetNumThreads(1);
+    ASSERT_EQ(PANSFE::SymMat<double>(a) * x, a * x);
+    PANSFE::SetNumThreads(3);
+    ASSERT_EQ(PANSFE::SymMat<double>(a) * x, a * x);
+    PANSFE::SetNumThreads(0);
+}
+
+TEST(SymMatTest, SymMatRankUpdateTest1) {
+    PANSFE::Mat<int> a = {{1, 2}, {3, 4}, {5, 6}};
+    PANSFE::SymMat<int> c(3, 1);
+    c.RankUpdate(2, a, 3);
+    ASSERT_EQ(PANSFE::Mat<int>(c), a * a.Transpose() * 2 +
+                                       PANSFE::Mat<int>(3, 3, 3));
+}
+
+TEST(SymMatTest, SymMatCholeskyTest1) {
+    PANSFE::Mat<double> a = {{4, 12, -16}, {12, 37, -43}, {-16, -43, 98}};
+    PANSFE::Cholesky<double> cholesky(a);
+    ASSERT_TRUE(cholesky.IsPositiveDefinite());
+    PANSFE::Mat<double> l = cholesky.Factor();
+    ASSERT_EQ(l(2, 0), -8);
+    ASSERT_EQ(l(2, 1), 5);
+    ASSERT_EQ(l(2, 2), 3);
+    ASSERT_EQ(l(0, 2), 0);
+    ASSERT_EQ(l * l.Transpose(), a);
+    ASSERT_NEAR(cholesky.Determinant(), 36, 1e-10);
+    PANSFE::Vec<double> x = {1, -2, 3}, y = cholesky.Solve(a * x);
+    for (int i = 0; i < 3; i++) {
+        ASSERT_NEAR(x[i], y[i], 1e-12);
+    }
+}
+
+TEST(SymMatTest, SymMatCholeskyTest2) {
+    PANSFE::Mat<double> a = {{1, 2}, {2, 1}};
+    ASSERT_FALSE(PANSFE::Cholesky<double>(a).IsPositiveDefinite());
+}
+
+TEST(SymMatTest, SymMatCholeskyUpdateTest1) {
+    PANSFE::Mat<double> a = {{4, 2, 0.4}, {2, 5, 1}, {0.4, 1, 3}};
+    PANSFE::Mat<double> x = {{1, 0}, {0.5, -1}, {-2, 0.25}};
+    PANSFE::Vec<double> b = {1, -1, 2};
+    PANSFE::Cholesky<double> cholesky(a);
+    cholesky.Update(x);
+    PANSFE::Vec<double> y = cholesky.Solve(b),
+                        z = PANSFE::Cholesky<double>(a + x * x.Transpose())
+                                .Solve(b);
+    for (int i = 0; i < 3; i++) {
+        ASSERT_NEAR(y[i], z[i], 1e-12);
+    }
+    ASSERT_TRUE(cholesky.Downdate(x));
+    y = cholesky.Solve(b);
+    z = PANSFE::Cholesky<double>(a).Solve(b);
+    for (int i = 0; i < 3; i++) {
+        ASSERT_NEAR(y[i], z[i], 1e-12);
+    }
+    ASSERT_FALSE(cholesky.Downdate(PANSFE::Vec<double>({3, 0, 0})));
+    ASSERT_FALSE(cholesky.IsPositiveDefinite());
+}
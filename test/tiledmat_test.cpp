@@ -0,0 +1,139 @@
+#include "../src/tiledmat.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+std::string TemporaryPath(const std::string &_name) {
+    const ::testing::TestInfo *info =
+        ::testing::UnitTest::GetInstance()->current_test_info();
+    return ::testing::TempDir() + info->test_suite_name() + "_" +
+           info->name() + "_" + _name + ".bin";
+}
+}  // namespace
+
+TEST(TiledMatTest, TiledMatAccessTest1) {
+    std::string path = TemporaryPath("a");
+    {
+        PANSFE::TiledMat<double> a(path, 10, 7, 4, 8);
+        ASSERT_EQ(a.TileRows(), 3);
+        ASSERT_EQ(a.TileCols(), 2);
+        for (int i = 0; i < 10; i++) {
+            for (int j = 0; j < 7; j++) {
+                a.Set(i, j, 10 * i + j);
+            }
+        }
+        ASSERT_EQ(a(9, 6), 96);
+    }
+    {
+        PANSFE::TiledMat<double> a(path, 10, 7, 4, 8, false);
+        PANSFE::Mat<double> b = a;
+        for (int i = 0; i < 10; i++) {
+            for (int j = 0; j < 7; j++) {
+                ASSERT_EQ(b(i, j), 10 * i + j);
+            }
+        }
+        ASSERT_EQ(a.Loads(), 6);
+    }
+    std::remove(path.c_str());
+}
+
+TEST(TiledMatTest, TiledMatProductTest1) {
+    std::string patha = TemporaryPath("a"), pathb = TemporaryPath("b"),
+                pathc = TemporaryPath("c");
+    int m = 23, k = 17, n = 11;
+    PANSFE::Mat<double> a(m, k), b(k, n);
+    PANSFE::Vec<double> x(k);
+    {
+        PANSFE::TiledMat<double> ta(patha, m, k, 5, 8), tb(pathb, k, n, 5, 8),
+            tc(pathc, m, n, 5, 8);
+        for (int i = 0; i < m; i++) {
+            for (int j = 0; j < k; j++) {
+                a(i, j) = (i * 7 + j * 3) % 11 - 5;
+                ta.Set(i, j, a(i, j));
+            }
+        }
+        for (int i = 0; i < k; i++) {
+            x[i] = i % 4 - 1.5;
+            for (int j = 0; j < n; j++) {
+                b(i, j) = (i * 5 + j * 2) % 9 - 4;
+                tb.Set(i, j, b(i, j));
+            }
+        }
+        ASSERT_EQ(ta * x, a * x);
+        PANSFE::TiledMat<double>::Multiply(ta, tb, tc);
+        ASSERT_EQ(PANSFE::Mat<double>(tc), a * b);
+    }
+    std::remove(patha.c_str());
+    std::remove(pathb.c_str());
+    std::remove(pathc.c_str());
+}
+
+TEST(TiledMatTest, TiledMatCholeskyTest1) {
+    std::string path = TemporaryPath("a");
+    int n = 30;
+    PANSFE::Mat<double> a(n, n);
+    PANSFE::Vec<double> b(n);
+    {
+        PANSFE::TiledMat<double> ta(path, n, n, 8, 8);
+        for (int i = 0; i < n; i++) {
+            b[i] = i % 3 - 1.0;
+            for (int j = 0; j < n; j++) {
+                a(i, j) = i == j ? 2.0 * n : 1.0 / (1 + i + j);
+                ta.Set(i, j, a(i, j));
+            }
+        }
+        ASSERT_TRUE(ta.FactorizeCholesky());
+        PANSFE::Vec<double> x = b;
+        ta.CholeskySolveInPlace(x);
+        PANSFE::Vec<double> r = a * x - b;
+        ASSERT_NEAR(r.Norm(), 0.0, 1e-12);
+        for (int i = 0; i < n; i++) {
+            for (int j = i + 1; j < n; j++) {
+                ASSERT_EQ(ta(i, j), a(i, j));
+            }
+        }
+    }
+    std::remove(path.c_str());
+}
+
+TEST(TiledMatTest, TiledMatErrorTest1) {
+    std::string path = TemporaryPath("a");
+    ASSERT_THROW(PANSFE::TiledMat<double>(path, 4, 4, 2, 8, false),
+                 std::runtime_error);
+    {
+        PANSFE::TiledMat<double> a(path, 4, 4, 2, 8);
+        a.Set(3, 3, 1.0);
+    }
+    {
+        PANSFE::TiledMat<double> a(path, 8, 8, 2, 8, false);
+        ASSERT_EQ(a(0, 0), 0.0);
+        ASSERT_THROW(a(7, 7), std::runtime_error);
+    }
+    std::remove(path.c_str());
+}
+
+TEST(TiledMatTest, TiledMatErrorTest2) {
+    std::string path = TemporaryPath("a");
+    {
+        PANSFE::TiledMat<double> a(path, 4, 4, 2, 8);
+        a.Set(3, 3, 1.0);
+    }
+    {
+        PANSFE::TiledMat<double> a(path, 8, 8, 2, 8, false);
+        ASSERT_THROW(a(7, 7), std::runtime_error);
+        {
+            std::ofstream file(path, std::ios::app | std::ios::binary);
+            std::vector<char> zeros(12 * 4 * sizeof(double), 0);
+            file.write(zeros.data(), zeros.size());
+        }
+        ASSERT_EQ(a(7, 7), 0.0);
+        ASSERT_EQ(a(1, 1), 0.0);
+    }
+    std::remove(path.c_str());
+}
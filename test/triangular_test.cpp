@@ -0,0 +1,85 @@
+#include "../src/triangular.h"
+
+#include <gtest/gtest.h>
+
+TEST(TriangularTest, TriangularAccessorTest1) {
+    PANSFE::Mat<int> a = {{1, 2, 3}, {4, 5, 6}, {7, 8, 9}},
+                     b = {{1, 0, 0}, {4, 1, 0}, {7, 8, 1}},
+                     c = {{1, 2, 3}, {0, 5, 6}, {0, 0, 9}};
+    PANSFE::TriangularView<int> lower(a, PANSFE::Uplo::Lower,
+                                      PANSFE::Diag::Unit),
+        upper(a, PANSFE::Uplo::Upper);
+    ASSERT_EQ(PANSFE::Mat<int>(lower), b);
+    ASSERT_EQ(PANSFE::Mat<int>(upper), c);
+    PANSFE::Vec<int> x = {1, 2, 3};
+    ASSERT_EQ(lower * x, b * x);
+    ASSERT_EQ(upper * x, c * x);
+}
+
+TEST(TriangularTest, TriangularSolveTest1) {
+    int n = 300;
+    PANSFE::Mat<double> a(n, n);
+    PANSFE::Vec<double> x(n);
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n; j++) {
+            a(i, j) = i == j ? 2.0 : std::sin(1.0 + i * n + j) / n;
+        }
+        x(i) = std::cos(0.1 * i);
+    }
+    for (PANSFE::Uplo uplo : {PANSFE::Uplo::Lower, PANSFE::Uplo::Upper}) {
+        for (PANSFE::Diag diag : {PANSFE::Diag::NonUnit, PANSFE::Diag::Unit}) {
+            PANSFE::TriangularView<double> t(a, uplo, diag);
+            PANSFE::Vec<double> y = t.Solve(t * x);
+            for (int i = 0; i < n; i++) {
+                ASSERT_NEAR(y[i], x[i], 1e-12);
+            }
+        }
+    }
+}
+
+TEST(TriangularTest, TriangularSolveTest2) {
+    int n = 100, m = 70;
+    PANSFE::Mat<double> a(n, n), x(n, m);
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n; j++) {
+            a(i, j) = i == j ? 3.0 : std::sin(2.0 + i * n + j) / n;
+        }
+        for (int j = 0; j < m; j++) {
+            x(i, j) = std::cos(0.3 * i + j);
+        }
+    }
+    for (PANSFE::Uplo uplo : {PANSFE::Uplo::Lower, PANSFE::Uplo::Upper}) {
+        PANSFE::TriangularView<double> t(a, uplo);
+        PANSFE::Mat<double> y = t.Solve(PANSFE::Mat<double>(t) * x);
+        for (int i = 0; i < n; i++) {
+            for (int j = 0; j < m; j++) {
+                ASSERT_NEAR(y(i, j), x(i, j), 1e-12);
+            }
+        }
+    }
+}
+
+TEST(TriangularTest, TriangularSolveTest3) {
+    int n = 64, m = 256;
+    PANSFE::Mat<double> a(n, n), x(n, m);
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n; j++) {
+            a(i, j) = i == j ? 3.0 : std::sin(2.0 + i * n + j) / n;
+        }
+        for (int j = 0; j < m; j++) {
+            x(i, j) = std::cos(0.3 * i + j);
+        }
+    }
+    PANSFE::TriangularView<double> t(a, PANSFE::Uplo::Lower);
+    PANSFE::Mat<double> b = PANSFE::Mat<double>(t) * x;
+    b.SetCopyOnWrite(true);
+    const PANSFE::Mat<double> original = b;
+    PANSFE::Mat<double> y = t.Solve(b);
+    ASSERT_TRUE(b.IsShared());
+    ASSERT_EQ(b, original);
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < m; j++) {
+            ASSERT_NEAR(y(i, j), x(i, j), 1e-12);
+        }
+    }
+}
@@ -0,0 +1,51 @@
+#include "../src/tripletbuilder.h"
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+TEST(TripletBuilderTest, TripletBuilderBuildTest1) {
+    PANSFE::TripletBuilder<int> a(4, 3);
+    a.Add(2, 1, 5);
+    a.Add(0, 2, 2);
+    a.Add(2, 0, 4);
+    a.Add(0, 0, 1);
+    a.Add(1, 2, 1);
+    a.Add(1, 2, 2);
+    a.Add(2, 1, -5);
+    ASSERT_EQ(a.Size(), 7);
+    PANSFE::SparseMat<int> b = a.Build();
+    ASSERT_EQ(a.Size(), 0);
+    ASSERT_EQ(b.Row(), 4);
+    ASSERT_EQ(b.Col(), 3);
+    ASSERT_EQ(b.RowPtr(), std::vector<int>({0, 2, 3, 5, 5}));
+    ASSERT_EQ(b.ColInd(), std::vector<int>({0, 2, 2, 0, 1}));
+    PANSFE::Mat<int> c = {{1, 0, 2}, {0, 0, 3}, {4, 0, 0}, {0, 0, 0}};
+    ASSERT_EQ(PANSFE::Mat<int>(b), c);
+    ASSERT_EQ(a.Build().NonZeros(), 0);
+}
+
+TEST(TripletBuilderTest, TripletBuilderParallelTest1) {
+    int n = 200, m = 150, count = 20000;
+    PANSFE::Mat<long long> c(n, m);
+    for (int e = 0; e < count; e++) {
+        c[(e * 7919) % n][(e * 104729) % m] += e % 13 - 6;
+    }
+    for (int numthreads : {1, 4}) {
+        PANSFE::SetNumThreads(numthreads);
+        PANSFE::TripletBuilder<long long> a(n, m);
+        PANSFE::ParallelFor(0, count, [&](int _e) {
+            a.Add((_e * 7919) % n, (_e * 104729) % m, _e % 13 - 6);
+        });
+        ASSERT_EQ(a.Size(), count);
+        PANSFE::SparseMat<long long> b = a.Build();
+        ASSERT_EQ(PANSFE::Mat<long long>(b), c);
+        const std::vector<int> &rowptr = b.RowPtr(), &colind = b.ColInd();
+        for (int i = 0; i < n; i++) {
+            for (int k = rowptr[i] + 1; k < rowptr[i + 1]; k++) {
+                ASSERT_LT(colind[k - 1], colind[k]);
+            }
+        }
+    }
+    PANSFE::SetNumThreads(0);
+}
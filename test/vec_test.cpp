@@ -171,3 +171,61 @@ TEST(VectorTest, VectorOStreamTest1) {
     ss << a << b;
     ASSERT_EQ(ss.str(), "1\n2\n3\n4\n");
 }
+
+TEST(VectorTest, VectorResizeTest1) {
+    PANSFE::Vec<int> a(2, PANSFE::Uninitialized());
+    ASSERT_EQ(a.Size(), 2);
+    a[0] = 1;
+    a[1] = 2;
+    a.Reserve(8);
+    const int *values = a.Values();
+    a.Resize(4, 7);
+    ASSERT_EQ(a, PANSFE::Vec<int>({1, 2, 7, 7}));
+    a.Resize(1);
+    a.Resize(3);
+    ASSERT_EQ(a, PANSFE::Vec<int>({1, 0, 0}));
+    a = PANSFE::Vec<int>({5, 6, 7, 8, 9});
+    ASSERT_EQ(a.Values(), values);
+    ASSERT_EQ(a.Capacity(), 8);
+}
+
+TEST(VectorTest, VectorInlineTest1) {
+    PANSFE::Vec<double> a = {1, 2, 3}, b = a, c(2 * PANSFE_VEC_INLINE_CAPACITY);
+    ASSERT_EQ(a.Capacity(), PANSFE_VEC_INLINE_CAPACITY);
+    ASSERT_NE(a.Values(), b.Values());
+    b[0] = 4;
+    ASSERT_EQ(a[0], 1);
+    ASSERT_EQ(b.Cross(a), PANSFE::Vec<double>({0, -9, 6}));
+    ASSERT_EQ(PANSFE::Mat<double>(a)(2, 0), 3);
+    b.Resize(PANSFE_VEC_INLINE_CAPACITY + 1, 5);
+    ASSERT_EQ(b[2], 3);
+    ASSERT_EQ(b[PANSFE_VEC_INLINE_CAPACITY], 5);
+    c = a;
+    ASSERT_EQ(c, a);
+    ASSERT_EQ(c.Capacity(), 2 * PANSFE_VEC_INLINE_CAPACITY);
+}
+
+TEST(VectorTest, VectorCopyOnWriteTest1) {
+    PANSFE::Vec<double> a(100, 1.0);
+    a.SetCopyOnWrite(true);
+    PANSFE::Vec<double> b = a, c;
+    c = a;
+    const PANSFE::Vec<double> &d = b, &e = c;
+    ASSERT_TRUE(a.IsShared());
+    ASSERT_EQ(d.Values(), e.Values());
+    ASSERT_EQ(b.Sum(), 100.0);
+    ASSERT_EQ(b[0], 1.0);
+    ASSERT_TRUE(b.IsShared());
+    b.BeginWrite();
+    b[0] = 2.0;
+    ASSERT_FALSE(b.IsShared());
+    ASSERT_EQ(a[0], 1.0);
+    ASSERT_EQ(c[0], 1.0);
+    c *= 3.0;
+    ASSERT_FALSE(a.IsShared());
+    ASSERT_EQ(a.Sum(), 100.0);
+    ASSERT_EQ(c.Sum(), 300.0);
+
+    PANSFE::Vec<double> f = {1, 2}, g = f;
+    ASSERT_NE(f.Values(), g.Values());
+}
@@ -0,0 +1,40 @@
+#include "../src/woodbury.h"
+
+#include <gtest/gtest.h>
+
+#include <type_traits>
+
+#include "../src/cholesky.h"
+
+TEST(WoodburyTest, WoodburySolveTest1) {
+    PANSFE::Mat<double> a = {
+        {2, 1, 1, 0}, {4, -6, 0, 1}, {-2, 7, 2, 3}, {1, 0, 5, 4}};
+    PANSFE::Mat<double> u = {{1, 0}, {-1, 2}, {0.5, 0}, {2, 1}},
+                        v = {{0, 1}, {3, 0}, {1, -1}, {-2, 0.5}};
+    PANSFE::Vec<double> b = {1, 2, 3, 4};
+    PANSFE::LU<double> lu(a);
+    PANSFE::Woodbury<double> woodbury(lu, u, v);
+    ASSERT_FALSE(woodbury.IsSingular());
+    PANSFE::Vec<double> x = woodbury.Solve(b),
+                        y = PANSFE::LU<double>(a + u * v.Transpose()).Solve(b);
+    for (int i = 0; i < 4; i++) {
+        ASSERT_NEAR(x[i], y[i], 1e-10);
+    }
+}
+
+TEST(WoodburyTest, WoodburySolveTest2) {
+    PANSFE::Mat<double> a = {{4, 2, 0.4}, {2, 5, 1}, {0.4, 1, 3}};
+    PANSFE::Mat<double> u = {{1}, {0}, {-1}}, v = {{-1}, {0}, {1}};
+    PANSFE::Cholesky<double> cholesky(a);
+    PANSFE::Woodbury<double> woodbury(cholesky, u, v);
+    PANSFE::Vec<double> b = {1, -1, 2};
+    PANSFE::Vec<double> r = (a + u * v.Transpose()) * woodbury.Solve(b) - b;
+    ASSERT_NEAR(r.Norm(), 0.0, 1e-12);
+    typedef const PANSFE::Mat<double> &Matrix;
+    ASSERT_TRUE((std::is_constructible<PANSFE::Woodbury<double>,
+                                       const PANSFE::Cholesky<double> &,
+                                       Matrix, Matrix>::value));
+    ASSERT_FALSE((std::is_constructible<PANSFE::Woodbury<double>,
+                                        PANSFE::Cholesky<double>, Matrix,
+                                        Matrix>::value));
+}